@@ -22,6 +22,25 @@
 #define UINT64_TOP_2_DIGITS (uint64_t)18
 #define UINT64_BOTTOM_18_DIGITS (uint64_t)446744073709551615L
 
+// decNumber's declet tables, and the word order it was built with (see
+// decNumberLocal.h). a decQuad whose coefficient fits in 64 bits only uses
+// the low 7 of its 11 declets, which are converted directly here instead of
+// going through 34 BCD digits
+extern const uint16_t DPD2BIN[1024];
+extern const uint32_t DPD2BINK[1024];
+extern const uint32_t DPD2BINM[1024];
+extern const uint16_t BIN2DPD[1000];
+extern const uint32_t DECCOMBMSD[64];
+
+#ifndef DECLITEND
+#define DECLITEND 1
+#endif
+#if DECLITEND
+#define DECQUAD_WORD(dq, off) ((dq)->words[3 - (off)])
+#else
+#define DECQUAD_WORD(dq, off) ((dq)->words[off])
+#endif
+
 // is this really faster than 4 if's?
 static int dec_quad_helper_shift_table_for_nibbles[] = {
      0 // 0000
@@ -122,6 +141,69 @@ void ion_quad_get_packed_and_exponent_from_quad(const decQuad *quad_value, uint8
 	decQuadToPacked(quad_value, p_exp, p_packed);
 }
 
+// Sets dq to (+/-) magnitude * 10^exp exactly. Any uint64_t fits in the
+// coefficient, so no context (or rounding) is needed; exp must be in
+// [DECQUAD_EXP_MIN, DECQUAD_EXP_MAX].
+void decQuadFromUInt64(decQuad *dq, uint64_t magnitude, int32_t exp, BOOL is_negative)
+{
+  uint32_t declets[7];
+  uint32_t biased_exp;
+  int      ii;
+
+  assert(exp >= DECQUAD_EXP_MIN && exp <= DECQUAD_EXP_MAX);
+
+  // at most 20 digits, so the most significant digit (kept in the
+  // combination field) is always 0
+  for (ii = 0; ii < 7; ii++) {
+    declets[ii] = BIN2DPD[magnitude % 1000];
+    magnitude /= 1000;
+  }
+  biased_exp = (uint32_t)(exp + DECQUAD_Bias);
+  DECQUAD_WORD(dq, 3) = declets[0] | (declets[1] << 10) | (declets[2] << 20) | (declets[3] << 30);
+  DECQUAD_WORD(dq, 2) = (declets[3] >> 2) | (declets[4] << 8) | (declets[5] << 18) | (declets[6] << 28);
+  DECQUAD_WORD(dq, 1) = declets[6] >> 4;
+  DECQUAD_WORD(dq, 0) = (is_negative ? DECFLOAT_Sign : 0)
+                      | ((biased_exp >> DECQUAD_EconL) << 29)
+                      | ((biased_exp & ((1 << DECQUAD_EconL) - 1)) << (32 - 6 - DECQUAD_EconL));
+}
+
+// Gets the coefficient and exponent of a finite dq as an int64_t and int32_t.
+// Returns FALSE, without setting them, if the coefficient doesn't fit or dq is
+// negative zero (which a zero mantissa can't represent).
+BOOL decQuadToInt64Parts(const decQuad *dq, int64_t *p_mantissa, int32_t *p_exp)
+{
+  uint32_t hi = DECQUAD_WORD(dq, 0), mh = DECQUAD_WORD(dq, 1), ml = DECQUAD_WORD(dq, 2), lo = DECQUAD_WORD(dq, 3);
+  uint64_t magnitude, limit, top;
+  BOOL     sign;
+
+  assert(decQuadIsFinite(dq));
+
+  // anything in the most significant digit or the top 4 declets is more than 21 digits
+  if (DECCOMBMSD[hi >> 26] || (hi & 0x3FFF) || (mh >> 6)) {
+    return FALSE;
+  }
+  // 9 digits from each of the low two groups of 3 declets, and the 7th declet on top
+  top = DPD2BIN[((mh << 4) | (ml >> 28)) & 0x3FF];
+  if (top > 9) {
+    return FALSE; // 20 digits or more never fit in an int64_t
+  }
+  magnitude = top * (uint64_t)BILLION * (uint64_t)BILLION
+            + (uint64_t)(DPD2BIN[((ml << 2) | (lo >> 30)) & 0x3FF] + DPD2BINK[(ml >> 8) & 0x3FF] + DPD2BINM[(ml >> 18) & 0x3FF])
+              * (uint64_t)BILLION
+            + (DPD2BIN[lo & 0x3FF] + DPD2BINK[(lo >> 10) & 0x3FF] + DPD2BINM[(lo >> 20) & 0x3FF]);
+  sign = decQuadIsSigned(dq);
+  limit = sign ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+  if (magnitude > limit) {
+    return FALSE;
+  }
+  if (sign && magnitude == 0) {
+    return FALSE;
+  }
+  *p_mantissa = sign ? -(int64_t)(magnitude - 1) - 1 : (int64_t)magnitude;
+  *p_exp = decQuadGetExponent(dq);
+  return TRUE;
+}
+
 uint64_t decQuadToUInt64(const decQuad *df, decContext *set, BOOL *p_overflow, BOOL *p_is_negative)
 {
   enum rounding saveround;             // saver
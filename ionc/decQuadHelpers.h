@@ -24,6 +24,10 @@ extern "C" {
 
 #define BILLION      (int64_t)1000000000            /* 10**9                 */
 
+// the range of exponents a decQuad can hold exactly with any coefficient
+#define DECQUAD_EXP_MIN (DECQUAD_Emin - (DECQUAD_Pmax - 1))
+#define DECQUAD_EXP_MAX (DECQUAD_Emax - (DECQUAD_Pmax - 1))
+
 //
 // these are actually in decQuadHelpers.c
 // they really should be part of the decimal package, but
@@ -40,6 +44,8 @@ ION_API_EXPORT iERR    ion_quad_get_quad_from_digits_and_exponent(uint64_t value
 ION_API_EXPORT void    ion_quad_get_packed_and_exponent_from_quad(const decQuad *quad_value, uint8_t *p_packed, int32_t *p_exp);
 
 uint64_t decQuadToUInt64(const decQuad *df, decContext *set, BOOL *p_overflow, BOOL *p_is_negative);
+void     decQuadFromUInt64(decQuad *dq, uint64_t magnitude, int32_t exp, BOOL is_negative);
+BOOL     decQuadToInt64Parts(const decQuad *dq, int64_t *p_mantissa, int32_t *p_exp);
 double   decQuadToDouble(const decQuad *dec, decContext *set);
 
 #ifdef __cplusplus
@@ -365,6 +365,111 @@ ION_API_EXPORT iERR ion_extractor_path_create_from_ion(hEXTRACTOR extractor, ION
  */
 ION_API_EXPORT iERR ion_extractor_match(hEXTRACTOR extractor, hREADER reader);
 
+/**
+ * Identifies where a batch match was found. Provided to ION_EXTRACTOR_BATCH_CALLBACK.
+ */
+typedef struct _ion_extractor_shard {
+    /**
+     * The worker on which the match occurred, in [0, number of workers). Callbacks may use this to index per-worker
+     * state without locking.
+     */
+    int worker_id;
+
+    /**
+     * The index of the input (within the array given to `ion_extractor_match_batch`) in which the match occurred.
+     */
+    SIZE input_index;
+
+} ION_EXTRACTOR_SHARD;
+
+/**
+ * Callback function to be invoked when the extractor matches a path during `ion_extractor_match_batch`. This has the
+ * same contract as ION_EXTRACTOR_CALLBACK, with the addition of `shard`, which identifies the worker and input on
+ * whose behalf it is invoked. It may be invoked concurrently from multiple workers.
+ *
+ * @param reader - The worker's reader, positioned on the matching value.
+ * @param matched_path - The path that was matched.
+ * @param user_context - The user_context provided for matched_path during path registration.
+ * @param shard - The worker and input on which the match occurred. Only valid for the duration of the call.
+ * @param p_control - A control instruction to be conveyed back to the extractor (output parameter).
+ */
+typedef iERR (*ION_EXTRACTOR_BATCH_CALLBACK)(hREADER reader, hPATH matched_path, void *user_context,
+                                             ION_EXTRACTOR_SHARD *shard, ION_EXTRACTOR_CONTROL *p_control);
+
+/**
+ * One independent unit of Ion data to be matched by `ion_extractor_match_batch`. Exactly one of `buffer` or `file`
+ * must be non-null.
+ */
+typedef struct _ion_extractor_batch_input {
+    /**
+     * Text or binary Ion data. The caller retains ownership, and must keep it unmodified until the batch completes.
+     */
+    BYTE *buffer;
+
+    /**
+     * The length, in bytes, of `buffer`.
+     */
+    SIZE buffer_length;
+
+    /**
+     * An open file containing text or binary Ion data, read from its current position. The caller retains ownership.
+     */
+    FILE *file;
+
+} ION_EXTRACTOR_BATCH_INPUT;
+
+/**
+ * Batch configuration to be supplied by the user when calling `ion_extractor_match_batch`.
+ */
+typedef struct _ion_extractor_batch_options {
+    /**
+     * The number of workers to match on. Each worker is a separate thread with its own reader. If less than 1, the
+     * number of online processors is used. The calling thread is used as one of the workers.
+     */
+    int num_workers;
+
+    /**
+     * Options for the readers opened by each worker. May be null, in which case the reader defaults are used.
+     */
+    ION_READER_OPTIONS *reader_options;
+
+    /**
+     * If non-null, this is invoked on every match instead of the path's ION_EXTRACTOR_CALLBACK, with the path's
+     * user context. If null, the path's own callback is invoked; in that case it must tolerate concurrent calls.
+     */
+    ION_EXTRACTOR_BATCH_CALLBACK callback;
+
+    /**
+     * If `true`, no further inputs are started once any input fails. Inputs already in progress run to completion.
+     *
+     * Defaults to `false`.
+     */
+    bool stop_on_error;
+
+} ION_EXTRACTOR_BATCH_OPTIONS;
+
+/**
+ * Extracts matches within each of the given independent inputs, using the extractor's registered paths, on a pool of
+ * workers. Each input is read from its start by a reader owned by the worker that processes it, so each input must
+ * be a complete Ion stream (e.g., starting with its own symbol table, if it has one). Inputs are distributed to
+ * workers dynamically; no ordering is guaranteed between inputs.
+ *
+ * Matching never modifies the extractor, so the compiled paths are shared by all workers. No path may be in progress,
+ * and the extractor must not be modified (e.g., by registering new paths) until this call returns.
+ *
+ * @param extractor - The extractor to match.
+ * @param inputs - The inputs to match.
+ * @param input_count - The number of elements in `inputs`.
+ * @param options - Batch configuration options. May be null. If null, defaults will be used.
+ * @param p_results - May be null. If non-null, must have space for `input_count` elements; receives the result of
+ *  matching each input. Inputs skipped due to `stop_on_error` receive IERR_INVALID_STATE.
+ * @return the error of the first failed input (by index) or a non-zero error code if the batch could not be run,
+ *  otherwise IERR_OK.
+ */
+ION_API_EXPORT iERR ion_extractor_match_batch(hEXTRACTOR extractor, ION_EXTRACTOR_BATCH_INPUT *inputs,
+                                              SIZE input_count, ION_EXTRACTOR_BATCH_OPTIONS *options,
+                                              iERR *p_results);
+
 /**
  * Deallocates the given extractor.
  * @param extractor - The extractor to deallocate.
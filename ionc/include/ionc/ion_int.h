@@ -71,6 +71,8 @@ typedef uint64_t II_LONG_DIGIT;
 #define II_DIGIT_COUNT_FROM_BITS(bits) (((bits) == 0) ? 1 : (((((int)bits) - 1) / II_BITS_PER_II_DIGIT) + 1))
 
 #define II_STRING_BASE              10
+#define II_STRING_CHUNK_BASE        1000000000 /* the largest power of 10 below II_BASE */
+#define II_STRING_CHUNK_DIGITS      9
 #define II_BITS_PER_DEC_DIGIT       3.35 /* upper bound beyond 1 gig */
 #define II_DEC_DIGIT_PER_BITS       3.32191780821918 /* lower bound */
 #define II_II_DIGITS_PER_DEC_DIGIT  0.108064516 /* or: (3.35/31) */
@@ -195,6 +197,7 @@ void      _ion_int_init(ION_INT *iint, void *owner);
 iERR      _ion_int_zero(ION_INT *iint);
 void *    _ion_int_realloc_helper(void *value, SIZE old_len, void *owner, SIZE new_len);
 iERR      _ion_int_extend_digits(ION_INT *iint, SIZE digits_needed, BOOL zero_fill);
+iERR      _ion_int_from_uint64(ION_INT *iint, uint64_t magnitude, BOOL is_negative);
 II_DIGIT *_ion_int_buffer_temp_copy( II_DIGIT *orig_digits, SIZE len, II_DIGIT *cache_buffer, SIZE cache_len);
 II_DIGIT *_ion_int_buffer_temp_copy( II_DIGIT *orig_digits, SIZE len, II_DIGIT *cache_buffer, SIZE cache_len);
 void      _ion_int_free_temp(II_DIGIT *temp_buffer, II_DIGIT *cache_buffer);
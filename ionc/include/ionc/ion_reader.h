@@ -355,6 +355,21 @@ ION_API_EXPORT iERR ion_reader_get_value_position  (hREADER   hreader
  */
 ION_API_EXPORT iERR ion_reader_get_value_length    (hREADER  hreader
                                                    ,SIZE   *p_length);
+/** returns the encoded bytes of the value the reader is currently
+ *  positioned on, without decoding them. For an annotated value the
+ *  bytes start at the annotation wrapper; a field name is never
+ *  included. Symbol IDs inside the bytes refer to the reader's current
+ *  symbol table. The bytes are not copied: *p_start points into the
+ *  reader's input and is only valid until the reader is moved. Only
+ *  binary readers support this, and only when the whole value is in
+ *  the stream's current buffer (always the case for readers opened
+ *  over a buffer); otherwise IERR_INVALID_STATE is returned and
+ *  ion_reader_get_value_offset and ion_reader_get_value_length can be
+ *  used instead.
+ */
+ION_API_EXPORT iERR ion_reader_get_value_bytes     (hREADER  hreader
+                                                   ,BYTE   **p_start
+                                                   ,SIZE    *p_length);
 /** returns the current symbol table the value the reader is currently
  *  positioned on.  This can be used to reset the readers symbol
  *  table is you wish to seek in a stream which contains multiple
@@ -368,6 +383,110 @@ ION_API_EXPORT iERR ion_reader_get_symbol_table    (hREADER   hreader
  * @param   p_value_type    ION_TYPE (tid_EOF, tid_BOOL, etc, defined in ion_const.h). tid_EOF if EOF.
  */
 ION_API_EXPORT iERR ion_reader_next                (hREADER hreader, ION_TYPE *p_value_type);
+
+/**
+ * Moves forward, within the struct the reader is in, to the next field with the
+ * given name (or symbol id) and makes it the current value, as ion_reader_next
+ * would. If no later field matches, the reader is left at the end of the struct
+ * and *p_value_type is tid_EOF. The search never goes back to fields before the
+ * current one.
+ *
+ * Binary readers skip the other fields on their length prefixes without
+ * decoding their names, annotations or values. A name is matched through the
+ * symbol id the current symbol table gives it, so a field whose symbol id is a
+ * duplicate of that text elsewhere in the table is not found; look it up by
+ * that symbol id instead. Text readers compare each field name in turn.
+ */
+ION_API_EXPORT iERR ion_reader_find_field          (hREADER hreader, ION_STRING *field_name, ION_TYPE *p_value_type);
+ION_API_EXPORT iERR ion_reader_find_field_sid      (hREADER hreader, SID field_sid, ION_TYPE *p_value_type);
+
+/**
+ * Builds a directory of the fields of the binary struct the reader has just
+ * stepped into (it must be called before the first ion_reader_next in the
+ * struct), after which ion_reader_seek_field and ion_reader_seek_field_sid
+ * position the reader on any field, in any order and as often as needed,
+ * with a table lookup and a seek within the struct. The fields are scanned
+ * once on their length prefixes. The directory lasts until the reader steps
+ * out of the struct, and until then the struct's stream pages stay pinned
+ * (see ion_stream_pin) so the seeks never go back to the input.
+ *
+ * Seeking to a field makes it the current value, as ion_reader_next would;
+ * ion_reader_next then carries on with the fields that follow it. A name
+ * or symbol id repeated in the struct finds its first field, and one that
+ * is not in the struct leaves the reader at its end with tid_EOF. Names are
+ * matched through their symbol id, as in ion_reader_find_field.
+ *
+ * Text readers don't support directories and return IERR_INVALID_STATE.
+ */
+ION_API_EXPORT iERR ion_reader_index_struct        (hREADER hreader);
+ION_API_EXPORT iERR ion_reader_seek_field          (hREADER hreader, ION_STRING *field_name, ION_TYPE *p_value_type);
+ION_API_EXPORT iERR ion_reader_seek_field_sid      (hREADER hreader, SID field_sid, ION_TYPE *p_value_type);
+
+/**
+ * The mapping of the fields of a struct onto a C struct, created by `ion_reader_create_layout` and used by
+ * `ion_reader_read_struct_into`.
+ */
+typedef struct _ion_reader_layout *hLAYOUT;
+
+/**
+ * One field of a layout: where the value of the field named `name` is stored in the destination, and as what.
+ */
+typedef struct _ion_reader_layout_field {
+    ION_STRING  name;
+
+    /**
+     * The type of the field's value, which decides the C type found at `offset`:
+     *  tid_BOOL - BOOL
+     *  tid_INT - int64_t
+     *  tid_FLOAT - double
+     *  tid_TIMESTAMP - ION_TIMESTAMP
+     *  tid_STRING or tid_SYMBOL - ION_STRING holding the text of a string or a symbol
+     *  tid_CLOB or tid_BLOB - ION_STRING holding the bytes of either lob
+     *  tid_STRUCT - the C struct of the nested `layout`
+     * The memory of strings and lobs belongs to the reader and is good until it moves to the next top level value.
+     */
+    ION_TYPE    type;
+
+    /**
+     * The byte offset of the field's member in the destination, usually from offsetof.
+     */
+    SIZE        offset;
+
+    /**
+     * For tid_STRUCT, the layout of the nested struct, created for the same reader. Ignored otherwise.
+     */
+    hLAYOUT     layout;
+
+} ION_READER_LAYOUT_FIELD;
+
+/**
+ * Creates a layout for structs with the given fields, in no particular order. The layout keeps its own copy of the
+ * field names and belongs to the reader, so it stays valid until the reader is closed, and can be used for any
+ * number of structs.
+ *
+ * @return IERR_INVALID_ARG if a field has an unsupported type, if a name appears twice, or if a tid_STRUCT field has
+ *  no layout or one belonging to another reader.
+ */
+ION_API_EXPORT iERR ion_reader_create_layout       (hREADER hreader, ION_READER_LAYOUT_FIELD *fields, SIZE field_count,
+                                                    hLAYOUT *p_layout);
+
+/**
+ * Reads the struct the reader is positioned on (ion_reader_next has just returned tid_STRUCT) into `dst`, storing
+ * the value of each field the layout names as the layout says, and leaves the reader after the struct, as
+ * `ion_reader_step_out` would. Fields the layout doesn't name are skipped; fields that are missing or null leave
+ * their destination untouched; when a field repeats, the last value is kept. A null struct stores nothing.
+ *
+ * A binary reader decodes the struct in a single loop: the layout keeps a table from the field names' symbol IDs
+ * (every ID the symbol table gives a name, should it give more than one) to the fields, which is only rebuilt, by
+ * going through the symbols of the table, once the reader has moved on to a new symbol table, and the values are decoded
+ * straight into `dst` without going through the per value calls of this API. Text readers match the fields on
+ * their names.
+ *
+ * @return IERR_INVALID_STATE if the current value isn't a struct, or a field's value doesn't have the layout's type.
+ *  A failure inside the struct still leaves the reader after it, with the fields read before the failure stored.
+ */
+ION_API_EXPORT iERR ion_reader_read_struct_into    (hREADER hreader, hLAYOUT layout, void *dst);
+
 ION_API_EXPORT iERR ion_reader_step_in             (hREADER hreader);
 ION_API_EXPORT iERR ion_reader_step_out            (hREADER hreader);
 ION_API_EXPORT iERR ion_reader_get_depth           (hREADER hreader, SIZE *p_depth);
@@ -420,17 +539,53 @@ ION_API_EXPORT iERR ion_reader_read_ion_int        (hREADER hreader, ION_INT *p_
 ION_API_EXPORT iERR ion_reader_read_long           (hREADER hreader, long *p_value);
 ION_API_EXPORT iERR ion_reader_read_double         (hREADER hreader, double *p_value);
 
+/**
+ * Read the values that follow in the current container into a C array, as `ion_reader_next` followed by
+ * `ion_reader_read_int64` or `ion_reader_read_double` for each of them would, until max_count values have been read
+ * or the end of the container is reached. Usually called after stepping into a list, repeatedly if the array is
+ * shorter than the list. A binary reader decodes the values straight from its buffer where it can.
+ *
+ * @param p_count - the number of values read, less than max_count only at the end of the container.
+ * @return the error of the value that can't be read (a value of another type or a null, for example), in which case
+ *  the reader is positioned on that value, and p_count is the number of values read before it.
+ */
+ION_API_EXPORT iERR ion_reader_read_int64_array    (hREADER hreader, int64_t *p_values, SIZE max_count, SIZE *p_count);
+ION_API_EXPORT iERR ion_reader_read_double_array   (hREADER hreader, double *p_values, SIZE max_count, SIZE *p_count);
+
 /**
  * @deprecated use of decQuads directly is deprecated. ION_DECIMAL should be used. See `ion_reader_read_ion_decimal`.
  */
 ION_API_EXPORT iERR ion_reader_read_decimal        (hREADER hreader, decQuad *p_value);
 ION_API_EXPORT iERR ion_reader_read_ion_decimal    (hREADER hreader, ION_DECIMAL *p_value);
 
+/**
+ * Reads the current decimal value as mantissa * 10^exponent, without building a decQuad when the reader
+ * can avoid it (the text reader accumulates small coefficients while scanning, the binary reader decodes them
+ * straight from its buffer).
+ * If the coefficient does not fit in an int64_t, or the value is negative zero, *p_fits is set to FALSE and
+ * the mantissa and exponent are not set; `ion_reader_read_ion_decimal` can read those values.
+ * @return IERR_NULL_VALUE if the current value is null.decimal.
+ */
+ION_API_EXPORT iERR ion_reader_read_decimal_parts  (hREADER hreader, int64_t *p_mantissa, int32_t *p_exponent, BOOL *p_fits);
+
 /**
  * @return IERR_NULL_VALUE if the current value is null.timestamp.
  */
 ION_API_EXPORT iERR ion_reader_read_timestamp      (hREADER hreader, iTIMESTAMP p_value);
 
+/**
+ * Reads the current timestamp value as nanoseconds since 1970-01-01T00:00Z, without going through an ION_TIMESTAMP
+ * where the reader can avoid it (a binary reader decodes fractions of up to 8 bytes as integers). Fractions finer than a
+ * nanosecond are truncated.
+ *
+ * @param p_precision - ION_TS_YEAR through ION_TS_FRAC, as `ion_timestamp_get_precision` would return.
+ * @param p_offset_minutes - the local offset, or ION_TIMESTAMP_UNKNOWN_OFFSET if it is unknown.
+ * @return IERR_NULL_VALUE if the current value is null.timestamp, IERR_NUMERIC_OVERFLOW if the instant is outside the
+ *  years 1677 to 2262 that an int64_t of nanoseconds covers.
+ */
+ION_API_EXPORT iERR ion_reader_read_timestamp_epoch_nanos(hREADER hreader, int64_t *p_epoch_nanos, int *p_precision,
+                                                          int *p_offset_minutes);
+
 /** Read the current symbol value as an ION_SYMBOL.
  */
 ION_API_EXPORT iERR ion_reader_read_ion_symbol(hREADER hreader, ION_SYMBOL *p_symbol);
@@ -455,6 +610,27 @@ ION_API_EXPORT iERR ion_reader_get_lob_size          (hREADER hreader, SIZE *p_l
 ION_API_EXPORT iERR ion_reader_read_lob_bytes        (hREADER hreader, BYTE *p_buf, SIZE buf_max, SIZE *p_length);
 ION_API_EXPORT iERR ion_reader_read_lob_partial_bytes(hREADER hreader, BYTE *p_buf, SIZE buf_max, SIZE *p_length);
 
+/**
+ * Reads the current string, clob or blob value without copying it. The
+ * contents are returned as *p_slice_count byte runs in p_slices, in order,
+ * that point directly into the reader's input: a single run for a reader
+ * over a buffer, one run per stream page the value touches for a paged
+ * stream. String contents are validated as utf-8 unless the reader skips
+ * character validation.
+ *
+ * The pages stay pinned in memory, even after the reader moves on, until
+ * the matching ion_reader_unpin_value_view call. Views nest; each pin must
+ * be unpinned (before the reader is closed) and the pages are released
+ * when the last one is.
+ *
+ * If max_slices is too small, *p_slice_count is set to the number of runs
+ * needed and IERR_BUFFER_TOO_SMALL is returned without reading the value.
+ * Only binary readers support views; text values have to be unescaped and
+ * fail with IERR_INVALID_STATE.
+ */
+ION_API_EXPORT iERR ion_reader_pin_value_view        (hREADER hreader, ION_STRING *p_slices, SIZE max_slices, SIZE *p_slice_count);
+ION_API_EXPORT iERR ion_reader_unpin_value_view      (hREADER hreader);
+
 /**
  * Gets the current position and if hreader is a text reader, also gets
  * the line and column numbers.
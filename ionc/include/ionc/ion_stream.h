@@ -235,6 +235,15 @@ ION_API_EXPORT iERR ion_stream_write               (ION_STREAM *stream, BYTE *bu
 ION_API_EXPORT iERR ion_stream_write_byte          (ION_STREAM *stream, int byte);
 ION_API_EXPORT iERR ion_stream_write_byte_no_checks(ION_STREAM *stream, int byte);
 ION_API_EXPORT iERR ion_stream_write_stream        (ION_STREAM *stream, ION_STREAM *stream_input, SIZE len, SIZE *p_written);
+
+// ion_stream_reserve returns a pointer to len contiguous writable bytes at the current
+// position in *p_dst, or NULL when the current page can't hold them (the caller then
+// writes with ion_stream_write). The caller fills in what it needs of the span and
+// calls ion_stream_commit with the number of bytes actually written, which must not
+// exceed len. No other stream operation may come between the two calls.
+ION_API_EXPORT iERR ion_stream_reserve             (ION_STREAM *stream, SIZE len, BYTE **p_dst);
+ION_API_EXPORT iERR ion_stream_commit              (ION_STREAM *stream, SIZE len);
+
 ION_API_EXPORT iERR ion_stream_seek                (ION_STREAM *stream, POSITION position);
 ION_API_EXPORT iERR ion_stream_truncate            (ION_STREAM *stream);
 ION_API_EXPORT iERR ion_stream_skip                (ION_STREAM *stream, SIZE distance, SIZE *p_skipped);
@@ -243,6 +252,13 @@ ION_API_EXPORT iERR ion_stream_mark_remark         (ION_STREAM *stream, POSITION
 ION_API_EXPORT iERR ion_stream_mark_rewind         (ION_STREAM *stream);
 ION_API_EXPORT iERR ion_stream_mark_clear          (ION_STREAM *stream);
 
+// ion_stream_pin keeps the page holding position, which must not be past the current
+// position and must still be in memory, and every page after it from being released
+// until the matching ion_stream_unpin, so pointers into those pages stay valid while
+// the stream moves on. Pins nest; the pages are released when the last one is removed.
+ION_API_EXPORT iERR ion_stream_pin                 (ION_STREAM *stream, POSITION position);
+ION_API_EXPORT iERR ion_stream_unpin               (ION_STREAM *stream);
+
 #ifdef __cplusplus
 }
 #endif
@@ -79,6 +79,11 @@ struct _ion_timestamp {
 
 #define ION_MAX_TIMESTAMP_STRING (26+DECQUAD_String) /* y-m-dTh:m:s.<dec>+h:m */ // TODO there is another definition of a similar constant in ion_debug.h that is shorter. Investigate.
 
+/** The offset the epoch based reader and writer calls use for a local offset that is unknown ("-00:00"),
+ *  which includes every timestamp with less than minute precision.
+ */
+#define ION_TIMESTAMP_UNKNOWN_OFFSET (-32768)
+
 /** Get the time precision for the given timestamp object.
  * The precision values are defined as ION_TS_YEAR, ION_TS_MONTH, ION_TS_DAY,
  * ION_TS_MIN, ION_TS_SEC and ION_TS_FRAC
@@ -120,6 +120,21 @@ typedef struct _ion_writer_options
      */
     BOOL json_downconvert;
 
+    /** When the output stream can seek (a file, a file descriptor or memory), write each top level container
+     *  straight to the output and go back to fill in its length when it's finished, instead of holding the whole
+     *  value in memory until then. Memory use is then bounded by the container depth rather than the size of the
+     *  value. Binary only, ignored for text and for streams which can't seek.
+     */
+    BOOL patch_lengths_in_output;
+
+    /** With patch_lengths_in_output, the number of bytes set aside in front of each top level container for the
+     *  symbols the container adds to the local symbol table. Defaults to 4096. If the symbol table appended for
+     *  them doesn't fit, finishing the container fails with IERR_BUFFER_TOO_SMALL. Unused space is left as nop
+     *  padding. Opening a binary writer with patch_lengths_in_output fails with IERR_INVALID_ARG when this is
+     *  negative.
+     */
+    SIZE symbol_table_reserve;
+
 } ION_WRITER_OPTIONS;
 
 
@@ -240,6 +255,78 @@ ION_API_EXPORT iERR ion_writer_write_annotations    (hWRITER hwriter, iSTRING p_
 ION_API_EXPORT iERR ion_writer_write_annotation_symbols(hWRITER hwriter, ION_SYMBOL *annotations, SIZE count);
 ION_API_EXPORT iERR ion_writer_clear_annotations    (hWRITER hwriter);
 
+/**
+ * A symbol interned with a writer by `ion_writer_intern_symbol`, for field names, annotations and symbol values that
+ * are written over and over.
+ */
+typedef struct _ion_writer_symbol_ref *hSYMBOLREF;
+
+/**
+ * Interns `text` with the writer and returns a reference to it. The writer keeps its own copy of the text, and the
+ * reference stays valid until the writer is closed, across flushes, finishes and symbol table changes. Writing by
+ * reference skips the symbol table lookup: a binary writer caches the reference's symbol ID and only looks it up
+ * again once the writer has moved on to a new symbol table. Text writers simply write the text.
+ */
+ION_API_EXPORT iERR ion_writer_intern_symbol        (hWRITER hwriter, iSTRING text, hSYMBOLREF *p_ref);
+
+/**
+ * Like `ion_writer_write_field_name`, `ion_writer_add_annotation` and `ion_writer_write_symbol`, with the text of a
+ * reference from `ion_writer_intern_symbol` for the same writer.
+ */
+ION_API_EXPORT iERR ion_writer_write_field_name_ref (hWRITER hwriter, hSYMBOLREF ref);
+ION_API_EXPORT iERR ion_writer_add_annotation_ref   (hWRITER hwriter, hSYMBOLREF ref);
+ION_API_EXPORT iERR ion_writer_write_symbol_ref     (hWRITER hwriter, hSYMBOLREF ref);
+
+/**
+ * The shape of a struct written over and over, created by `ion_writer_create_template`: an ordered list of field
+ * names, each with the type of its value.
+ */
+typedef struct _ion_writer_template *hTEMPLATE;
+
+/**
+ * The value of one field of a row written by `ion_writer_write_template_row`. Which member is used depends on the
+ * type the template gives the field.
+ */
+typedef struct _ion_writer_template_value {
+    /**
+     * If TRUE, a null of the field's type is written and the value is ignored.
+     */
+    BOOL is_null;
+
+    union {
+        BOOL            bool_value;         // tid_BOOL
+        int64_t         int_value;          // tid_INT
+        double          float_value;        // tid_FLOAT
+        ION_STRING      string_value;       // tid_STRING and tid_SYMBOL text, tid_CLOB and tid_BLOB bytes
+        ION_DECIMAL    *decimal_value;      // tid_DECIMAL
+        ION_TIMESTAMP  *timestamp_value;    // tid_TIMESTAMP
+    } value;
+
+} ION_WRITER_TEMPLATE_VALUE;
+
+/**
+ * Creates a template for structs with the given fields, in order. The field names are interned with the writer (see
+ * `ion_writer_intern_symbol`) and the template belongs to the writer, so it stays valid until the writer is closed.
+ * A binary writer keeps the encoded symbol IDs of the field names, and the first byte of each field's type
+ * descriptor, with the template, and only encodes them again once the writer has moved on to a new symbol table.
+ *
+ * @param field_types - One of tid_BOOL, tid_INT, tid_FLOAT, tid_DECIMAL, tid_TIMESTAMP, tid_SYMBOL, tid_STRING,
+ *  tid_CLOB or tid_BLOB per field.
+ * @return IERR_INVALID_ARG if a field has any other type.
+ */
+ION_API_EXPORT iERR ion_writer_create_template      (hWRITER hwriter, ION_STRING *field_names, ION_TYPE *field_types,
+                                                     SIZE field_count, hTEMPLATE *p_template);
+
+/**
+ * Writes a struct with the fields of the template, with the values given in the same order. Pending annotations and
+ * field name apply to the struct, as they would to `ion_writer_start_container`. A binary writer writes the fields
+ * straight from the template, without looking up the field names or the per-value bookkeeping of the single value
+ * calls; decimals and timestamps are written as usual. Text writers write the struct field by field.
+ *
+ * @param values - One value per field of the template.
+ */
+ION_API_EXPORT iERR ion_writer_write_template_row   (hWRITER hwriter, hTEMPLATE tmpl, ION_WRITER_TEMPLATE_VALUE *values);
+
 ION_API_EXPORT iERR ion_writer_write_null           (hWRITER hwriter);
 ION_API_EXPORT iERR ion_writer_write_typed_null     (hWRITER hwriter, ION_TYPE type);
 ION_API_EXPORT iERR ion_writer_write_bool           (hWRITER hwriter, BOOL value);
@@ -256,13 +343,41 @@ ION_API_EXPORT iERR ion_writer_write_float          (hWRITER hwriter, float valu
  */
 ION_API_EXPORT iERR ion_writer_write_decimal        (hWRITER hwriter, decQuad *value);
 ION_API_EXPORT iERR ion_writer_write_ion_decimal    (hWRITER hwriter, ION_DECIMAL *value);
+
+/**
+ * Write the decimal mantissa * 10^exponent, the counterpart of `ion_reader_read_decimal_parts`. Neither writer builds
+ * a decQuad: a binary writer encodes the mantissa directly and a text writer formats its digits in place.
+ */
+ION_API_EXPORT iERR ion_writer_write_decimal_parts  (hWRITER hwriter, int64_t mantissa, int32_t exponent);
 ION_API_EXPORT iERR ion_writer_write_timestamp      (hWRITER hwriter, iTIMESTAMP value);
+
+/**
+ * Write a timestamp given as nanoseconds since 1970-01-01T00:00Z. A binary writer encodes the UTC fields and an integer
+ * fraction directly, without the local time and decQuad fraction of an ION_TIMESTAMP.
+ *
+ * @param precision - ION_TS_YEAR through ION_TS_FRAC; the instant is truncated to it. ION_TS_FRAC writes the fewest
+ *  of 3, 6 or 9 fraction digits that hold the nanoseconds.
+ * @param offset_minutes - the local offset, or ION_TIMESTAMP_UNKNOWN_OFFSET. Ignored below minute precision.
+ * @return IERR_INVALID_ARG if the precision is not one of the ION_TS_ values or the offset is a day or more.
+ */
+ION_API_EXPORT iERR ion_writer_write_timestamp_epoch_nanos(hWRITER hwriter, int64_t epoch_nanos, int precision,
+                                                           int offset_minutes);
 ION_API_EXPORT iERR ion_writer_write_symbol         (hWRITER hwriter, iSTRING p_value);
 ION_API_EXPORT iERR ion_writer_write_ion_symbol     (hWRITER hwriter, ION_SYMBOL *symbol);
 ION_API_EXPORT iERR ion_writer_write_string         (hWRITER hwriter, iSTRING p_value);
 ION_API_EXPORT iERR ion_writer_write_clob           (hWRITER hwriter, BYTE *p_buf, SIZE length);
 ION_API_EXPORT iERR ion_writer_write_blob           (hWRITER hwriter, BYTE *p_buf, SIZE length);
 
+/**
+ * Write a list of `count` values from a C array, the same list that start_container, one write per value and
+ * finish_container would write. A binary writer computes the length of the list up front and encodes the values
+ * in one pass, without the per value bookkeeping of the single value calls. A null `value` in the string array is
+ * written as null.string.
+ */
+ION_API_EXPORT iERR ion_writer_write_int64_list     (hWRITER hwriter, int64_t *values, SIZE count);
+ION_API_EXPORT iERR ion_writer_write_double_list    (hWRITER hwriter, double *values, SIZE count);
+ION_API_EXPORT iERR ion_writer_write_string_list    (hWRITER hwriter, ION_STRING *values, SIZE count);
+
 ION_API_EXPORT iERR ion_writer_start_lob            (hWRITER hwriter, ION_TYPE lob_type);
 ION_API_EXPORT iERR ion_writer_append_lob           (hWRITER hwriter, BYTE *p_buf, SIZE length);
 ION_API_EXPORT iERR ion_writer_finish_lob           (hWRITER hwriter);
@@ -272,6 +387,57 @@ ION_API_EXPORT iERR ion_writer_finish_container     (hWRITER hwriter);
 ION_API_EXPORT iERR ion_writer_write_one_value      (hWRITER hwriter, hREADER hreader);
 ION_API_EXPORT iERR ion_writer_write_all_values     (hWRITER hwriter, hREADER hreader);
 
+/**
+ * Writes the value(s) with the given index of a batch given to `ion_writer_write_batch`. The writer is one the batch
+ * opened for the calling worker, it is at the top level and must be left there. It must not be closed or finished.
+ * The callback may be invoked concurrently from multiple workers, each with its own writer.
+ *
+ * @param writer - The worker's writer.
+ * @param user_context - The user_context given to `ion_writer_write_batch`.
+ * @param value_index - The index of the value to write, in [0, value_count).
+ */
+typedef iERR (*ION_WRITER_BATCH_CALLBACK)(hWRITER writer, void *user_context, SIZE value_index);
+
+/**
+ * Batch configuration to be supplied by the user when calling `ion_writer_write_batch`.
+ */
+typedef struct _ion_writer_batch_options {
+    /**
+     * The number of workers to serialize on. Each worker is a separate thread with its own writers. If less than 1,
+     * the number of online processors is used. The calling thread is used as one of the workers.
+     */
+    int num_workers;
+
+    /**
+     * The number of consecutive values serialized together into one segment. Each segment is a complete binary Ion
+     * stream with its own version marker and local symbol table, so larger segments repeat fewer symbols while
+     * smaller ones balance the work better. If less than 1, the values are split into about eight segments per
+     * worker.
+     */
+    SIZE values_per_segment;
+
+} ION_WRITER_BATCH_OPTIONS;
+
+/**
+ * Writes value_count top level values, produced by calling `callback` once for each index, on a pool of workers.
+ * The values are serialized concurrently into in-memory segments, which are then written to the writer's output
+ * in index order once all of them are done, so the output is the same whatever the number of workers.
+ *
+ * The writer must be at the top level. It is finished first (see `ion_writer_finish`), as each segment starts a new
+ * symbol table context, and values written after the batch start another one. Batches are only serialized in
+ * parallel by binary writers; a text writer simply invokes the callback for each index, in order, with itself.
+ *
+ * @param hwriter - The writer whose output receives the values.
+ * @param callback - Writes the value(s) for an index.
+ * @param user_context - Passed through to `callback`.
+ * @param value_count - The number of indices to invoke the callback with.
+ * @param options - Batch configuration options. May be null. If null, defaults will be used.
+ * @return the error of the first failed segment (by index), in which case nothing from the batch is written to the
+ *  output, otherwise IERR_OK.
+ */
+ION_API_EXPORT iERR ion_writer_write_batch(hWRITER hwriter, ION_WRITER_BATCH_CALLBACK callback, void *user_context,
+                                           SIZE value_count, ION_WRITER_BATCH_OPTIONS *options);
+
 /**
  * Flushes pending bytes without forcing an Ion Version Marker or ending the current symbol table context.
  * If writer was created using open_stream, also flushes write buffer to stream. If any value is in-progress, flushing
@@ -246,8 +246,21 @@ iERR _ion_binary_read_ion_int_helper(ION_STREAM *pstream, int32_t len, BOOL is_n
     int       b;
     int       bits, digit_count;
     II_DIGIT *digits;
+    uint64_t  magnitude;
 
     ASSERT(len > 0);
+    if (len <= (int32_t)sizeof(uint64_t)) {
+        // small enough to be kept without a digit array
+        if (first_byte < 0) FAILWITH(IERR_UNEXPECTED_EOF);
+        magnitude = (BYTE)first_byte;
+        while (--len) {
+            ION_GET(pstream, b);
+            if (b < 0) FAILWITH(IERR_UNEXPECTED_EOF);
+            magnitude = (magnitude << II_BITS_PER_BYTE) | (BYTE)b;
+        }
+        IONCHECK(_ion_int_from_uint64(p_value, magnitude, is_negative));
+        SUCCEED();
+    }
     bits = len * II_BITS_PER_BYTE;
     digit_count = II_DIGIT_COUNT_FROM_BITS(bits);
     IONCHECK(_ion_int_extend_digits(p_value, digit_count, TRUE));
@@ -508,6 +521,79 @@ iERR ion_binary_read_decimal(ION_STREAM *pstream, int32_t len, decContext *conte
     iRETURN;
 }
 
+iERR _ion_binary_decode_decimal_parts(BYTE *p, SIZE len, int64_t *p_mantissa, int32_t *p_exponent, BOOL *p_fits,
+                                      BOOL *p_decoded)
+{
+    iENTER;
+    BYTE     *end = p + len;
+    int       b;
+    int32_t   exponent = 0;
+    uint64_t  magnitude = 0;
+    BOOL      is_negative;
+
+    ASSERT(p && p_mantissa && p_exponent && p_fits && p_decoded);
+
+    *p_decoded = TRUE;
+    *p_fits = TRUE;
+    *p_mantissa = 0;
+    *p_exponent = 0;
+    if (len == 0) {
+        SUCCEED();
+    }
+
+    // the exponent, a var_int. anything unusual (truncated, too wide) is
+    // left for ion_binary_read_decimal to report
+    b = *p++;
+    is_negative = (b & 0x40);
+    exponent = b & 0x3F;
+    while ((b & 0x80) == 0) {
+        if (p >= end || exponent > (INT32_MAX >> 7)) {
+            *p_decoded = FALSE;
+            SUCCEED();
+        }
+        b = *p++;
+        exponent = (exponent << 7) + (b & 0x7F);
+    }
+    *p_exponent = is_negative ? -exponent : exponent;
+
+    // the coefficient, a signed int. a ninth byte is only allowed when it
+    // holds nothing but the sign
+    if (p == end) {
+        SUCCEED();
+    }
+    if (end - p > (SIZE)sizeof(uint64_t) + 1 || (end - p > (SIZE)sizeof(uint64_t) && (*p & 0x7F))) {
+        *p_decoded = FALSE;
+        SUCCEED();
+    }
+    is_negative = (*p & 0x80);
+    magnitude = *p++ & 0x7F;
+    while (p < end) {
+        magnitude = (magnitude << 8) | *p++;
+    }
+
+    if (is_negative) {
+        // negative zero has no int64_t mantissa
+        if (magnitude == 0 || magnitude > (uint64_t)INT64_MAX + 1) {
+            *p_fits = FALSE;
+        }
+        else {
+            *p_mantissa = (int64_t)(0 - magnitude);
+        }
+    }
+    else if (magnitude > (uint64_t)INT64_MAX) {
+        *p_fits = FALSE;
+    }
+    else {
+        *p_mantissa = (int64_t)magnitude;
+    }
+    if (!*p_fits) {
+        *p_mantissa = 0;
+        *p_exponent = 0;
+    }
+
+    iRETURN;
+}
+
 iERR ion_binary_read_timestamp(ION_STREAM *pstream, int32_t len, decContext *context, ION_TIMESTAMP *p_value)
 {
     iERR err = ion_timestamp_binary_read((ION_STREAM *)pstream, len, context, p_value);
@@ -678,7 +764,17 @@ iERR ion_binary_write_type_desc_with_length( ION_STREAM *pstream, int type, int3
 iERR ion_binary_write_byte_array(ION_STREAM *pstream, BYTE image[], int startIndex, int endIndex)
 {
     iENTER;
-    int ii;
+    BYTE *dst;
+    int   ii;
+
+    // copy the whole image into the output page if it fits, otherwise
+    // let the bytes straddle the page boundary one at a time
+    IONCHECK(ion_stream_reserve(pstream, endIndex - startIndex, &dst));
+    if (dst != NULL) {
+        memcpy(dst, &image[startIndex], endIndex - startIndex);
+        IONCHECK(ion_stream_commit(pstream, endIndex - startIndex));
+        SUCCEED();
+    }
 
     for (ii = startIndex; ii < endIndex; ii++) {
         ION_PUT( pstream, image[ii] );
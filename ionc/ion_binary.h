@@ -149,6 +149,16 @@ ION_API_EXPORT iERR ion_binary_write_var_uint_64(ION_STREAM *pstream, uint64_t v
  *
  */
 ION_API_EXPORT iERR ion_binary_write_var_int_64(ION_STREAM *pstream, int64_t value);
+
+/**
+ * Decodes the len bytes of a binary decimal's representation at p into an
+ * int64_t mantissa and an exponent, without a decQuad. *p_fits is FALSE for
+ * negative zero and mantissas outside the int64_t range. *p_decoded is FALSE,
+ * with nothing decoded, for representations better left to
+ * ion_binary_read_decimal (too wide, or malformed).
+ */
+iERR _ion_binary_decode_decimal_parts(BYTE *p, SIZE len, int64_t *p_mantissa, int32_t *p_exponent, BOOL *p_fits,
+                                      BOOL *p_decoded);
     
 
 #ifdef __cplusplus
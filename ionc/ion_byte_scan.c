@@ -0,0 +1,143 @@
+/*
+ * Copyright 2012-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at:
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ */
+
+#include "ion_internal.h"
+#include "ion_byte_scan.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define ION_BYTE_SCAN_SSE2
+    #include <emmintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #endif
+#endif
+
+#define ION_BYTE_SCAN_BLOCK 16
+
+const ION_BYTE_SET _ion_byte_set_string_plain = {
+    4, { '"', '\\', '\r', '\n' }, 0, 0,
+    { ['"'] = 1, ['\\'] = 1, ['\r'] = 1, ['\n'] = 1 }
+};
+
+const ION_BYTE_SET _ion_byte_set_string_quoted = {
+    4, { '\'', '\\', '\r', '\n' }, 0, 0,
+    { ['\''] = 1, ['\\'] = 1, ['\r'] = 1, ['\n'] = 1 }
+};
+
+const ION_BYTE_SET _ion_byte_set_string_special = {
+    3, { '"', '\'', '\\' }, 0x20, 0,
+    { ['"'] = 1, ['\''] = 1, ['\\'] = 1 }
+};
+
+// 0xEF is the first byte of the utf-8 byte order mark, which the whitespace
+// reader handles specially, so the slow path has to see it
+const ION_BYTE_SET _ion_byte_set_container = {
+    12, { '"', '\'', '{', '}', '[', ']', '(', ')', '/', '\r', '\n', 0xEF }, 0, 0,
+    { ['"'] = 1, ['\''] = 1, ['{'] = 1, ['}'] = 1, ['['] = 1, [']'] = 1,
+      ['('] = 1, [')'] = 1, ['/'] = 1, ['\r'] = 1, ['\n'] = 1, [0xEF] = 1 }
+};
+
+const ION_BYTE_SET _ion_byte_set_escape_ascii = {
+    3, { '"', '\'', '\\' }, 0x20, 127,
+    { ['"'] = 1, ['\''] = 1, ['\\'] = 1 }
+};
+
+#ifdef ION_BYTE_SCAN_SSE2
+
+static int _ion_byte_scan_first_bit(int mask)
+{
+    ASSERT(mask != 0);
+#ifdef _MSC_VER
+    unsigned long idx;
+    _BitScanForward(&idx, (unsigned long)mask);
+    return (int)idx;
+#else
+    return __builtin_ctz((unsigned int)mask);
+#endif
+}
+
+#endif
+
+const BYTE *_ion_byte_scan_find(const BYTE *p, const BYTE *limit, const ION_BYTE_SET *set)
+{
+    ASSERT(set);
+    ASSERT(p <= limit);
+
+#ifdef ION_BYTE_SCAN_SSE2
+    if (limit - p >= ION_BYTE_SCAN_BLOCK) {
+        __m128i members[ION_BYTE_SET_MAX_MEMBERS];
+        __m128i below = _mm_set1_epi8((char)(set->below - 1));
+        __m128i upper = _mm_set1_epi8((char)set->upper);
+        __m128i block, hits;
+        int     ii, mask;
+
+        for (ii = 0; ii < set->member_count; ii++) {
+            members[ii] = _mm_set1_epi8((char)set->members[ii]);
+        }
+        while (limit - p >= ION_BYTE_SCAN_BLOCK) {
+            block = _mm_loadu_si128((const __m128i *)p);
+            hits = _mm_setzero_si128();
+            for (ii = 0; ii < set->member_count; ii++) {
+                hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, members[ii]));
+            }
+            if (set->below) {
+                // unsigned block <= below - 1
+                hits = _mm_or_si128(hits, _mm_cmpeq_epi8(_mm_min_epu8(block, below), block));
+            }
+            if (set->upper) {
+                // unsigned block >= upper
+                hits = _mm_or_si128(hits, _mm_cmpeq_epi8(_mm_max_epu8(block, upper), block));
+            }
+            mask = _mm_movemask_epi8(hits);
+            if (mask) {
+                return p + _ion_byte_scan_first_bit(mask);
+            }
+            p += ION_BYTE_SCAN_BLOCK;
+        }
+    }
+#endif
+
+    while (p < limit && *p >= set->below && (!set->upper || *p < set->upper) && !set->table[*p]) {
+        p++;
+    }
+    return p;
+}
+
+const BYTE *_ion_byte_scan_skip_blanks(const BYTE *p, const BYTE *limit)
+{
+    ASSERT(p <= limit);
+
+#ifdef ION_BYTE_SCAN_SSE2
+    if (limit - p >= ION_BYTE_SCAN_BLOCK) {
+        __m128i space = _mm_set1_epi8(' ');
+        __m128i tab = _mm_set1_epi8('\t');
+        __m128i block;
+        int     mask;
+
+        while (limit - p >= ION_BYTE_SCAN_BLOCK) {
+            block = _mm_loadu_si128((const __m128i *)p);
+            mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, tab)));
+            if (mask != 0xFFFF) {
+                return p + _ion_byte_scan_first_bit(~mask & 0xFFFF);
+            }
+            p += ION_BYTE_SCAN_BLOCK;
+        }
+    }
+#endif
+
+    while (p < limit && (*p == ' ' || *p == '\t')) {
+        p++;
+    }
+    return p;
+}
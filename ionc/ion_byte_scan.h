@@ -0,0 +1,80 @@
+/*
+ * Copyright 2012-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at:
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ */
+
+//
+// Block scanning helpers for the text scanner and writer. These search the bytes
+// that are already buffered in a stream page for the next "interesting" byte so
+// the per character paths (ION_GET, column and line tracking, escaping) only run
+// on the bytes that actually need them. Blocks of 16 bytes are compared at once
+// when SSE2 is available, otherwise a byte table is used.
+//
+
+#ifndef ION_BYTE_SCAN_H_
+#define ION_BYTE_SCAN_H_
+
+#include <ionc/ion_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ION_BYTE_SET_MAX_MEMBERS 16
+
+/**
+ * A set of byte values to stop at. `members` drives the vector compares and
+ * `table` the scalar compares, so the two must describe the same set. Every
+ * byte less than `below` is also a member (0 for none), as is every byte at or
+ * above `upper` (0 for none).
+ */
+typedef struct _ion_byte_set
+{
+    int         member_count;
+    BYTE        members[ION_BYTE_SET_MAX_MEMBERS];
+    BYTE        below;
+    BYTE        upper;
+    BYTE        table[256];
+} ION_BYTE_SET;
+
+// the double quoted string body: quote, escape and the new line characters
+extern const ION_BYTE_SET _ion_byte_set_string_plain;
+// the single and triple quoted string body: quote, escape and the new line characters
+extern const ION_BYTE_SET _ion_byte_set_string_quoted;
+// the bytes which can't be copied directly into a string value: quotes, escape and all control characters
+extern const ION_BYTE_SET _ion_byte_set_string_special;
+// everything that can change the nesting of a container being skipped, or the line count
+extern const ION_BYTE_SET _ion_byte_set_container;
+// the bytes the text writer may have to escape in utf-8 output: control characters, escape and both quotes.
+// These are the bytes a string value can't copy directly, so the set is shared; the writer only escapes the
+// quote it is using and copies the other one through one byte at a time.
+#define _ion_byte_set_escape_utf8 _ion_byte_set_string_special
+// the bytes the text writer may have to escape in ascii output: as above plus everything from 127 up
+extern const ION_BYTE_SET _ion_byte_set_escape_ascii;
+
+/**
+ * Returns a pointer to the first byte in [p, limit) which is a member of `set`,
+ * or `limit` if there is none.
+ */
+const BYTE *_ion_byte_scan_find(const BYTE *p, const BYTE *limit, const ION_BYTE_SET *set);
+
+/**
+ * Returns a pointer to the first byte in [p, limit) which is neither a space
+ * nor a tab, or `limit` if there is none.
+ */
+const BYTE *_ion_byte_scan_skip_blanks(const BYTE *p, const BYTE *limit);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ION_BYTE_SCAN_H_ */
@@ -185,6 +185,95 @@ void _ion_decimal_to_string_to_ion(char *p_string) {
     }
 }
 
+char *_ion_decimal_digits_to_chars(char *dst, BOOL is_negative, const char *digits, int digit_count, int32_t exponent,
+                                   BOOL as_float) {
+    int64_t adjusted_exponent = (int64_t)exponent + digit_count - 1;
+    uint64_t magnitude;
+    int before_point;
+
+    ASSERT(digit_count > 0);
+
+    if (is_negative) {
+        *dst++ = '-';
+    }
+    // the same layout decQuadToString chooses: plain notation for exponents
+    // from 0 down to an adjusted exponent of -6, scientific otherwise
+    if (exponent <= 0 && adjusted_exponent >= -6) {
+        if (exponent == 0) {
+            memcpy(dst, digits, (size_t)digit_count);
+            dst += digit_count;
+            if (!as_float) {
+                *dst++ = 'd';
+                *dst++ = '0';
+            }
+            return dst;
+        }
+        before_point = digit_count + exponent;
+        if (before_point > 0) {
+            memcpy(dst, digits, (size_t)before_point);
+            dst += before_point;
+            *dst++ = '.';
+            memcpy(dst, digits + before_point, (size_t)(digit_count - before_point));
+            dst += digit_count - before_point;
+        }
+        else {
+            *dst++ = '0';
+            *dst++ = '.';
+            memset(dst, '0', (size_t)-before_point);
+            dst += -before_point;
+            memcpy(dst, digits, (size_t)digit_count);
+            dst += digit_count;
+        }
+        return dst;
+    }
+    *dst++ = digits[0];
+    if (digit_count > 1) {
+        *dst++ = '.';
+        memcpy(dst, digits + 1, (size_t)(digit_count - 1));
+        dst += digit_count - 1;
+    }
+    *dst++ = as_float ? 'E' : 'd';
+    *dst++ = (adjusted_exponent < 0) ? '-' : '+';
+    magnitude = (adjusted_exponent < 0) ? (uint64_t)-adjusted_exponent : (uint64_t)adjusted_exponent;
+    return _ion_uint64_to_chars(magnitude, dst);
+}
+
+char *_ion_decimal_quad_to_chars(const decQuad *value, char *dst, BOOL as_float) {
+    uint8_t bcd[DECQUAD_Pmax];
+    char digits[DECQUAD_Pmax];
+    BOOL is_negative;
+    int first, ii;
+
+    ASSERT(value);
+
+    is_negative = decQuadIsSigned(value);
+    if (decQuadIsInfinite(value)) {
+        memcpy(dst, is_negative ? "-inf" : "+inf", 4);
+        return dst + 4;
+    }
+    if (decQuadIsNaN(value)) {
+        memcpy(dst, "nan", 3);
+        return dst + 3;
+    }
+    decQuadGetCoefficient(value, bcd);
+    for (first = 0; first < DECQUAD_Pmax - 1 && bcd[first] == 0; first++) {
+        // skip the leading zeros, the last digit is kept for zero
+    }
+    for (ii = first; ii < DECQUAD_Pmax; ii++) {
+        digits[ii - first] = (char)('0' + bcd[ii]);
+    }
+    return _ion_decimal_digits_to_chars(dst, is_negative, digits, DECQUAD_Pmax - first, decQuadGetExponent(value),
+                                        as_float);
+}
+
+char *_ion_decimal_int64_parts_to_chars(int64_t mantissa, int32_t exponent, char *dst, BOOL as_float) {
+    char digits[MAX_INT64_LENGTH];
+    uint64_t magnitude = (mantissa < 0) ? (uint64_t)0 - (uint64_t)mantissa : (uint64_t)mantissa;
+    char *end = _ion_uint64_to_chars(magnitude, digits);
+
+    return _ion_decimal_digits_to_chars(dst, mantissa < 0, digits, (int)(end - digits), exponent, as_float);
+}
+
 #define ION_DECIMAL_TO_STRING_HELPER_BUILDER(is_signed, is_infinite, is_nan, is_zero, digits, to_string, as_float) \
     iENTER; \
     ASSERT(value); \
@@ -205,8 +294,9 @@ void _ion_decimal_to_string_to_ion(char *p_string) {
     iRETURN; \
 
 iERR _ion_decimal_to_string_quad_helper(const decQuad *value, char *p_string, BOOL as_float) {
-    ION_DECIMAL_TO_STRING_HELPER_BUILDER(decQuadIsSigned, decQuadIsInfinite, decQuadIsNaN,
-                                         decQuadIsZero, decQuadDigits(value), decQuadToString, as_float);
+    iENTER;
+    *_ion_decimal_quad_to_chars(value, p_string, as_float) = '\0';
+    iRETURN;
 }
 
 iERR _ion_decimal_to_string_number_helper(const decNumber *value, char *p_string) {
@@ -293,6 +383,208 @@ iERR ion_decimal_from_ion_int(ION_DECIMAL *value, decContext *context, ION_INT *
     );
 }
 
+/* Exact arithmetic on small coefficients */
+
+// decQuads whose coefficients fit in an int64_t are added, subtracted and
+// multiplied as integers, which is exact as long as the result has no more
+// than DECQUAD_Pmax digits. anything else (specials, negative zero, wide
+// coefficients, results that would round or leave the exponent range) goes
+// to decQuad/decNumber as before.
+#ifdef __SIZEOF_INT128__
+#define ION_DECIMAL_SMALL_ARITHMETIC
+
+typedef __int128          ION_DECIMAL_SMALL;
+typedef unsigned __int128 ION_DECIMAL_SMALL_MAGNITUDE;
+
+#define ION_DECIMAL_SMALL_MAX_DIGITS    36
+
+static const uint64_t g_ion_decimal_powers_of_ten[] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+    10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+    1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull
+};
+
+#define ION_DECIMAL_POWERS_OF_TEN_COUNT (sizeof(g_ion_decimal_powers_of_ten) / sizeof(g_ion_decimal_powers_of_ten[0]))
+
+// 10^digits, for digits up to ION_DECIMAL_SMALL_MAX_DIGITS
+static ION_DECIMAL_SMALL_MAGNITUDE _ion_decimal_small_power_of_ten(int digits) {
+    ASSERT(digits >= 0 && digits <= ION_DECIMAL_SMALL_MAX_DIGITS);
+    if (digits < (int)ION_DECIMAL_POWERS_OF_TEN_COUNT) {
+        return g_ion_decimal_powers_of_ten[digits];
+    }
+    return (ION_DECIMAL_SMALL_MAGNITUDE)g_ion_decimal_powers_of_ten[ION_DECIMAL_POWERS_OF_TEN_COUNT - 1]
+         * g_ion_decimal_powers_of_ten[digits - (ION_DECIMAL_POWERS_OF_TEN_COUNT - 1)];
+}
+
+static ION_DECIMAL_SMALL_MAGNITUDE _ion_decimal_small_abs(ION_DECIMAL_SMALL value) {
+    return (value < 0) ? (ION_DECIMAL_SMALL_MAGNITUDE)0 - (ION_DECIMAL_SMALL_MAGNITUDE)value
+                       : (ION_DECIMAL_SMALL_MAGNITUDE)value;
+}
+
+static BOOL _ion_decimal_small_from_quad(const ION_DECIMAL *value, ION_DECIMAL_SMALL *p_coefficient, int32_t *p_exponent) {
+    int64_t coefficient;
+
+    if (value->type != ION_DECIMAL_TYPE_QUAD || !decQuadIsFinite(&value->value.quad_value)) {
+        return FALSE;
+    }
+    if (!decQuadToInt64Parts(&value->value.quad_value, &coefficient, p_exponent)) {
+        return FALSE;
+    }
+    *p_coefficient = coefficient;
+    return TRUE;
+}
+
+// stores coefficient * 10^exponent in value, unless that would take more
+// digits than a decQuad holds or an exponent it cannot
+static BOOL _ion_decimal_small_to_quad(ION_DECIMAL *value, ION_DECIMAL_SMALL coefficient, int64_t exponent) {
+    ION_DECIMAL_SMALL_MAGNITUDE magnitude = _ion_decimal_small_abs(coefficient);
+    uint8_t bcd[DECQUAD_Pmax];
+    int ii;
+
+    if (magnitude >= _ion_decimal_small_power_of_ten(DECQUAD_Pmax)) {
+        return FALSE;
+    }
+    if (exponent < DECQUAD_EXP_MIN || exponent > DECQUAD_EXP_MAX) {
+        return FALSE;
+    }
+    if (magnitude <= UINT64_MAX) {
+        decQuadFromUInt64(&value->value.quad_value, (uint64_t)magnitude, (int32_t)exponent, coefficient < 0);
+    }
+    else {
+        for (ii = DECQUAD_Pmax - 1; ii >= 0; ii--) {
+            bcd[ii] = (uint8_t)(magnitude % 10);
+            magnitude /= 10;
+        }
+        decQuadFromBCD(&value->value.quad_value, (int32_t)exponent, bcd, (coefficient < 0) ? DECFLOAT_Sign : 0);
+    }
+    value->type = ION_DECIMAL_TYPE_QUAD;
+    return TRUE;
+}
+
+// brings two coefficients to the lower of their exponents, unless that takes
+// more than ION_DECIMAL_SMALL_MAX_DIGITS digits
+static BOOL _ion_decimal_small_align(ION_DECIMAL_SMALL *p_lhs, int32_t *p_lhs_exponent, ION_DECIMAL_SMALL *p_rhs,
+                                     int32_t *p_rhs_exponent) {
+    ION_DECIMAL_SMALL *p_scaled;
+    ION_DECIMAL_SMALL_MAGNITUDE power;
+    int64_t shift = (int64_t)*p_lhs_exponent - *p_rhs_exponent;
+
+    if (shift == 0) {
+        return TRUE;
+    }
+    p_scaled = (shift > 0) ? p_lhs : p_rhs;
+    if (shift < 0) shift = -shift;
+    if (shift > ION_DECIMAL_SMALL_MAX_DIGITS) {
+        return FALSE;
+    }
+    power = _ion_decimal_small_power_of_ten((int)shift);
+    if (_ion_decimal_small_abs(*p_scaled) > _ion_decimal_small_power_of_ten(ION_DECIMAL_SMALL_MAX_DIGITS) / power) {
+        return FALSE;
+    }
+    *p_scaled *= (ION_DECIMAL_SMALL)power;
+    if (*p_lhs_exponent > *p_rhs_exponent) {
+        *p_lhs_exponent = *p_rhs_exponent;
+    }
+    else {
+        *p_rhs_exponent = *p_lhs_exponent;
+    }
+    return TRUE;
+}
+
+// the sign of an exact zero result depends on the operands' signs and the
+// rounding mode, which is left to decQuad unless both operands are positive.
+// The signs are passed separately because a subtracted zero counts as negative.
+static BOOL _ion_decimal_small_add_helper(ION_DECIMAL *value, ION_DECIMAL_SMALL lhs, int32_t lhs_exponent,
+                                          BOOL lhs_negative, ION_DECIMAL_SMALL rhs, int32_t rhs_exponent,
+                                          BOOL rhs_negative) {
+    if (!_ion_decimal_small_align(&lhs, &lhs_exponent, &rhs, &rhs_exponent)) {
+        return FALSE;
+    }
+    if ((lhs_negative || rhs_negative) && lhs + rhs == 0) {
+        return FALSE;
+    }
+    return _ion_decimal_small_to_quad(value, lhs + rhs, lhs_exponent);
+}
+
+static BOOL _ion_decimal_add_small(ION_DECIMAL *value, const ION_DECIMAL *lhs, const ION_DECIMAL *rhs,
+                                   decContext *context) {
+    ION_DECIMAL_SMALL lhs_coefficient, rhs_coefficient;
+    int32_t lhs_exponent, rhs_exponent;
+
+    if (!_ion_decimal_small_from_quad(lhs, &lhs_coefficient, &lhs_exponent)
+        || !_ion_decimal_small_from_quad(rhs, &rhs_coefficient, &rhs_exponent)) {
+        return FALSE;
+    }
+    return _ion_decimal_small_add_helper(value, lhs_coefficient, lhs_exponent, lhs_coefficient < 0,
+                                         rhs_coefficient, rhs_exponent, rhs_coefficient < 0);
+}
+
+static BOOL _ion_decimal_subtract_small(ION_DECIMAL *value, const ION_DECIMAL *lhs, const ION_DECIMAL *rhs,
+                                        decContext *context) {
+    ION_DECIMAL_SMALL lhs_coefficient, rhs_coefficient;
+    int32_t lhs_exponent, rhs_exponent;
+
+    if (!_ion_decimal_small_from_quad(lhs, &lhs_coefficient, &lhs_exponent)
+        || !_ion_decimal_small_from_quad(rhs, &rhs_coefficient, &rhs_exponent)) {
+        return FALSE;
+    }
+    return _ion_decimal_small_add_helper(value, lhs_coefficient, lhs_exponent, lhs_coefficient < 0,
+                                         -rhs_coefficient, rhs_exponent, rhs_coefficient >= 0);
+}
+
+static BOOL _ion_decimal_multiply_small(ION_DECIMAL *value, const ION_DECIMAL *lhs, const ION_DECIMAL *rhs,
+                                        decContext *context) {
+    ION_DECIMAL_SMALL lhs_coefficient, rhs_coefficient;
+    int32_t lhs_exponent, rhs_exponent;
+
+    if (!_ion_decimal_small_from_quad(lhs, &lhs_coefficient, &lhs_exponent)
+        || !_ion_decimal_small_from_quad(rhs, &rhs_coefficient, &rhs_exponent)) {
+        return FALSE;
+    }
+    if ((lhs_coefficient < 0 || rhs_coefficient < 0) && (lhs_coefficient == 0 || rhs_coefficient == 0)) {
+        return FALSE; // a negative zero
+    }
+    // two int64_t coefficients always fit in the product
+    return _ion_decimal_small_to_quad(value, lhs_coefficient * rhs_coefficient, (int64_t)lhs_exponent + rhs_exponent);
+}
+
+static BOOL _ion_decimal_fma_small(ION_DECIMAL *value, const ION_DECIMAL *lhs, const ION_DECIMAL *rhs,
+                                   const ION_DECIMAL *fhs, decContext *context) {
+    ION_DECIMAL_SMALL lhs_coefficient, rhs_coefficient, fhs_coefficient, product;
+    int32_t lhs_exponent, rhs_exponent, fhs_exponent;
+    int64_t product_exponent;
+
+    if (!_ion_decimal_small_from_quad(lhs, &lhs_coefficient, &lhs_exponent)
+        || !_ion_decimal_small_from_quad(rhs, &rhs_coefficient, &rhs_exponent)
+        || !_ion_decimal_small_from_quad(fhs, &fhs_coefficient, &fhs_exponent)) {
+        return FALSE;
+    }
+    if (lhs_coefficient < 0 || rhs_coefficient < 0) {
+        if (lhs_coefficient == 0 || rhs_coefficient == 0) {
+            return FALSE; // a negative zero
+        }
+    }
+    product = lhs_coefficient * rhs_coefficient;
+    product_exponent = (int64_t)lhs_exponent + rhs_exponent;
+    if (_ion_decimal_small_abs(product) >= _ion_decimal_small_power_of_ten(DECQUAD_Pmax)
+        || product_exponent < DECQUAD_EXP_MIN || product_exponent > DECQUAD_EXP_MAX) {
+        return FALSE;
+    }
+    return _ion_decimal_small_add_helper(value, product, (int32_t)product_exponent, product < 0,
+                                         fhs_coefficient, fhs_exponent, fhs_coefficient < 0);
+}
+
+#else
+
+#define _ion_decimal_add_small(value, lhs, rhs, context)            FALSE
+#define _ion_decimal_subtract_small(value, lhs, rhs, context)       FALSE
+#define _ion_decimal_multiply_small(value, lhs, rhs, context)       FALSE
+#define _ion_decimal_fma_small(value, lhs, rhs, fhs, context)       FALSE
+
+#endif /* __SIZEOF_INT128__ */
+
+#define ION_DECIMAL_NO_SMALL_CALCULATION(...) FALSE
+
 /* Internal-only operator API building blocks */
 
 #define ION_DECIMAL_LHS_BIT ((uint8_t)0x1)
@@ -363,7 +655,7 @@ iERR ion_decimal_from_ion_int(ION_DECIMAL *value, decContext *context, ION_INT *
 #define ION_DECIMAL_OVERFLOW_API_BUILDER(name, all_decnums_mask, api_params, calculate_quad, quad_args, \
                                          calculate_decnum_mask, calculate_operand_mask, restore_quad,  \
                                          calculate_number, number_args, helper_params, standardize_operands, \
-                                         converted_args, helper_args) \
+                                         converted_args, helper_args, calculate_small, small_args) \
 iERR _##name##_standardized helper_params { \
     iENTER; \
     standardize_operands; \
@@ -410,14 +702,15 @@ iERR name api_params { \
         /* All operands are decNumbers. */ \
         IONCHECK(_##name##_number helper_args); \
     } \
-    else { \
-        /* All operands are decQuads. */ \
+    else if (!calculate_small small_args) { \
+        /* All operands are decQuads, and at least one of them (or the result) is too large to calculate exactly as \
+         * an integer. */ \
         IONCHECK(_##name##_quad helper_args); \
     } \
     iRETURN; \
 }
 
-#define ION_DECIMAL_COMPUTE_API_BUILDER_THREE_OPERAND(name, calculate_quad, calculate_number) \
+#define ION_DECIMAL_COMPUTE_API_BUILDER_THREE_OPERAND(name, calculate_quad, calculate_number, calculate_small) \
     ION_DECIMAL_OVERFLOW_API_BUILDER ( \
         name, \
         /*all_decnums_mask=*/(ION_DECIMAL_LHS_BIT | ION_DECIMAL_RHS_BIT | ION_DECIMAL_FHS_BIT), \
@@ -432,10 +725,15 @@ iERR name api_params { \
         /*helper_params=*/(ION_DECIMAL *value, const ION_DECIMAL *lhs, const ION_DECIMAL *rhs, const ION_DECIMAL *fhs, decContext *context, uint8_t decnum_mask), \
         /*standardize_operands=*/ION_DECIMAL_CONVERT_THREE_OPERAND, \
         /*converted_args=*/(temp, op1, op2, op3, context), \
-        /*helper_args=*/(value, lhs, rhs, fhs, context, decnum_mask) \
+        /*helper_args=*/(value, lhs, rhs, fhs, context, decnum_mask), \
+        calculate_small, \
+        /*small_args=*/(value, lhs, rhs, fhs, context) \
     )
 
 #define ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND(name, calculate_quad, calculate_number) \
+    ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND_SMALL(name, calculate_quad, calculate_number, ION_DECIMAL_NO_SMALL_CALCULATION)
+
+#define ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND_SMALL(name, calculate_quad, calculate_number, calculate_small) \
     ION_DECIMAL_OVERFLOW_API_BUILDER ( \
         name, \
         /*all_decnums_mask=*/(ION_DECIMAL_LHS_BIT | ION_DECIMAL_RHS_BIT), \
@@ -450,7 +748,9 @@ iERR name api_params { \
         /*helper_params=*/(ION_DECIMAL *value, const ION_DECIMAL *lhs, const ION_DECIMAL *rhs, decContext *context, uint8_t decnum_mask), \
         /*standardize_operands=*/ION_DECIMAL_CONVERT_TWO_OPERAND, \
         /*converted_args=*/(temp, op1, op2, context), \
-        /*helper_args=*/(value, lhs, rhs, context, decnum_mask) \
+        /*helper_args=*/(value, lhs, rhs, context, decnum_mask), \
+        calculate_small, \
+        /*small_args=*/(value, lhs, rhs, context) \
     )
 
 #define ION_DECIMAL_BASIC_API_BUILDER(name, api_params, calculate_quad, calculate_number) \
@@ -484,8 +784,8 @@ iERR name api_params { \
 
 /* Operator APIs (computational) */
 
-ION_DECIMAL_COMPUTE_API_BUILDER_THREE_OPERAND(ion_decimal_fma, decQuadFMA, decNumberFMA);
-ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND(ion_decimal_add, decQuadAdd, decNumberAdd);
+ION_DECIMAL_COMPUTE_API_BUILDER_THREE_OPERAND(ion_decimal_fma, decQuadFMA, decNumberFMA, _ion_decimal_fma_small);
+ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND_SMALL(ion_decimal_add, decQuadAdd, decNumberAdd, _ion_decimal_add_small);
 ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND(ion_decimal_and, decQuadAnd, decNumberAnd);
 ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND(ion_decimal_divide, decQuadDivide, decNumberDivide);
 ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND(ion_decimal_divide_integer, decQuadDivideInteger, decNumberDivideInteger);
@@ -493,7 +793,7 @@ ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND(ion_decimal_max, decQuadMax, decNumb
 ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND(ion_decimal_max_mag, decQuadMaxMag, decNumberMaxMag);
 ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND(ion_decimal_min, decQuadMin, decNumberMin);
 ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND(ion_decimal_min_mag, decQuadMinMag, decNumberMinMag);
-ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND(ion_decimal_multiply, decQuadMultiply, decNumberMultiply);
+ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND_SMALL(ion_decimal_multiply, decQuadMultiply, decNumberMultiply, _ion_decimal_multiply_small);
 ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND(ion_decimal_or, decQuadOr, decNumberOr);
 ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND(ion_decimal_quantize, decQuadQuantize, decNumberQuantize);
 ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND(ion_decimal_remainder, decQuadRemainder, decNumberRemainder);
@@ -501,7 +801,7 @@ ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND(ion_decimal_remainder_near, decQuadR
 ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND(ion_decimal_rotate, decQuadRotate, decNumberRotate);
 ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND(ion_decimal_scaleb, decQuadScaleB, decNumberScaleB);
 ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND(ion_decimal_shift, decQuadShift, decNumberShift);
-ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND(ion_decimal_subtract, decQuadSubtract, decNumberSubtract);
+ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND_SMALL(ion_decimal_subtract, decQuadSubtract, decNumberSubtract, _ion_decimal_subtract_small);
 ION_DECIMAL_COMPUTE_API_BUILDER_TWO_OPERAND(ion_decimal_xor, decQuadXor, decNumberXor);
 ION_DECIMAL_COMPUTE_API_BUILDER_ONE_OPERAND(ion_decimal_abs, decQuadAbs, decNumberAbs);
 ION_DECIMAL_COMPUTE_API_BUILDER_ONE_OPERAND(ion_decimal_invert, decQuadInvert, decNumberInvert);
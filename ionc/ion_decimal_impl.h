@@ -45,6 +45,16 @@ extern "C" {
 iERR _ion_decimal_number_alloc(void *owner, SIZE decimal_digits, decNumber **p_number);
 iERR _ion_decimal_from_string_helper(const char *str, decContext *context, hOWNER owner, decQuad *p_quad, decNumber **p_num);
 iERR _ion_decimal_to_string_quad_helper(const decQuad *value, char *p_string, BOOL as_float);
+
+// the longest image _ion_decimal_quad_to_chars writes (which isn't null terminated)
+#define ION_DECIMAL_QUAD_CHARS_MAX DECQUAD_String
+
+// these write Ion decimal syntax (or, with as_float, the JSON number decQuadToString
+// would write) straight into dst and return the end of what they wrote
+char *_ion_decimal_digits_to_chars(char *dst, BOOL is_negative, const char *digits, int digit_count, int32_t exponent,
+                                   BOOL as_float);
+char *_ion_decimal_quad_to_chars(const decQuad *value, char *dst, BOOL as_float);
+char *_ion_decimal_int64_parts_to_chars(int64_t mantissa, int32_t exponent, char *dst, BOOL as_float);
 iERR _ion_decimal_to_string_number_helper(const decNumber *value, char *p_string);
 
 #ifdef __cplusplus
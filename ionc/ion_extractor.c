@@ -14,6 +14,7 @@
 
 #include <ionc/ion_extractor.h>
 #include "ion_extractor_impl.h"
+#include "ion_worker_pool.h"
 
 #if ION_EXTRACTOR_MAX_NUM_PATHS > ION_EXTRACTOR_MAX_NUM_PATHS_THRESHOLD
     #define ION_EXTRACTOR_ACTIVATE_ALL_PATHS(map) memset(map, 0xFF, ION_EXTRACTOR_PATH_BITMAP_BYTE_SIZE)
@@ -347,14 +348,19 @@ iERR _ion_extractor_evaluate_predicate(ION_READER *reader, ION_EXTRACTOR_PATH_CO
 }
 
 iERR _ion_extractor_dispatch_match(ION_EXTRACTOR *extractor, ION_READER *reader, ION_EXTRACTOR_SIZE matcher_index,
-                                   ION_EXTRACTOR_CONTROL *control) {
+                                   ION_EXTRACTOR_MATCH_CONTEXT *context, ION_EXTRACTOR_CONTROL *control) {
     iENTER;
     ION_EXTRACTOR_MATCHER *matcher;
     SIZE old_depth, new_depth;
 
     matcher = &extractor->_matchers[matcher_index];
     IONCHECK(ion_reader_get_depth(reader, &old_depth));
-    IONCHECK(matcher->_callback(reader, matcher->_path, matcher->_user_context, control));
+    if (context && context->_callback) {
+        IONCHECK(context->_callback(reader, matcher->_path, matcher->_user_context, &context->_shard, control));
+    }
+    else {
+        IONCHECK(matcher->_callback(reader, matcher->_path, matcher->_user_context, control));
+    }
     IONCHECK(ion_reader_get_depth(reader, &new_depth));
     if (old_depth != new_depth) {
         FAILWITHMSG(IERR_INVALID_STATE, "Reader must be positioned at same depth after callback returns.");
@@ -364,7 +370,7 @@ iERR _ion_extractor_dispatch_match(ION_EXTRACTOR *extractor, ION_READER *reader,
 }
 
 iERR _ion_extractor_evaluate_predicates(ION_EXTRACTOR *extractor, ION_READER *reader, SIZE depth, POSITION ordinal,
-                                        ION_EXTRACTOR_CONTROL *control,
+                                        ION_EXTRACTOR_MATCH_CONTEXT *context, ION_EXTRACTOR_CONTROL *control,
                                         ION_EXTRACTOR_ACTIVE_PATH_MAP previous_depth_actives,
                                         ION_EXTRACTOR_ACTIVE_PATH_MAP *current_depth_actives) {
     iENTER;
@@ -397,7 +403,7 @@ iERR _ion_extractor_evaluate_predicates(ION_EXTRACTOR *extractor, ION_READER *re
                     // extractor's path components array as dense as possible -- length zero paths are not stored, and
                     // are instead treated as NULL here.
                     ASSERT((!path_component) ? depth == 0 : TRUE);
-                    IONCHECK(_ion_extractor_dispatch_match(extractor, reader, i, control));
+                    IONCHECK(_ion_extractor_dispatch_match(extractor, reader, i, context, control));
                     if (*control) {
                         if (*control > depth) {
                             FAILWITHMSG(IERR_INVALID_STATE, "Received a control instruction to step out past current depth.")
@@ -415,7 +421,7 @@ iERR _ion_extractor_evaluate_predicates(ION_EXTRACTOR *extractor, ION_READER *re
 
 iERR _ion_extractor_match_helper(hEXTRACTOR extractor, ION_READER *reader, SIZE depth,
                                  ION_EXTRACTOR_ACTIVE_PATH_MAP previous_depth_actives,
-                                 ION_EXTRACTOR_CONTROL *control) {
+                                 ION_EXTRACTOR_MATCH_CONTEXT *context, ION_EXTRACTOR_CONTROL *control) {
     iENTER;
     ION_TYPE t;
     POSITION ordinal = 0;
@@ -432,7 +438,7 @@ iERR _ion_extractor_match_helper(hEXTRACTOR extractor, ION_READER *reader, SIZE
             // Everything matches at depth 0.
             ION_EXTRACTOR_ACTIVATE_ALL_PATHS(current_depth_actives);
         }
-        IONCHECK(_ion_extractor_evaluate_predicates(extractor, reader, depth, ordinal, control,
+        IONCHECK(_ion_extractor_evaluate_predicates(extractor, reader, depth, ordinal, context, control,
                                                     previous_depth_actives, &current_depth_actives));
         if (*control) {
             *control -= 1;
@@ -456,7 +462,8 @@ iERR _ion_extractor_match_helper(hEXTRACTOR extractor, ION_READER *reader, SIZE
             case tid_STRUCT_INT:
                 if (ION_EXTRACTOR_ANY_PATHS_ACTIVE(current_depth_actives)) {
                     IONCHECK(ion_reader_step_in(reader));
-                    IONCHECK(_ion_extractor_match_helper(extractor, reader, depth + 1, current_depth_actives, control));
+                    IONCHECK(_ion_extractor_match_helper(extractor, reader, depth + 1, current_depth_actives, context,
+                                                         control));
                     IONCHECK(ion_reader_step_out(reader));
                     if (*control) {
                         *control -= 1;
@@ -489,7 +496,157 @@ iERR ion_extractor_match(ION_EXTRACTOR *extractor, ION_READER *reader) {
         FAILWITHMSG(IERR_INVALID_STATE, "Reader must be at depth 0 to start matching.");
     }
     if (extractor->_matchers_length) {
-        IONCHECK(_ion_extractor_match_helper(extractor, reader, 0, extractor->_depth_zero_active_paths, &control));
+        IONCHECK(_ion_extractor_match_helper(extractor, reader, 0, extractor->_depth_zero_active_paths, NULL,
+                                             &control));
+    }
+    iRETURN;
+}
+
+/**
+ * The first input that failed on a particular worker. Workers claim increasing input indices, so this is also the
+ * lowest-index failure on that worker.
+ */
+typedef struct _ion_extractor_batch_failure {
+    long _index;
+    iERR _err;
+} ION_EXTRACTOR_BATCH_FAILURE;
+
+/**
+ * Shared state for one call to `ion_extractor_match_batch`. Everything but `_counter` and `_abort` is read-only while
+ * the workers run; each input's result slot is written only by the worker that claimed it, and each failure slot only
+ * by its worker.
+ */
+typedef struct _ion_extractor_batch {
+    ION_EXTRACTOR               *_extractor;
+    ION_EXTRACTOR_BATCH_INPUT   *_inputs;
+    SIZE                         _input_count;
+    ION_EXTRACTOR_BATCH_OPTIONS  _options;
+    iERR                        *_results;
+    ION_EXTRACTOR_BATCH_FAILURE *_failures;
+    ION_WORKER_COUNTER           _counter;
+    volatile BOOL                _abort;
+} ION_EXTRACTOR_BATCH;
+
+iERR _ion_extractor_match_batch_input(ION_EXTRACTOR_BATCH *batch, ION_EXTRACTOR_BATCH_INPUT *input,
+                                      ION_EXTRACTOR_MATCH_CONTEXT *context) {
+    iENTER;
+    ION_READER *reader = NULL;
+    ION_STREAM *stream = NULL;
+    ION_EXTRACTOR_CONTROL control = ion_extractor_control_next();
+
+    if (input->buffer) {
+        IONCHECK(ion_reader_open_buffer(&reader, input->buffer, input->buffer_length, batch->_options.reader_options));
+    }
+    else if (input->file) {
+        IONCHECK(ion_stream_open_file_in(input->file, &stream));
+        IONCHECK(ion_reader_open(&reader, stream, batch->_options.reader_options));
+    }
+    else {
+        FAILWITHMSG(IERR_INVALID_ARG, "Batch input must have a buffer or a file.");
+    }
+    IONCHECK(_ion_extractor_match_helper(batch->_extractor, reader, 0, batch->_extractor->_depth_zero_active_paths,
+                                         context, &control));
+
+fail:
+    if (reader) {
+        UPDATEERROR(ion_reader_close(reader));
+    }
+    if (stream) {
+        UPDATEERROR(ion_stream_close(stream));
+    }
+    RETURN(__location_name__, __line__, __count__++, err);
+}
+
+iERR _ion_extractor_match_batch_worker(void *batch_context, int worker_id) {
+    iENTER;
+    ION_EXTRACTOR_BATCH *batch = (ION_EXTRACTOR_BATCH *)batch_context;
+    ION_EXTRACTOR_MATCH_CONTEXT context;
+    iERR input_err;
+    long index;
+
+    context._callback = batch->_options.callback;
+    context._shard.worker_id = worker_id;
+
+    for (;;) {
+        index = _ion_worker_counter_claim(&batch->_counter);
+        if (index >= batch->_input_count) {
+            break;
+        }
+        if (batch->_abort) {
+            input_err = IERR_INVALID_STATE;
+        }
+        else {
+            context._shard.input_index = (SIZE)index;
+            input_err = _ion_extractor_match_batch_input(batch, &batch->_inputs[index], &context);
+            if (input_err && batch->_failures[worker_id]._err == IERR_OK) {
+                batch->_failures[worker_id]._index = index;
+                batch->_failures[worker_id]._err = input_err;
+            }
+            if (input_err && batch->_options.stop_on_error) {
+                batch->_abort = TRUE;
+            }
+        }
+        if (batch->_results) {
+            batch->_results[index] = input_err;
+        }
     }
     iRETURN;
 }
+
+iERR ion_extractor_match_batch(ION_EXTRACTOR *extractor, ION_EXTRACTOR_BATCH_INPUT *inputs, SIZE input_count,
+                               ION_EXTRACTOR_BATCH_OPTIONS *options, iERR *p_results) {
+    iENTER;
+    ION_EXTRACTOR_BATCH batch;
+    ION_EXTRACTOR_BATCH_FAILURE *first_failure = NULL;
+    int i;
+
+    ASSERT(extractor);
+    memset(&batch, 0, sizeof(ION_EXTRACTOR_BATCH));
+
+    if (input_count < 0 || (input_count > 0 && !inputs)) {
+        FAILWITH(IERR_INVALID_ARG);
+    }
+    if (ION_EXTRACTOR_ANY_PATHS_ACTIVE(extractor->_path_in_progress)) {
+        FAILWITHMSG(IERR_INVALID_STATE, "Cannot start matching with a path in progress.");
+    }
+    if (input_count == 0 || !extractor->_matchers_length) {
+        SUCCEED();
+    }
+
+    if (options) {
+        batch._options = *options;
+    }
+    if (batch._options.num_workers < 1) {
+        batch._options.num_workers = _ion_worker_pool_default_size();
+    }
+    if (batch._options.num_workers > input_count) {
+        batch._options.num_workers = input_count;
+    }
+    batch._failures = (ION_EXTRACTOR_BATCH_FAILURE *)ion_xalloc(
+            batch._options.num_workers * sizeof(ION_EXTRACTOR_BATCH_FAILURE));
+    if (!batch._failures) {
+        FAILWITH(IERR_NO_MEMORY);
+    }
+    memset(batch._failures, 0, batch._options.num_workers * sizeof(ION_EXTRACTOR_BATCH_FAILURE));
+    batch._extractor = extractor;
+    batch._inputs = inputs;
+    batch._input_count = input_count;
+    batch._results = p_results;
+
+    IONCHECK(_ion_worker_pool_run(batch._options.num_workers, &_ion_extractor_match_batch_worker, &batch));
+    for (i = 0; i < batch._options.num_workers; i++) {
+        if (batch._failures[i]._err != IERR_OK
+            && (!first_failure || batch._failures[i]._index < first_failure->_index)) {
+            first_failure = &batch._failures[i];
+        }
+    }
+    if (first_failure) {
+        FAILWITH(first_failure->_err);
+    }
+
+fail:
+    if (batch._failures) {
+        ion_xfree(batch._failures);
+    }
+    RETURN(__location_name__, __line__, __count__++, err);
+}
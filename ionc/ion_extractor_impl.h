@@ -195,6 +195,23 @@ struct _ion_extractor {
 
 };
 
+/**
+ * Per-worker state for a single `ion_extractor_match_batch` input. Matching through `ion_extractor_match` uses no
+ * context. This is kept apart from ION_EXTRACTOR so that the extractor itself is never written during matching.
+ */
+typedef struct _ion_extractor_match_context {
+    /**
+     * If non-null, invoked on match in place of the matcher's callback.
+     */
+    ION_EXTRACTOR_BATCH_CALLBACK _callback;
+
+    /**
+     * The worker and input being matched.
+     */
+    ION_EXTRACTOR_SHARD _shard;
+
+} ION_EXTRACTOR_MATCH_CONTEXT;
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2009-2016 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at:
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ */
+
+#ifndef IONC_ION_FLOAT_IMPL_H
+#define IONC_ION_FLOAT_IMPL_H
+
+#include <ionc/ion_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Converts the text of an Ion float, `[-]digits[.digits](e|E)[+|-]digits`, to the
+ * nearest double. The text need not be null terminated, and '_' digit separators
+ * are ignored. The conversion does not depend on the current locale.
+ */
+iERR _ion_float_parse_double(const char *str, SIZE len, double *p_value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //IONC_ION_FLOAT_IMPL_H
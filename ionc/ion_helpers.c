@@ -416,6 +416,75 @@ overflow:
     return NULL; // this should force a null pointer exception in the caller
 }
 
+static const char _ion_digit_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+int _ion_uint64_digit_count(uint64_t value)
+{
+    int count = 1;
+
+    // four digits per division, most values settle in the first pass
+    for (;;) {
+        if (value < 10)    return count;
+        if (value < 100)   return count + 1;
+        if (value < 1000)  return count + 2;
+        if (value < 10000) return count + 3;
+        value /= 10000;
+        count += 4;
+    }
+}
+
+char *_ion_uint64_to_chars(uint64_t value, char *dst)
+{
+    char    *end = dst + _ion_uint64_digit_count(value);
+    char    *cp = end;
+    unsigned pair;
+
+    // fill from the least significant end, two digits per division
+    while (value >= 100) {
+        pair = (unsigned)(value % 100) * 2;
+        value /= 100;
+        *--cp = _ion_digit_pairs[pair + 1];
+        *--cp = _ion_digit_pairs[pair];
+    }
+    if (value >= 10) {
+        pair = (unsigned)value * 2;
+        *--cp = _ion_digit_pairs[pair + 1];
+        *--cp = _ion_digit_pairs[pair];
+    }
+    else {
+        *--cp = (char)('0' + value);
+    }
+    ASSERT(cp == dst);
+
+    return end;
+}
+
+void _ion_uint32_to_chars_padded(uint32_t value, char *dst, int width)
+{
+    char    *cp = dst + width;
+    unsigned pair;
+
+    while (cp - dst >= 2) {
+        pair = (value % 100) * 2;
+        value /= 100;
+        *--cp = _ion_digit_pairs[pair + 1];
+        *--cp = _ion_digit_pairs[pair];
+    }
+    if (cp > dst) {
+        *--cp = (char)('0' + value % 10);
+    }
+}
+
 SIZE _ion_strnlen(const char *str, const SIZE maxlen) {
     const char *pos = (const char *)memchr(str, '\0', maxlen);
     SIZE len = maxlen;
@@ -493,7 +562,8 @@ uint64_t abs_int64(int64_t value) {
         unsignedValue = value;
     }
     else {
-      unsignedValue = (uint64_t)-value;
+      // negating in unsigned arithmetic, as -INT64_MIN overflows
+      unsignedValue = (uint64_t)0 - (uint64_t)value;
     }
     return unsignedValue;
 }
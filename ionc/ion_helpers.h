@@ -64,6 +64,14 @@ ION_API_EXPORT const char *ion_error_to_str(iERR err);
 char *_ion_itoa_10(int32_t val, char *dst, SIZE len);
 char *_ion_i64toa_10(int64_t val, char *dst, SIZE len);
 
+// fast unsigned integer to decimal characters, two digits per step. these
+// don't null terminate: the caller sizes dst with _ion_uint64_digit_count
+// and _ion_uint64_to_chars returns the end of what it wrote
+int   _ion_uint64_digit_count(uint64_t value);
+char *_ion_uint64_to_chars(uint64_t value, char *dst);
+// writes exactly width digits, with leading zeros as needed
+void  _ion_uint32_to_chars_padded(uint32_t value, char *dst, int width);
+
 // utility for portable strnlen
 ION_API_EXPORT SIZE _ion_strnlen(const char *str, const SIZE maxlen);
 
@@ -42,6 +42,38 @@
 #include <math.h>
 #include "ion_internal.h"
 
+// Values whose magnitude fits in a pointer are kept without a digit array:
+// _len is II_INLINE_LEN and the magnitude itself is stored in the _digits
+// field. Such an int never allocates and stays valid when copied by
+// assignment. Code that reads the digits goes through _ion_int_digits,
+// _ion_int_extend_digits turns the value back into a digit array before
+// the digits are written.
+#define II_INLINE_LEN               (-2)
+#define II_INLINE_MAX               ((uint64_t)UINTPTR_MAX)
+#define II_INLINE_DIGIT_COUNT       3 /* enough for the magnitude of any uint64_t */
+#define II_IS_INLINE(iint)          ((iint)->_len == II_INLINE_LEN)
+#define II_INLINE_MAGNITUDE(iint)   ((uint64_t)(uintptr_t)(iint)->_digits)
+
+// returns the digits of iint and their count. an inline value is spelled
+// out into inline_digits, which has room for II_INLINE_DIGIT_COUNT digits
+static II_DIGIT *_ion_int_digits(const ION_INT *iint, II_DIGIT *inline_digits, SIZE *p_len)
+{
+    uint64_t magnitude;
+    SIZE     ii;
+
+    if (!II_IS_INLINE(iint)) {
+        *p_len = iint->_len;
+        return iint->_digits;
+    }
+    magnitude = II_INLINE_MAGNITUDE(iint);
+    for (ii = II_INLINE_DIGIT_COUNT - 1; ii >= 0; ii--) {
+        inline_digits[ii] = (II_DIGIT)(magnitude & II_MASK);
+        magnitude >>= II_SHIFT;
+    }
+    *p_len = II_INLINE_DIGIT_COUNT;
+    return inline_digits;
+}
+
 iERR ion_int_alloc(void *owner, ION_INT **piint)
 {
     iENTER;
@@ -63,7 +95,7 @@ iERR ion_int_alloc(void *owner, ION_INT **piint)
 void ion_int_free(ION_INT *iint) 
 {
     if (iint && NULL == iint->_owner) {
-        if (iint->_digits) {
+        if (iint->_digits && !II_IS_INLINE(iint)) {
             ion_xfree(iint->_digits);
             iint->_digits = NULL;
         }
@@ -92,7 +124,10 @@ iERR ion_int_copy(ION_INT *dst, ION_INT *src, void *owner)
     dst->_signum = src->_signum;
     dst->_len = src->_len;
     dst->_owner = owner;
-    if (src->_digits) {
+    if (II_IS_INLINE(src)) {
+        dst->_digits = src->_digits;
+    }
+    else if (src->_digits) {
         digits_len = dst->_len * sizeof(II_DIGIT);
         if (dst->_owner) {
             dst->_digits = ion_alloc_with_owner(dst->_owner, (SIZE)digits_len);
@@ -135,8 +170,9 @@ iERR ion_int_is_zero(ION_INT *iint, BOOL *p_bool)
         *p_bool = TRUE;
     }
     else {
-        ASSERT(iint->_digits); // if iint isn't 0 or null, there better be some bits
-        *p_bool = _ion_int_is_zero_bytes(iint->_digits, iint->_len);
+        ASSERT(!_ion_int_is_null_helper(iint)); // if iint isn't 0 or null, there better be some bits
+        *p_bool = II_IS_INLINE(iint) ? (II_INLINE_MAGNITUDE(iint) == 0)
+                                     : _ion_int_is_zero_bytes(iint->_digits, iint->_len);
     }
     SUCCEED();
 
@@ -150,8 +186,10 @@ iERR ion_int_compare(ION_INT *iint1, ION_INT *iint2, int *p_result)
     BOOL      is_null1, is_null2;
     SIZE    bits1, bits2;
     SIZE    count;
+    SIZE    len1, len2;
     II_DIGIT  digit1, digit2;
     II_DIGIT *digits1, *digits2;
+    II_DIGIT  inline1[II_INLINE_DIGIT_COUNT], inline2[II_INLINE_DIGIT_COUNT];
 
     if (!iint1) FAILWITH(IERR_INVALID_ARG);
     if (!iint2) FAILWITH(IERR_INVALID_ARG);
@@ -184,8 +222,10 @@ iERR ion_int_compare(ION_INT *iint1, ION_INT *iint2, int *p_result)
     
     // finally - we have to actually check the bits themselves
     count = ((bits1 - 1) / II_BITS_PER_II_DIGIT) + 1;
-    digits1 = iint1->_digits + (iint1->_len - count);
-    digits2 = iint2->_digits + (iint2->_len - count);
+    digits1 = _ion_int_digits(iint1, inline1, &len1);
+    digits2 = _ion_int_digits(iint2, inline2, &len2);
+    digits1 += len1 - count;
+    digits2 += len2 - count;
     while(count-- > 0) {
         digit1 = *digits1++;
         digit2 = *digits2++;
@@ -258,15 +298,431 @@ iERR ion_int_from_chars(ION_INT *iint, const char *p_chars, SIZE char_limit)
     iRETURN;
 }
 
+// with a 128 bit intermediate a whole uint64_t worth of decimal digits can be
+// multiplied into the 31 bit digits at once, otherwise 9 digits fit
+#ifdef __SIZEOF_INT128__
+typedef unsigned __int128 II_WIDE_LONG_DIGIT;
+typedef uint64_t          II_WIDE_DIGIT;
+#define II_STRING_WIDE_CHUNK_DIGITS 18
+#else
+typedef II_LONG_DIGIT     II_WIDE_LONG_DIGIT;
+typedef II_DIGIT          II_WIDE_DIGIT;
+#define II_STRING_WIDE_CHUNK_DIGITS II_STRING_CHUNK_DIGITS
+#endif
+
+static const II_WIDE_DIGIT g_ion_int_wide_powers_of_ten[] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u
+#ifdef __SIZEOF_INT128__
+    , 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull
+    , 1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull
+#endif
+};
+
+// digits = digits * mult_value + add_value, where only the last used digits
+// may be non zero. returns the number of digits in use afterwards, the caller
+// makes sure there is room for them
+static SIZE _ion_int_multiply_and_add_wide(II_DIGIT *digits, SIZE digit_count, SIZE used
+                                         , II_WIDE_DIGIT mult_value, II_WIDE_DIGIT add_value)
+{
+    II_WIDE_LONG_DIGIT temp, carry = add_value;
+    SIZE               ii;
+
+    for (ii = 0; ii < used; ii++) {
+        temp = ((II_WIDE_LONG_DIGIT)digits[digit_count - 1 - ii] * mult_value) + carry;
+        digits[digit_count - 1 - ii] = (II_DIGIT)(temp & II_MASK);
+        carry = temp >> II_SHIFT;
+    }
+    while (carry != 0) {
+        ASSERT(used < digit_count);
+        digits[digit_count - 1 - used] = (II_DIGIT)(carry & II_MASK);
+        carry >>= II_SHIFT;
+        used++;
+    }
+    return used;
+}
+
+//
+// Divide and conquer radix conversion, for values too long for the digit at a
+// time loops in _ion_int_from_chars_helper and _ion_int_to_string_helper.
+// Text is first cut into limbs of II_STRING_CHUNK_BASE (9 decimal digits),
+// and the value is then moved between that base and II_BASE by splitting
+// the limbs in two, converting each half and joining them again with one
+// multiplication by a power of the source base, which is precomputed in
+// the destination base by repeated squaring. The multiplications use
+// Karatsuba above II_KARATSUBA_THRESHOLD limbs, so the conversion is no
+// longer quadratic in the length of the value.
+//
+// Unlike the II_DIGIT arrays of ION_INT, the limb arrays here are little
+// endian, element 0 is the least significant.
+//
+#define II_RADIX_THRESHOLD      32  /* limbs converted one at a time, below this */
+#define II_KARATSUBA_THRESHOLD  24  /* limbs multiplied the schoolbook way, below this */
+
+// r[0..an+bn) = a * b in base, r must not overlap a or b
+static void _ion_int_limbs_multiply_basic(const uint32_t *a, SIZE an, const uint32_t *b, SIZE bn
+                                        , uint32_t *r, uint32_t base)
+{
+    uint64_t t, carry;
+    SIZE     ii, jj;
+
+    memset(r, 0, (an + bn) * sizeof(uint32_t));
+    for (ii = 0; ii < an; ii++) {
+        carry = 0;
+        if (base == II_BASE) {
+            for (jj = 0; jj < bn; jj++) {
+                t = ((uint64_t)a[ii] * b[jj]) + r[ii + jj] + carry;
+                r[ii + jj] = (uint32_t)(t & II_MASK);
+                carry = t >> II_SHIFT;
+            }
+        }
+        else {
+            for (jj = 0; jj < bn; jj++) {
+                t = ((uint64_t)a[ii] * b[jj]) + r[ii + jj] + carry;
+                r[ii + jj] = (uint32_t)(t % base);
+                carry = t / base;
+            }
+        }
+        r[ii + bn] = (uint32_t)carry;
+    }
+}
+
+// r[0..rn) += a[0..an), the sum has to fit in rn limbs
+static void _ion_int_limbs_add(uint32_t *r, SIZE rn, const uint32_t *a, SIZE an, uint32_t base)
+{
+    uint32_t carry = 0, t;
+    SIZE     ii;
+
+    ASSERT(an <= rn);
+    for (ii = 0; ii < an || (carry && ii < rn); ii++) {
+        t = r[ii] + carry + ((ii < an) ? a[ii] : 0);
+        carry = (t >= base);
+        r[ii] = carry ? t - base : t;
+    }
+    ASSERT(!carry);
+}
+
+// r[0..rn) -= a[0..an), r has to be at least as large as a
+static void _ion_int_limbs_subtract(uint32_t *r, SIZE rn, const uint32_t *a, SIZE an, uint32_t base)
+{
+    uint32_t borrow = 0, sub;
+    SIZE     ii;
+
+    ASSERT(an <= rn);
+    for (ii = 0; ii < an || (borrow && ii < rn); ii++) {
+        sub = borrow + ((ii < an) ? a[ii] : 0);
+        borrow = (r[ii] < sub);
+        r[ii] = borrow ? (r[ii] + base) - sub : r[ii] - sub;
+    }
+    ASSERT(!borrow);
+}
+
+// r[0..an+bn) = a * b in base, r must not overlap a or b
+static iERR _ion_int_limbs_multiply(const uint32_t *a, SIZE an, const uint32_t *b, SIZE bn
+                                  , uint32_t *r, uint32_t base)
+{
+    iENTER;
+    const uint32_t *t;
+    uint32_t       *scratch = NULL, *sa, *sb, *z1;
+    SIZE            m, n, zn;
+
+    if (an < bn) {
+        t = a; a = b; b = t;
+        n = an; an = bn; bn = n;
+    }
+    if (bn < II_KARATSUBA_THRESHOLD) {
+        _ion_int_limbs_multiply_basic(a, an, b, bn, r, base);
+        SUCCEED();
+    }
+
+    m = (an + 1) / 2;
+    if (bn <= m) {
+        // too lopsided to split both, a0 * b + (a1 * b << m)
+        scratch = (uint32_t *)ion_xalloc((an - m + bn) * sizeof(uint32_t));
+        if (!scratch) FAILWITH(IERR_NO_MEMORY);
+        IONCHECK(_ion_int_limbs_multiply(a, m, b, bn, r, base));
+        memset(r + m + bn, 0, (an - m) * sizeof(uint32_t));
+        IONCHECK(_ion_int_limbs_multiply(a + m, an - m, b, bn, scratch, base));
+        _ion_int_limbs_add(r + m, an + bn - m, scratch, an - m + bn, base);
+        SUCCEED();
+    }
+
+    // z0 = a0 * b0 and z2 = a1 * b1 go straight into r, z1 = (a0 + a1) * (b0 + b1) - z0 - z2
+    zn = 2 * (m + 1);
+    scratch = (uint32_t *)ion_xalloc((2 * (m + 1) + zn) * sizeof(uint32_t));
+    if (!scratch) FAILWITH(IERR_NO_MEMORY);
+    sa = scratch;
+    sb = sa + m + 1;
+    z1 = sb + m + 1;
+
+    memcpy(sa, a, m * sizeof(uint32_t));
+    sa[m] = 0;
+    _ion_int_limbs_add(sa, m + 1, a + m, an - m, base);
+    memcpy(sb, b, m * sizeof(uint32_t));
+    sb[m] = 0;
+    _ion_int_limbs_add(sb, m + 1, b + m, bn - m, base);
+    IONCHECK(_ion_int_limbs_multiply(sa, m + 1, sb, m + 1, z1, base));
+
+    IONCHECK(_ion_int_limbs_multiply(a, m, b, m, r, base));
+    IONCHECK(_ion_int_limbs_multiply(a + m, an - m, b + m, bn - m, r + 2 * m, base));
+    _ion_int_limbs_subtract(z1, zn, r, 2 * m, base);
+    _ion_int_limbs_subtract(z1, zn, r + 2 * m, (an - m) + (bn - m), base);
+    while (zn > 0 && z1[zn - 1] == 0) zn--;
+    _ion_int_limbs_add(r + m, an + bn - m, z1, zn, base);
+
+    SUCCEED();
+
+fail:
+    if (scratch) ion_xfree(scratch);
+    RETURN(__file__, __line__, __count__, err);
+}
+
+// the base case: dst = src a limb at a time, from the most significant one,
+// as dst * src_base + limb. returns the number of dst limbs
+static SIZE _ion_int_limbs_convert_basic(const uint32_t *src, SIZE n, uint32_t src_base
+                                       , uint32_t *dst, uint32_t dst_base)
+{
+    uint64_t t, carry;
+    SIZE     ii, jj, used = 0;
+
+    for (ii = n - 1; ii >= 0; ii--) {
+        carry = src[ii];
+        for (jj = 0; jj < used; jj++) {
+            t = ((uint64_t)dst[jj] * src_base) + carry;
+            dst[jj] = (uint32_t)(t % dst_base);
+            carry = t / dst_base;
+        }
+        while (carry) {
+            dst[used++] = (uint32_t)(carry % dst_base);
+            carry /= dst_base;
+        }
+    }
+    return used;
+}
+
+// powers[j] holds src_base ^ (II_RADIX_THRESHOLD << j) in dst_base
+typedef struct _ion_int_radix_powers
+{
+    uint32_t *limbs[32];
+    SIZE      lengths[32];
+    int       count;
+
+} II_RADIX_POWERS;
+
+static void _ion_int_radix_powers_free(II_RADIX_POWERS *powers)
+{
+    int ii;
+    for (ii = 0; ii < powers->count; ii++) {
+        ion_xfree(powers->limbs[ii]);
+    }
+    powers->count = 0;
+}
+
+// computes the powers needed to split n source limbs
+static iERR _ion_int_radix_powers_init(II_RADIX_POWERS *powers, SIZE n, uint32_t src_base, uint32_t dst_base)
+{
+    iENTER;
+    uint32_t *one = NULL, *square;
+    SIZE      len, split;
+
+    powers->count = 0;
+
+    // 1 followed by II_RADIX_THRESHOLD zero limbs, converted the slow way
+    one = (uint32_t *)ion_xalloc((II_RADIX_THRESHOLD + 1) * sizeof(uint32_t));
+    if (!one) FAILWITH(IERR_NO_MEMORY);
+    memset(one, 0, (II_RADIX_THRESHOLD + 1) * sizeof(uint32_t));
+    one[II_RADIX_THRESHOLD] = 1;
+    powers->limbs[0] = (uint32_t *)ion_xalloc((2 * II_RADIX_THRESHOLD + 2) * sizeof(uint32_t));
+    if (!powers->limbs[0]) FAILWITH(IERR_NO_MEMORY);
+    powers->count = 1;
+    powers->lengths[0] = _ion_int_limbs_convert_basic(one, II_RADIX_THRESHOLD + 1, src_base, powers->limbs[0], dst_base);
+
+    for (split = II_RADIX_THRESHOLD; 2 * split < n; split *= 2) {
+        ASSERT(powers->count < 32);
+        len = powers->lengths[powers->count - 1];
+        square = (uint32_t *)ion_xalloc(2 * len * sizeof(uint32_t));
+        if (!square) FAILWITH(IERR_NO_MEMORY);
+        powers->limbs[powers->count] = square;
+        powers->count++;
+        IONCHECK(_ion_int_limbs_multiply(powers->limbs[powers->count - 2], len, powers->limbs[powers->count - 2], len
+                                       , square, dst_base));
+        len *= 2;
+        while (len > 1 && square[len - 1] == 0) len--;
+        powers->lengths[powers->count - 1] = len;
+    }
+    SUCCEED();
+
+fail:
+    if (one) ion_xfree(one);
+    if (err != IERR_OK) _ion_int_radix_powers_free(powers);
+    RETURN(__file__, __line__, __count__, err);
+}
+
+// dst = src, moved from src_base into dst_base. dst has room for dst_max
+// limbs, which must be enough for the value, and *p_used gets the count used
+static iERR _ion_int_limbs_convert(const uint32_t *src, SIZE n, uint32_t src_base, uint32_t *dst, SIZE dst_max
+                                 , uint32_t dst_base, II_RADIX_POWERS *powers, SIZE *p_used)
+{
+    iENTER;
+    uint32_t *hi = NULL;
+    SIZE      split, hi_max, hi_used, lo_used, used;
+    int       level;
+
+    while (n > 0 && src[n - 1] == 0) n--;
+    if (n <= II_RADIX_THRESHOLD) {
+        *p_used = _ion_int_limbs_convert_basic(src, n, src_base, dst, dst_base);
+        ASSERT(*p_used <= dst_max);
+        SUCCEED();
+    }
+
+    // split at the largest power that leaves the high half non empty
+    level = 0;
+    split = II_RADIX_THRESHOLD;
+    while (2 * split < n) {
+        split *= 2;
+        level++;
+    }
+    ASSERT(level < powers->count);
+
+    // the low half is converted in place, the high half on the side
+    hi_max = dst_max;
+    hi = (uint32_t *)ion_xalloc(hi_max * sizeof(uint32_t));
+    if (!hi) FAILWITH(IERR_NO_MEMORY);
+    IONCHECK(_ion_int_limbs_convert(src + split, n - split, src_base, hi, hi_max, dst_base, powers, &hi_used));
+    IONCHECK(_ion_int_limbs_convert(src, split, src_base, dst, dst_max, dst_base, powers, &lo_used));
+
+    // dst = hi * power + lo
+    used = hi_used + powers->lengths[level];
+    {
+        uint32_t *product = (uint32_t *)ion_xalloc((used + 1) * sizeof(uint32_t));
+        if (!product) FAILWITH(IERR_NO_MEMORY);
+        err = _ion_int_limbs_multiply(hi, hi_used, powers->limbs[level], powers->lengths[level], product, dst_base);
+        if (err == IERR_OK) {
+            product[used] = 0;
+            _ion_int_limbs_add(product, used + 1, dst, lo_used, dst_base);
+            used++;
+            while (used > 0 && product[used - 1] == 0) used--;
+            ASSERT(used <= dst_max);
+            memcpy(dst, product, used * sizeof(uint32_t));
+        }
+        ion_xfree(product);
+        IONCHECK(err);
+    }
+    *p_used = used;
+    SUCCEED();
+
+fail:
+    if (hi) ion_xfree(hi);
+    RETURN(__file__, __line__, __count__, err);
+}
+
+// converts n limbs from src_base into a fresh array of dst_base limbs,
+// which the caller frees with ion_xfree
+static iERR _ion_int_limbs_convert_all(const uint32_t *src, SIZE n, uint32_t src_base, uint32_t dst_base
+                                     , SIZE dst_max, uint32_t **p_dst, SIZE *p_used)
+{
+    iENTER;
+    II_RADIX_POWERS powers;
+    uint32_t       *dst = NULL;
+
+    powers.count = 0;
+    IONCHECK(_ion_int_radix_powers_init(&powers, n, src_base, dst_base));
+    dst = (uint32_t *)ion_xalloc(dst_max * sizeof(uint32_t));
+    if (!dst) FAILWITH(IERR_NO_MEMORY);
+    IONCHECK(_ion_int_limbs_convert(src, n, src_base, dst, dst_max, dst_base, &powers, p_used));
+    *p_dst = dst;
+    dst = NULL;
+    SUCCEED();
+
+fail:
+    if (dst) ion_xfree(dst);
+    _ion_int_radix_powers_free(&powers);
+    RETURN(__file__, __line__, __count__, err);
+}
+
+// the decimal digits cp..end, already validated, into the digits of iint
+static iERR _ion_int_from_long_chars(ION_INT *iint, const char *cp, const char *end, SIZE ii_length, BOOL *p_is_zero)
+{
+    iENTER;
+    uint32_t   *chunks = NULL, *binary = NULL, chunk;
+    SIZE        chunk_count, used, ii;
+    const char *chunk_start, *digit;
+
+    // cut the text into 9 digit chunks from its end, the most significant one may be short
+    chunk_count = (SIZE)(((end - cp) + II_STRING_CHUNK_DIGITS - 1) / II_STRING_CHUNK_DIGITS);
+    chunks = (uint32_t *)ion_xalloc(chunk_count * sizeof(uint32_t));
+    if (!chunks) FAILWITH(IERR_NO_MEMORY);
+    for (ii = 0; ii < chunk_count; ii++) {
+        chunk_start = (end - cp < II_STRING_CHUNK_DIGITS) ? cp : end - II_STRING_CHUNK_DIGITS;
+        chunk = 0;
+        for (digit = chunk_start; digit < end; digit++) {
+            chunk = (chunk * II_STRING_BASE) + (*digit - '0');
+        }
+        chunks[ii] = chunk;
+        end = chunk_start;
+    }
+
+    IONCHECK(_ion_int_limbs_convert_all(chunks, chunk_count, II_STRING_CHUNK_BASE, II_BASE, ii_length, &binary, &used));
+
+    IONCHECK(_ion_int_extend_digits(iint, ii_length, TRUE));
+    ASSERT(used <= iint->_len);
+    for (ii = 0; ii < used; ii++) {
+        iint->_digits[iint->_len - 1 - ii] = binary[ii];
+    }
+    *p_is_zero = (used == 0);
+    SUCCEED();
+
+fail:
+    if (chunks) ion_xfree(chunks);
+    if (binary) ion_xfree(binary);
+    RETURN(__file__, __line__, __count__, err);
+}
+
+// the magnitude of the len big endian digits as text, written backwards so
+// that it ends just before *p_cp, which is moved to its first character
+static iERR _ion_int_to_long_chars(const II_DIGIT *digits, SIZE len, char **p_cp)
+{
+    iENTER;
+    uint32_t *binary = NULL, *chunks = NULL;
+    SIZE      ii, used, chunk_max;
+    char     *cp = *p_cp;
+
+    binary = (uint32_t *)ion_xalloc(len * sizeof(uint32_t));
+    if (!binary) FAILWITH(IERR_NO_MEMORY);
+    for (ii = 0; ii < len; ii++) {
+        binary[ii] = digits[len - 1 - ii];
+    }
+
+    // 31 bits take a little more than one 9 digit chunk (29.9 bits)
+    chunk_max = len + (len / 16) + 2;
+    IONCHECK(_ion_int_limbs_convert_all(binary, len, II_BASE, II_STRING_CHUNK_BASE, chunk_max, &chunks, &used));
+
+    ASSERT(used > 0);
+    for (ii = 0; ii < used - 1; ii++) {
+        cp -= II_STRING_CHUNK_DIGITS;
+        _ion_uint32_to_chars_padded(chunks[ii], cp, II_STRING_CHUNK_DIGITS);
+    }
+    cp -= _ion_uint64_digit_count(chunks[used - 1]);
+    _ion_uint64_to_chars(chunks[used - 1], cp);
+    *p_cp = cp;
+    SUCCEED();
+
+fail:
+    if (binary) ion_xfree(binary);
+    if (chunks) ion_xfree(chunks);
+    RETURN(__file__, __line__, __count__, err);
+}
+
 iERR _ion_int_from_chars_helper(ION_INT *iint, const char *str, SIZE len)
 {
     iENTER;
-    const char *cp, *end;
+    const char *cp, *end, *chunk_start;
     int        signum = 1;
-    int        decimal_digits, bits, ii_length;
+    int        decimal_digits, bits, ii_length, chunk_digits;
     BOOL       is_zero;
-    II_DIGIT  *digits, d;
- 
+    II_DIGIT  *digits;
+    II_WIDE_DIGIT chunk;
+    SIZE       used;
+
 
     cp = str;
     end = cp + len;
@@ -309,16 +765,33 @@ iERR _ion_int_from_chars_helper(ION_INT *iint, const char *str, SIZE len)
     
     bits = (SIZE)((II_BITS_PER_DEC_DIGIT * decimal_digits) + 1);
     ii_length = (SIZE)(((double)(bits - 1) / II_BITS_PER_II_DIGIT) + 1);
+
+    if (decimal_digits > II_RADIX_THRESHOLD * II_STRING_CHUNK_DIGITS) {
+        for (chunk_start = cp; chunk_start < end; chunk_start++) {
+            if (!isdigit(*chunk_start)) FAILWITH(IERR_INVALID_SYNTAX);
+        }
+        IONCHECK(_ion_int_from_long_chars(iint, cp, end, ii_length, &is_zero));
+        iint->_signum = is_zero ? 0 : signum;
+        SUCCEED();
+    }
+
     IONCHECK(_ion_int_extend_digits(iint, ii_length, TRUE));
     
+    // the characters are taken a chunk at a time, and each chunk only has
+    // to be multiplied into the digits the value has grown into so far
     is_zero = TRUE;
     digits = iint->_digits;
+    used = 0;
     while (cp < end) {
-        if (!isdigit(*cp)) FAILWITH(IERR_INVALID_SYNTAX);
-        d = *cp++ - '0';
-        if (d) is_zero = FALSE;
-        //mult_add(iint, iint, 10, d);
-        IONCHECK(_ion_int_multiply_and_add(digits, iint->_len, II_STRING_BASE, d));
+        chunk = 0;
+        chunk_digits = 0;
+        while (cp < end && chunk_digits < II_STRING_WIDE_CHUNK_DIGITS) {
+            if (!isdigit(*cp)) FAILWITH(IERR_INVALID_SYNTAX);
+            chunk = (chunk * II_STRING_BASE) + (*cp++ - '0');
+            chunk_digits++;
+        }
+        if (chunk) is_zero = FALSE;
+        used = _ion_int_multiply_and_add_wide(digits, iint->_len, used, g_ion_int_wide_powers_of_ten[chunk_digits], chunk);
     }
     
     // set the signum value now
@@ -615,20 +1088,12 @@ iERR ion_int_from_abs_bytes(ION_INT *iint, BYTE *buf, SIZE limit, BOOL is_negati
 iERR ion_int_from_long(ION_INT *iint, int64_t value)
 {
     iENTER;
-    SIZE  ii_length, digit_idx;
     // Stores the unsigned magnitude of the provided int64_t value. This variable must be
     // unsigned to accommodate the absolute value of MIN_INT64, which requires 64 bits to store.
     uint64_t magnitude;
-    // Used for shifting operations that consume the variable.
-    uint64_t temp_magnitude;
     BOOL is_negative;
 
     IONCHECK(_ion_int_validate_arg(iint));
-    
-    if (!value) {
-        IONCHECK(_ion_int_zero(iint));
-        SUCCEED();
-    }
 
     is_negative = value < 0;
     magnitude = (uint64_t) value;
@@ -638,24 +1103,7 @@ iERR ion_int_from_long(ION_INT *iint, int64_t value)
         magnitude = -magnitude;
     }
 
-    ii_length = 0;
-    temp_magnitude = magnitude;
-    while (temp_magnitude) {
-        temp_magnitude >>= II_SHIFT;
-        ii_length++;
-    }
-
-    // Reallocate iint's storage if it's not big enough to hold
-    // (ii_length * II_BITS_PER_II_DIGIT) bits.
-    IONCHECK(_ion_int_extend_digits(iint, ii_length, TRUE));
-
-    temp_magnitude = magnitude;
-    for (digit_idx = iint->_len-1; temp_magnitude; digit_idx--) {
-        iint->_digits[digit_idx] = (II_DIGIT)(temp_magnitude & II_MASK);
-        temp_magnitude >>= II_SHIFT;
-    }
-
-    iint->_signum = is_negative ? -1 : 1;
+    IONCHECK(_ion_int_from_uint64(iint, magnitude, is_negative));
 
     iRETURN;
 }
@@ -834,7 +1282,8 @@ iERR ion_int_to_bytes(ION_INT *iint, SIZE starting_int_byte_offset
     BOOL     is_neg, sign_byte_needed = FALSE;
     ION_INT  neg, *tocopy;
     SIZE   bytes;
-    SIZE   highbit, len;
+    SIZE   highbit, len, digit_count;
+    II_DIGIT inline_digits[II_INLINE_DIGIT_COUNT], *digits;
     SIZE   written = 0;
     int      value8;
     
@@ -859,7 +1308,8 @@ iERR ion_int_to_bytes(ION_INT *iint, SIZE starting_int_byte_offset
         highbit = _ion_int_highest_bit_set_helper(iint);
         len = highbit ? (((highbit - 1) / II_BITS_PER_II_DIGIT) + 1) : 1;
         IONCHECK(_ion_int_extend_digits(&neg, len, TRUE));
-        memcpy(neg._digits, &iint->_digits[iint->_len - len], len * sizeof(II_DIGIT));
+        digits = _ion_int_digits(iint, inline_digits, &digit_count);
+        memcpy(neg._digits, &digits[digit_count - len], len * sizeof(II_DIGIT));
         IONCHECK(_ion_int_sub_digit(neg._digits, neg._len, 1));
         is_neg = TRUE;
         tocopy = &neg;
@@ -986,6 +1436,8 @@ iERR ion_int_to_decimal(ION_INT *iint, decQuad *p_quad, decContext *context)
 {
     iENTER;
     II_DIGIT *digits, *end, digit;
+    II_DIGIT  inline_digits[II_INLINE_DIGIT_COUNT];
+    SIZE      len;
     decQuad   quad_digit;
 
     _ion_int_init_globals();
@@ -993,8 +1445,8 @@ iERR ion_int_to_decimal(ION_INT *iint, decQuad *p_quad, decContext *context)
     IONCHECK(_ion_int_validate_non_null_arg_with_ptr(iint, p_quad));
 
     decQuadZero(p_quad);
-    digits = iint->_digits;
-    end    = digits + iint->_len;
+    digits = _ion_int_digits(iint, inline_digits, &len);
+    end    = digits + len;
 
     while (digits < end) {
         digit = *digits++;
@@ -1014,6 +1466,8 @@ iERR _ion_int_to_decimal_number(ION_INT *iint, decNumber *p_value, decContext *c
 {
     iENTER;
     II_DIGIT *digits, *end, digit;
+    II_DIGIT  inline_digits[II_INLINE_DIGIT_COUNT];
+    SIZE      len;
     decNumber dec_digit;
 
     _ion_int_init_globals();
@@ -1022,8 +1476,8 @@ iERR _ion_int_to_decimal_number(ION_INT *iint, decNumber *p_value, decContext *c
 
     decNumberZero(p_value);
     decNumberZero(&dec_digit);
-    digits = iint->_digits;
-    end    = digits + iint->_len;
+    digits = _ion_int_digits(iint, inline_digits, &len);
+    end    = digits + len;
     while (digits < end) {
         digit = *digits++;
         decNumberFromInt32(&dec_digit, (int32_t)digit);
@@ -1131,8 +1585,7 @@ iERR _ion_int_zero(ION_INT *iint)
 {
     iENTER;
     ASSERT(iint);
-    IONCHECK(_ion_int_extend_digits(iint, 1, TRUE));
-    iint->_signum = 0;
+    IONCHECK(_ion_int_from_uint64(iint, 0, FALSE));
     SUCCEED();
     iRETURN;
 }
@@ -1156,11 +1609,22 @@ void * _ion_int_realloc_helper(void *value, SIZE old_len, void *owner, SIZE new_
 iERR _ion_int_extend_digits(ION_INT *iint, SIZE digits_needed, BOOL zero_fill)
 {
     iENTER;
-    SIZE  len;
-    void   *temp;
+    SIZE      len, ii;
+    void     *temp;
+    BOOL      was_inline;
+    uint64_t  magnitude = 0;
 
     ASSERT(iint);
 
+    // an inline value is about to be written digit by digit, so it needs an array
+    was_inline = II_IS_INLINE(iint);
+    if (was_inline) {
+        magnitude = II_INLINE_MAGNITUDE(iint);
+        iint->_digits = NULL;
+        iint->_len = 0;
+        if (digits_needed < II_INLINE_DIGIT_COUNT) digits_needed = II_INLINE_DIGIT_COUNT;
+    }
+
     if (iint->_len < digits_needed) {
         // realloc
         len = digits_needed * sizeof(II_DIGIT);
@@ -1172,12 +1636,56 @@ iERR _ion_int_extend_digits(ION_INT *iint, SIZE digits_needed, BOOL zero_fill)
     else {
         ASSERT(iint->_digits);
     }
-    if (zero_fill) {
+    if (zero_fill || was_inline) {
         // zero fill the digits
         ASSERT( iint && iint->_digits && (iint->_len > 0) );
         len = sizeof(II_DIGIT) * iint->_len;
         memset(iint->_digits, 0, len);
     }
+    if (was_inline && !zero_fill) {
+        for (ii = iint->_len - 1; magnitude; ii--) {
+            iint->_digits[ii] = (II_DIGIT)(magnitude & II_MASK);
+            magnitude >>= II_SHIFT;
+        }
+    }
+
+    iRETURN;
+}
+
+
+iERR _ion_int_from_uint64(ION_INT *iint, uint64_t magnitude, BOOL is_negative)
+{
+    iENTER;
+    SIZE     ii_length, digit_idx;
+    uint64_t temp_magnitude;
+
+    ASSERT(iint);
+
+    // an int that already has a digit array keeps using it, one that
+    // doesn't stores a small enough value inline rather than allocating
+    if ((iint->_digits == NULL || II_IS_INLINE(iint)) && magnitude <= II_INLINE_MAX) {
+        iint->_digits = (II_DIGIT *)(uintptr_t)magnitude;
+        iint->_len = II_INLINE_LEN;
+    }
+    else {
+        ii_length = 0;
+        temp_magnitude = magnitude;
+        while (temp_magnitude) {
+            temp_magnitude >>= II_SHIFT;
+            ii_length++;
+        }
+        // Reallocate iint's storage if it's not big enough to hold
+        // (ii_length * II_BITS_PER_II_DIGIT) bits.
+        IONCHECK(_ion_int_extend_digits(iint, ii_length ? ii_length : 1, TRUE));
+
+        temp_magnitude = magnitude;
+        for (digit_idx = iint->_len-1; temp_magnitude; digit_idx--) {
+            iint->_digits[digit_idx] = (II_DIGIT)(temp_magnitude & II_MASK);
+            temp_magnitude >>= II_SHIFT;
+        }
+    }
+
+    iint->_signum = (magnitude == 0) ? 0 : (is_negative ? -1 : 1);
 
     iRETURN;
 }
@@ -1208,7 +1716,7 @@ void _ion_int_free_temp(II_DIGIT *temp_buffer, II_DIGIT *cache_buffer)
 BOOL _ion_int_is_null_helper(const ION_INT *iint)
 {
     BOOL is_null;
-    is_null = (iint->_digits == NULL);
+    is_null = (iint->_digits == NULL && !II_IS_INLINE(iint));
     return is_null;
 }
 
@@ -1236,13 +1744,12 @@ SIZE _ion_int_highest_bit_set_helper(const ION_INT *iint)
 {
     iENTER;
     II_DIGIT *digits, msd;
+    II_DIGIT  inline_digits[II_INLINE_DIGIT_COUNT];
     SIZE    ii, len, bits = 0;
 
-    len = iint->_len;
+    if (_ion_int_is_null_helper(iint)) return 0;
+    digits = _ion_int_digits(iint, inline_digits, &len);
     if (len < 1) return 0;
-    ASSERT(iint->_digits);
-
-    digits = iint->_digits;
     for (ii=0; ii<len; ii++) {
        if ((msd = digits[ii]) != 0) break;
     }
@@ -1386,13 +1893,36 @@ SIZE _ion_int_get_char_len_helper(const ION_INT *iint)
 }
 
 
+// divides digits[*p_first..digit_count) by II_STRING_CHUNK_BASE in place and
+// returns the remainder. the divisor is a constant so the compiler can turn
+// the divisions into multiplications, and *p_first is moved past the digits
+// that have become zero so each pass only touches what is left of the value
+static II_DIGIT _ion_int_divide_by_chunk_base(II_DIGIT *digits, SIZE digit_count, SIZE *p_first)
+{
+    II_LONG_DIGIT temp, new_digit, remainder = 0;
+    SIZE          ii, first = *p_first;
+
+    for (ii = first; ii < digit_count; ii++) {
+        temp = ((II_LONG_DIGIT)digits[ii]) | (remainder << II_SHIFT);
+        new_digit = temp / II_STRING_CHUNK_BASE;
+        remainder = temp - (new_digit * II_STRING_CHUNK_BASE);
+        digits[ii] = (II_DIGIT)new_digit;
+    }
+    while (first < digit_count && digits[first] == 0) {
+        first++;
+    }
+    *p_first = first;
+    return (II_DIGIT)remainder;
+}
+
 iERR _ion_int_to_string_helper(ION_INT *iint, char *strbuf, SIZE buflen, SIZE *p_written) 
 {
     iENTER;
     II_DIGIT  small_copy[II_SMALL_DIGIT_ARRAY_LENGTH];
-    II_DIGIT *digits = NULL, remainder;
-    SIZE      decimal_digits, len;
-    char      c, *cp, *end, *head, *tail;
+    II_DIGIT  inline_digits[II_INLINE_DIGIT_COUNT];
+    II_DIGIT *digits = NULL, *source, chunk;
+    SIZE      decimal_digits, len, first;
+    char     *cp, *end;
 
     ASSERT(iint && !_ion_int_is_null_helper(iint));
     ASSERT(strbuf);
@@ -1400,43 +1930,56 @@ iERR _ion_int_to_string_helper(ION_INT *iint, char *strbuf, SIZE buflen, SIZE *p
     decimal_digits = _ion_int_get_char_len_helper(iint);
     ASSERT(buflen >= decimal_digits);
 
-    len = iint->_len;
-    digits = _ion_int_buffer_temp_copy( iint->_digits, len, small_copy, II_SMALL_DIGIT_ARRAY_LENGTH );
+    source = _ion_int_digits(iint, inline_digits, &len);
+    end = strbuf + buflen;
+    cp = end;
+
+    // skip the leading zero digits a reused iint may have
+    while (len > 1 && *source == 0) {
+        source++;
+        len--;
+    }
+    if (len > II_RADIX_THRESHOLD) {
+        IONCHECK(_ion_int_to_long_chars(source, len, &cp));
+        ASSERT(cp >= strbuf);
+        goto sign;
+    }
+
+    digits = _ion_int_buffer_temp_copy( source, len, small_copy, II_SMALL_DIGIT_ARRAY_LENGTH );
     if (digits == NULL) {
         FAILWITH(IERR_NO_MEMORY);
     }
 
-    // calculate the digits from least to most significant
-    for (cp = strbuf, end = cp + buflen; cp < end; cp++) {
-        if (_ion_int_is_zero_bytes(digits, len)) break;
-        IONCHECK(_ion_int_divide_by_digit(digits, len, II_STRING_BASE, &remainder));
-        ASSERT(remainder >= 0 && remainder <= 9);
-        *cp = (BYTE)((remainder & 0xff)+'0');
-    }
-    ASSERT((end <= (cp + buflen)) && _ion_int_is_zero_bytes(digits, len));
-    
-    // zero is an edge case, the loop above never sets a character
-    // as it jumps out at the beginning of the first iteration
-    if (cp == strbuf) {
-        *cp++ = '0';
-    }
-    
+    // calculate the digits from least to most significant, filling the
+    // buffer from the back. each division peels off 9 decimal digits,
+    // which are all zero padded except for the most significant chunk
+    first = 0;
+    do {
+        chunk = _ion_int_divide_by_chunk_base(digits, len, &first);
+        if (first >= len) {
+            cp -= _ion_uint64_digit_count(chunk);
+            ASSERT(cp >= strbuf);
+            _ion_uint64_to_chars(chunk, cp);
+            break;
+        }
+        cp -= II_STRING_CHUNK_DIGITS;
+        ASSERT(cp >= strbuf);
+        _ion_uint32_to_chars_padded(chunk, cp, II_STRING_CHUNK_DIGITS);
+    } while (TRUE);
+
+sign:
     if (iint->_signum < 0) {
-        *cp++ = '-';
+        ASSERT(cp > strbuf);
+        *--cp = '-';
     }
-    *cp = 0;
-    
+
     // now we know the real length (the estimate from the
-    // allocation can be off by 1
-    decimal_digits = (SIZE)(cp - strbuf); // limited by buflen
-    
-    // now we reverse the characters (bytes) in the string
-    // to go from high to low
-    for (head = strbuf, tail = cp-1; head < tail; head++, tail--) {
-        c = *head;
-        *head = *tail;
-        *tail = c;
-    }
+    // allocation can be off by 1), slide the image down
+    // to the start of the callers buffer
+    decimal_digits = (SIZE)(end - cp);
+    ASSERT(decimal_digits < buflen);
+    memmove(strbuf, cp, decimal_digits);
+    strbuf[decimal_digits] = 0;
     
     // and set the callers string to the freshly minted string
     if (p_written) {
@@ -1452,8 +1995,9 @@ fail:
 
 BOOL _ion_int_is_high_bytes_high_bit_set_helper(const ION_INT *iint, SIZE abs_byte_count)
 {
-    SIZE   highbit, digitidx, bitidx;
-    II_DIGIT digit;
+    SIZE   highbit, digitidx, bitidx, len;
+    II_DIGIT digit, *digits;
+    II_DIGIT inline_digits[II_INLINE_DIGIT_COUNT];
     int      highbitvalue;
 
     ASSERT(iint);
@@ -1463,14 +2007,15 @@ BOOL _ion_int_is_high_bytes_high_bit_set_helper(const ION_INT *iint, SIZE abs_by
     // see if it is set of not (if it is we'll need an extra
     // byte for the signed representation)
     highbit = abs_byte_count * 8;
+    digits = _ion_int_digits(iint, inline_digits, &len);
 
     // if the highbit is reified in our digits we need to
     // actually look at it, in some cases the highbit(s)
     // will be off the end of our digit bits (off the left,
     // or most sigificant bit, side) and therefore 0.
-    if (highbit < (iint->_len * (SIZE)II_BITS_PER_II_DIGIT)) {
-        digitidx = iint->_len - (((highbit - 1) / II_BITS_PER_II_DIGIT) + 1); // here digitidx 1 is low order digit
-        digit = iint->_digits[digitidx]; // array element 0 is high order digit, so invert
+    if (highbit < (len * (SIZE)II_BITS_PER_II_DIGIT)) {
+        digitidx = len - (((highbit - 1) / II_BITS_PER_II_DIGIT) + 1); // here digitidx 1 is low order digit
+        digit = digits[digitidx]; // array element 0 is high order digit, so invert
         bitidx = (highbit % II_BITS_PER_II_DIGIT);
         if (bitidx == 0) bitidx = II_BITS_PER_II_DIGIT;
         highbitvalue = (digit >> (bitidx - 1)) & 1;
@@ -1522,12 +2067,14 @@ iERR _ion_int_to_bytes_helper(ION_INT *iint
 {
     iENTER;
     SIZE tocopy, available32, needed8, available_bits;
-    SIZE written = 0;
+    SIZE written = 0, len;
     int    idx32, count32, value32, value8;
+    II_DIGIT *digits, inline_digits[II_INLINE_DIGIT_COUNT];
 
     // see how many bits there are to copy
     // note: we always copy whole bytes worth
-    count32 = (int)iint->_len;
+    digits = _ion_int_digits(iint, inline_digits, &len);
+    count32 = (int)len;
     ASSERT(count32 >= 0);
     if (starting_int_byte_offset >= bytes_in_int) {
         SUCCEED();
@@ -1548,7 +2095,7 @@ iERR _ion_int_to_bytes_helper(ION_INT *iint
 
     // initialize the from and to "buffers", if we don't have enough
     // elements in the digit array the available bits are all zeros
-    value32 = (idx32 >= 0) ? iint->_digits[idx32] : 0;
+    value32 = (idx32 >= 0) ? digits[idx32] : 0;
     value8 = 0;
 
     while (written < buffer_length) {
@@ -1568,7 +2115,7 @@ iERR _ion_int_to_bytes_helper(ION_INT *iint
         if (!available32) {
             idx32++;
             if (idx32 >= count32) break;
-            value32 = iint->_digits[idx32];
+            value32 = digits[idx32];
             available32 = II_BITS_PER_II_DIGIT;
         }
     }
@@ -1618,10 +2165,12 @@ iERR _ion_int_to_int64_helper(ION_INT *iint, int64_t *p_int64)
 {
     iENTER;
     II_DIGIT *digits, *end, digit;
+    II_DIGIT  inline_digits[II_INLINE_DIGIT_COUNT];
+    SIZE      len;
     uint64_t magnitude = 0;
 
-    digits = iint->_digits;
-    end    = digits + iint->_len;
+    digits = _ion_int_digits(iint, inline_digits, &len);
+    end    = digits + len;
 
     // iint's magnitude is stored in an array of 31-bit II_DIGIT values. Magnitudes that
     // require 63 or 64 bits to represent will then take 3 II_DIGITS, only using 1 to 2
@@ -1630,13 +2179,19 @@ iERR _ion_int_to_int64_helper(ION_INT *iint, int64_t *p_int64)
     const uint32_t whole_digits_per_int64_t = 2;
     const uint32_t max_partial_digit_value = 3; // == 0b11, two populated bits
 
+    // A reused iint keeps the longer digit array of an earlier, larger value, so
+    // only the digits after the leading zeros count.
+    while (end - digits > 1 && *digits == 0) {
+        digits++;
+    }
+
     // If iint has more 31-bit digits than could possibly fit in an int64_t, return an error.
-    if (iint->_len > max_digits_per_int64_t) {
+    if (end - digits > max_digits_per_int64_t) {
         FAILWITH(IERR_NUMERIC_OVERFLOW);
     }
 
     // Check whether iint has a partial leading digit.
-    if (iint->_len > whole_digits_per_int64_t) {
+    if (end - digits > whole_digits_per_int64_t) {
         digit = *digits++;
         // If the leading digit uses too many bits to fit in the int64_t, return an error.
         if (digit > max_partial_digit_value) {
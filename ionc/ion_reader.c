@@ -474,6 +474,7 @@ iERR _ion_reader_initialize(ION_READER *preader, BYTE *version_buffer, SIZE vers
 
     // we start our symbol table out with the system symbol table
     preader->_current_symtab = system;
+    preader->_symbol_table_epoch++;
 
     // keep the readers copy of depth up to date
     preader->_depth = 0;
@@ -573,6 +574,336 @@ iERR _ion_reader_next_helper(ION_READER *preader, ION_TYPE *p_value_type)
     iRETURN;
 }
 
+iERR ion_reader_find_field(hREADER hreader, ION_STRING *field_name, ION_TYPE *p_value_type)
+{
+    iENTER;
+    ION_READER *preader;
+    SID         sid;
+
+    if (!hreader) FAILWITH(IERR_INVALID_ARG);
+    preader = HANDLE_TO_PTR(hreader, ION_READER);
+    if (!field_name || ION_STRING_IS_NULL(field_name)) FAILWITH(IERR_INVALID_ARG);
+    if (!p_value_type) FAILWITH(IERR_INVALID_ARG);
+
+    switch(preader->type) {
+    case ion_type_text_reader:
+        IONCHECK(_ion_reader_find_field_helper(preader, field_name, UNKNOWN_SID, p_value_type));
+        break;
+    case ion_type_binary_reader:
+        // text the symbol table doesn't know can't be the name of any field,
+        // which an UNKNOWN_SID search takes care of by running to the end
+        IONCHECK(_ion_symbol_table_find_by_name_helper(preader->_current_symtab, field_name, &sid, NULL, FALSE));
+        IONCHECK(_ion_reader_binary_find_field(preader, sid, p_value_type));
+        break;
+    case ion_type_unknown_reader:
+    default:
+        FAILWITH(IERR_INVALID_STATE);
+    }
+
+    iRETURN;
+}
+
+iERR ion_reader_find_field_sid(hREADER hreader, SID field_sid, ION_TYPE *p_value_type)
+{
+    iENTER;
+    ION_READER *preader;
+    ION_STRING *pname = NULL;
+
+    if (!hreader) FAILWITH(IERR_INVALID_ARG);
+    preader = HANDLE_TO_PTR(hreader, ION_READER);
+    if (field_sid <= UNKNOWN_SID) FAILWITH(IERR_INVALID_ARG);
+    if (!p_value_type) FAILWITH(IERR_INVALID_ARG);
+
+    switch(preader->type) {
+    case ion_type_text_reader:
+        // text field names are matched on their text when the symbol has any
+        if (field_sid > 0) {
+            IONCHECK(_ion_symbol_table_find_by_sid_helper(preader->_current_symtab, field_sid, &pname));
+        }
+        if (pname && ION_STRING_IS_NULL(pname)) pname = NULL;
+        IONCHECK(_ion_reader_find_field_helper(preader, pname, field_sid, p_value_type));
+        break;
+    case ion_type_binary_reader:
+        IONCHECK(_ion_reader_binary_find_field(preader, field_sid, p_value_type));
+        break;
+    case ion_type_unknown_reader:
+    default:
+        FAILWITH(IERR_INVALID_STATE);
+    }
+
+    iRETURN;
+}
+
+iERR ion_reader_index_struct(hREADER hreader)
+{
+    iENTER;
+    ION_READER *preader;
+
+    if (!hreader) FAILWITH(IERR_INVALID_ARG);
+    preader = HANDLE_TO_PTR(hreader, ION_READER);
+
+    if (preader->type != ion_type_binary_reader) FAILWITH(IERR_INVALID_STATE);
+    IONCHECK(_ion_reader_binary_index_struct(preader));
+
+    iRETURN;
+}
+
+iERR ion_reader_seek_field(hREADER hreader, ION_STRING *field_name, ION_TYPE *p_value_type)
+{
+    iENTER;
+    ION_READER *preader;
+    SID         sid;
+
+    if (!hreader) FAILWITH(IERR_INVALID_ARG);
+    preader = HANDLE_TO_PTR(hreader, ION_READER);
+    if (!field_name || ION_STRING_IS_NULL(field_name)) FAILWITH(IERR_INVALID_ARG);
+    if (!p_value_type) FAILWITH(IERR_INVALID_ARG);
+
+    if (preader->type != ion_type_binary_reader) FAILWITH(IERR_INVALID_STATE);
+    IONCHECK(_ion_symbol_table_find_by_name_helper(preader->_current_symtab, field_name, &sid, NULL, FALSE));
+    IONCHECK(_ion_reader_binary_seek_field(preader, sid, p_value_type));
+
+    iRETURN;
+}
+
+iERR ion_reader_seek_field_sid(hREADER hreader, SID field_sid, ION_TYPE *p_value_type)
+{
+    iENTER;
+    ION_READER *preader;
+
+    if (!hreader) FAILWITH(IERR_INVALID_ARG);
+    preader = HANDLE_TO_PTR(hreader, ION_READER);
+    if (field_sid <= UNKNOWN_SID) FAILWITH(IERR_INVALID_ARG);
+    if (!p_value_type) FAILWITH(IERR_INVALID_ARG);
+
+    if (preader->type != ion_type_binary_reader) FAILWITH(IERR_INVALID_STATE);
+    IONCHECK(_ion_reader_binary_seek_field(preader, field_sid, p_value_type));
+
+    iRETURN;
+}
+
+iERR ion_reader_create_layout(hREADER hreader, ION_READER_LAYOUT_FIELD *fields, SIZE field_count, hLAYOUT *p_layout)
+{
+    iENTER;
+    ION_READER        *preader;
+    ION_READER_LAYOUT *layout;
+    SIZE               ii, jj;
+    int32_t            capacity;
+
+    if (!hreader) FAILWITH(IERR_BAD_HANDLE);
+    preader = HANDLE_TO_PTR(hreader, ION_READER);
+    if (field_count < 0) FAILWITH(IERR_INVALID_ARG);
+    if (field_count > 0 && !fields) FAILWITH(IERR_INVALID_ARG);
+    if (!p_layout) FAILWITH(IERR_INVALID_ARG);
+
+    for (ii = 0; ii < field_count; ii++) {
+        if (ION_STRING_IS_NULL(&fields[ii].name) || fields[ii].name.length < 0) FAILWITH(IERR_INVALID_ARG);
+        if (fields[ii].offset < 0) FAILWITH(IERR_INVALID_ARG);
+        switch ((intptr_t)fields[ii].type) {
+        case (intptr_t)tid_BOOL:
+        case (intptr_t)tid_INT:
+        case (intptr_t)tid_FLOAT:
+        case (intptr_t)tid_TIMESTAMP:
+        case (intptr_t)tid_SYMBOL:
+        case (intptr_t)tid_STRING:
+        case (intptr_t)tid_CLOB:
+        case (intptr_t)tid_BLOB:
+            break;
+        case (intptr_t)tid_STRUCT:
+            if (!fields[ii].layout) FAILWITH(IERR_INVALID_ARG);
+            if (HANDLE_TO_PTR(fields[ii].layout, ION_READER_LAYOUT)->_reader != preader) FAILWITH(IERR_INVALID_ARG);
+            break;
+        default:
+            FAILWITH(IERR_INVALID_ARG);
+        }
+        for (jj = 0; jj < ii; jj++) {
+            if (ION_STRING_EQUALS(&fields[ii].name, &fields[jj].name)) FAILWITH(IERR_INVALID_ARG);
+        }
+    }
+
+    // like writer templates, the layout lives as long as the reader does
+    layout = (ION_READER_LAYOUT *)ion_alloc_with_owner(preader, sizeof(ION_READER_LAYOUT));
+    if (!layout) FAILWITH(IERR_NO_MEMORY);
+    layout->_reader = preader;
+    layout->_field_count = field_count;
+    layout->_fields = NULL;
+    layout->_epoch = 0;
+    if (field_count > 0) {
+        layout->_fields = (ION_READER_LAYOUT_FIELD *)ion_alloc_with_owner(preader,
+                                                         field_count * sizeof(ION_READER_LAYOUT_FIELD));
+        if (!layout->_fields) FAILWITH(IERR_NO_MEMORY);
+    }
+    for (ii = 0; ii < field_count; ii++) {
+        layout->_fields[ii] = fields[ii];
+        ION_STRING_INIT(&layout->_fields[ii].name);
+        IONCHECK(ion_string_copy_to_owner(preader, &layout->_fields[ii].name, &fields[ii].name));
+    }
+
+    // at most half full, so the probes stay short
+    capacity = 8;
+    while (capacity < 2 * field_count) capacity *= 2;
+    layout->_slots = (ION_READER_LAYOUT_SLOT *)ion_alloc_with_owner(preader, capacity * sizeof(ION_READER_LAYOUT_SLOT));
+    if (!layout->_slots) FAILWITH(IERR_NO_MEMORY);
+    layout->_slot_mask = capacity - 1;
+
+    *p_layout = PTR_TO_HANDLE(layout);
+
+    iRETURN;
+}
+
+iERR ion_reader_read_struct_into(hREADER hreader, hLAYOUT hlayout, void *dst)
+{
+    iENTER;
+    ION_READER        *preader;
+    ION_READER_LAYOUT *layout;
+
+    if (!hreader) FAILWITH(IERR_BAD_HANDLE);
+    preader = HANDLE_TO_PTR(hreader, ION_READER);
+    if (!hlayout) FAILWITH(IERR_INVALID_ARG);
+    layout = HANDLE_TO_PTR(hlayout, ION_READER_LAYOUT);
+    if (layout->_reader != preader) FAILWITH(IERR_INVALID_ARG);
+    if (!dst) FAILWITH(IERR_INVALID_ARG);
+
+    switch(preader->type) {
+    case ion_type_text_reader:
+        IONCHECK(_ion_reader_read_struct_into_helper(preader, layout, dst));
+        break;
+    case ion_type_binary_reader:
+        IONCHECK(_ion_reader_binary_read_struct_into(preader, layout, dst));
+        break;
+    case ion_type_unknown_reader:
+    default:
+        FAILWITH(IERR_INVALID_STATE);
+    }
+
+    iRETURN;
+}
+
+// the general decode: step in, next() and match each field on its name
+iERR _ion_reader_read_struct_into_helper(ION_READER *preader, ION_READER_LAYOUT *layout, void *dst)
+{
+    iENTER;
+    ION_READER_LAYOUT_FIELD *field;
+    ION_SYMBOL *symbol;
+    ION_STRING  value;
+    ION_TYPE    type;
+    BYTE       *member;
+    BOOL        is_null, stepped_in = FALSE;
+    SIZE        ii, length;
+
+    ASSERT(preader);
+    ASSERT(layout);
+    ASSERT(dst);
+
+    IONCHECK(_ion_reader_get_type_helper(preader, &type));
+    if (type != tid_STRUCT) FAILWITH(IERR_INVALID_STATE);
+    IONCHECK(_ion_reader_is_null_helper(preader, &is_null));
+    if (is_null) SUCCEED();
+
+    IONCHECK(_ion_reader_step_in_helper(preader));
+    stepped_in = TRUE;
+    for (;;) {
+        IONCHECK(_ion_reader_next_helper(preader, &type));
+        if (type == tid_EOF) break;
+        IONCHECK(_ion_reader_get_field_name_symbol_helper(preader, &symbol));
+        if (ION_STRING_IS_NULL(&symbol->value)) continue;
+        field = NULL;
+        for (ii = 0; ii < layout->_field_count; ii++) {
+            if (ION_STRING_EQUALS(&layout->_fields[ii].name, &symbol->value)) {
+                field = &layout->_fields[ii];
+                break;
+            }
+        }
+        if (!field) continue;
+
+        IONCHECK(_ion_reader_is_null_helper(preader, &is_null));
+        if (is_null) continue;
+        if (!ION_READER_LAYOUT_ACCEPTS(field->type, type)) FAILWITH(IERR_INVALID_STATE);
+
+        member = (BYTE *)dst + field->offset;
+        switch ((intptr_t)field->type) {
+        case (intptr_t)tid_BOOL:
+            IONCHECK(_ion_reader_read_bool_helper(preader, (BOOL *)member));
+            break;
+        case (intptr_t)tid_INT:
+            IONCHECK(_ion_reader_read_int64_helper(preader, (int64_t *)member));
+            break;
+        case (intptr_t)tid_FLOAT:
+            IONCHECK(_ion_reader_read_double_helper(preader, (double *)member));
+            break;
+        case (intptr_t)tid_TIMESTAMP:
+            IONCHECK(_ion_reader_read_timestamp_helper(preader, (ION_TIMESTAMP *)member));
+            break;
+        case (intptr_t)tid_SYMBOL:
+        case (intptr_t)tid_STRING:
+            // the text reader's value buffer is reused by the next value
+            ION_STRING_INIT(&value);
+            IONCHECK(_ion_reader_read_string_helper(preader, &value));
+            ION_STRING_INIT((ION_STRING *)member);
+            IONCHECK(ion_string_copy_to_owner(preader->_temp_entity_pool, (ION_STRING *)member, &value));
+            break;
+        case (intptr_t)tid_CLOB:
+        case (intptr_t)tid_BLOB:
+            IONCHECK(_ion_reader_get_lob_size_helper(preader, &length));
+            ION_STRING_INIT(&value);
+            value.value = ion_alloc_with_owner(preader->_temp_entity_pool, length > 0 ? length : 1);
+            if (!value.value) FAILWITH(IERR_NO_MEMORY);
+            IONCHECK(_ion_reader_read_lob_bytes_helper(preader, FALSE, value.value, length, &value.length));
+            ION_STRING_ASSIGN((ION_STRING *)member, &value);
+            break;
+        case (intptr_t)tid_STRUCT:
+            IONCHECK(_ion_reader_read_struct_into_helper(preader, HANDLE_TO_PTR(field->layout, ION_READER_LAYOUT),
+                                                         member));
+            break;
+        default:
+            FAILWITH(IERR_INVALID_STATE);
+        }
+    }
+    SUCCEED();
+
+fail:
+    // on the way out, successful or not, the reader is left on the struct rather than inside it. after a
+    // failure the text reader may still be in front of the field's value, which it can't step out from
+    if (stepped_in) {
+        if (err != IERR_OK) {
+            UPDATEERROR(_ion_reader_next_helper(preader, &type));
+        }
+        UPDATEERROR(_ion_reader_step_out_helper(preader));
+    }
+    RETURN(__location_name__, __line__, __count__++, err);
+}
+
+// the general search: next() and compare, by name when there is one and by sid otherwise
+iERR _ion_reader_find_field_helper(ION_READER *preader, ION_STRING *field_name, SID field_sid, ION_TYPE *p_value_type)
+{
+    iENTER;
+    ION_SYMBOL *symbol;
+    ION_TYPE    type;
+    BOOL        is_in_struct;
+
+    ASSERT(preader);
+    ASSERT(field_name || field_sid > UNKNOWN_SID);
+    ASSERT(p_value_type);
+
+    IONCHECK(ion_reader_is_in_struct(PTR_TO_HANDLE(preader), &is_in_struct));
+    if (!is_in_struct) FAILWITH(IERR_INVALID_STATE);
+
+    for (;;) {
+        IONCHECK(_ion_reader_next_helper(preader, &type));
+        if (type == tid_EOF) break;
+        IONCHECK(_ion_reader_get_field_name_symbol_helper(preader, &symbol));
+        if (field_name) {
+            if (!ION_STRING_IS_NULL(&symbol->value) && ION_STRING_EQUALS(field_name, &symbol->value)) break;
+        }
+        else if (symbol->sid == field_sid && ION_STRING_IS_NULL(&symbol->value)) {
+            break;
+        }
+    }
+    *p_value_type = type;
+
+    iRETURN;
+}
+
 iERR ion_reader_step_in(hREADER hreader)
 {
     iENTER;
@@ -1394,6 +1725,66 @@ iERR _ion_reader_read_double_helper(ION_READER *preader, double *p_value)
     iRETURN;
 }
 
+iERR ion_reader_read_int64_array(hREADER hreader, int64_t *p_values, SIZE max_count, SIZE *p_count)
+{
+    iENTER;
+    ION_READER *preader;
+    ION_TYPE    type;
+    SIZE        count = 0, run;
+
+    if (!hreader) FAILWITH(IERR_INVALID_ARG);
+    preader = HANDLE_TO_PTR(hreader, ION_READER);
+    if (max_count < 0 || (max_count > 0 && !p_values)) FAILWITH(IERR_INVALID_ARG);
+    if (!p_count) FAILWITH(IERR_INVALID_ARG);
+
+    while (count < max_count) {
+        if (preader->type == ion_type_binary_reader) {
+            // as many as can be decoded straight from the buffer, the
+            // rest (and anything unusual) go through next and read
+            IONCHECK(_ion_reader_binary_read_int64_run(preader, p_values + count, max_count - count, &run));
+            count += run;
+            if (count >= max_count) break;
+        }
+        IONCHECK(_ion_reader_next_helper(preader, &type));
+        if (type == tid_EOF) break;
+        IONCHECK(_ion_reader_read_int64_helper(preader, &p_values[count]));
+        count++;
+    }
+
+fail:
+    if (p_count) *p_count = count;
+    RETURN(__location_name__, __line__, __count__++, err);
+}
+
+iERR ion_reader_read_double_array(hREADER hreader, double *p_values, SIZE max_count, SIZE *p_count)
+{
+    iENTER;
+    ION_READER *preader;
+    ION_TYPE    type;
+    SIZE        count = 0, run;
+
+    if (!hreader) FAILWITH(IERR_INVALID_ARG);
+    preader = HANDLE_TO_PTR(hreader, ION_READER);
+    if (max_count < 0 || (max_count > 0 && !p_values)) FAILWITH(IERR_INVALID_ARG);
+    if (!p_count) FAILWITH(IERR_INVALID_ARG);
+
+    while (count < max_count) {
+        if (preader->type == ion_type_binary_reader) {
+            IONCHECK(_ion_reader_binary_read_double_run(preader, p_values + count, max_count - count, &run));
+            count += run;
+            if (count >= max_count) break;
+        }
+        IONCHECK(_ion_reader_next_helper(preader, &type));
+        if (type == tid_EOF) break;
+        IONCHECK(_ion_reader_read_double_helper(preader, &p_values[count]));
+        count++;
+    }
+
+fail:
+    if (p_count) *p_count = count;
+    RETURN(__location_name__, __line__, __count__++, err);
+}
+
 iERR ion_reader_read_decimal(hREADER hreader, decQuad *p_value)
 {
     iENTER;
@@ -1473,6 +1864,42 @@ iERR _ion_reader_read_ion_decimal_helper(ION_READER *preader, ION_DECIMAL *p_val
     iRETURN;
 }
 
+iERR ion_reader_read_decimal_parts(hREADER hreader, int64_t *p_mantissa, int32_t *p_exponent, BOOL *p_fits)
+{
+    iENTER;
+    ION_READER *preader;
+
+    if (!hreader) FAILWITH(IERR_INVALID_ARG);
+    preader = HANDLE_TO_PTR(hreader, ION_READER);
+    if (!p_mantissa || !p_exponent || !p_fits) FAILWITH(IERR_INVALID_ARG);
+
+    IONCHECK(_ion_reader_read_decimal_parts_helper(preader, p_mantissa, p_exponent, p_fits));
+
+    iRETURN;
+}
+
+iERR _ion_reader_read_decimal_parts_helper(ION_READER *preader, int64_t *p_mantissa, int32_t *p_exponent, BOOL *p_fits)
+{
+    iENTER;
+
+    ASSERT(preader);
+    ASSERT(p_mantissa && p_exponent && p_fits);
+
+    switch(preader->type) {
+        case ion_type_text_reader:
+            IONCHECK(_ion_reader_text_read_decimal_parts(preader, p_mantissa, p_exponent, p_fits));
+            break;
+        case ion_type_binary_reader:
+            IONCHECK(_ion_reader_binary_read_decimal_parts(preader, p_mantissa, p_exponent, p_fits));
+            break;
+        case ion_type_unknown_reader:
+        default:
+            FAILWITH(IERR_INVALID_STATE);
+    }
+
+    iRETURN;
+}
+
 iERR ion_reader_read_timestamp(hREADER hreader, iTIMESTAMP p_value)
 {
     iENTER;
@@ -1496,6 +1923,33 @@ iERR ion_reader_read_timestamp(hREADER hreader, iTIMESTAMP p_value)
     iRETURN;
 }
 
+iERR ion_reader_read_timestamp_epoch_nanos(hREADER hreader, int64_t *p_epoch_nanos, int *p_precision, int *p_offset_minutes)
+{
+    iENTER;
+    ION_READER    *preader;
+    ION_TIMESTAMP  timestamp;
+
+    if (!hreader) FAILWITH(IERR_INVALID_ARG);
+    preader = HANDLE_TO_PTR(hreader, ION_READER);
+    if (!p_epoch_nanos || !p_precision || !p_offset_minutes) FAILWITH(IERR_INVALID_ARG);
+
+    switch(preader->type) {
+    case ion_type_text_reader:
+        IONCHECK(_ion_reader_text_read_timestamp(preader, &timestamp));
+        IONCHECK(_ion_timestamp_to_epoch_nanos(&timestamp, &preader->_deccontext, p_epoch_nanos, p_precision,
+                                               p_offset_minutes));
+        break;
+    case ion_type_binary_reader:
+        IONCHECK(_ion_reader_binary_read_timestamp_epoch_nanos(preader, p_epoch_nanos, p_precision, p_offset_minutes));
+        break;
+    case ion_type_unknown_reader:
+    default:
+        FAILWITH(IERR_INVALID_STATE);
+    }
+
+    iRETURN;
+}
+
 iERR _ion_reader_read_timestamp_helper(ION_READER *preader, ION_TIMESTAMP *p_value)
 {
     iENTER;
@@ -1738,6 +2192,44 @@ iERR ion_reader_read_lob_partial_bytes(hREADER hreader, BYTE *p_buf, SIZE buf_ma
     iRETURN;
 }
 
+iERR ion_reader_pin_value_view(hREADER hreader, ION_STRING *p_slices, SIZE max_slices, SIZE *p_slice_count)
+{
+    iENTER;
+    ION_READER *preader;
+
+    if (!hreader) FAILWITH(IERR_INVALID_ARG);
+    preader = HANDLE_TO_PTR(hreader, ION_READER);
+    if (max_slices < 0) FAILWITH(IERR_INVALID_ARG);
+    if (!p_slices && max_slices > 0) FAILWITH(IERR_INVALID_ARG);
+    if (!p_slice_count) FAILWITH(IERR_INVALID_ARG);
+
+    switch(preader->type) {
+    case ion_type_binary_reader:
+        IONCHECK(_ion_reader_binary_pin_value_view(preader, p_slices, max_slices, p_slice_count));
+        break;
+    case ion_type_text_reader:
+    case ion_type_unknown_reader:
+    default:
+        FAILWITH(IERR_INVALID_STATE);
+    }
+
+    iRETURN;
+}
+
+iERR ion_reader_unpin_value_view(hREADER hreader)
+{
+    iENTER;
+    ION_READER *preader;
+
+    if (!hreader) FAILWITH(IERR_INVALID_ARG);
+    preader = HANDLE_TO_PTR(hreader, ION_READER);
+    if (preader->type != ion_type_binary_reader) FAILWITH(IERR_INVALID_STATE);
+
+    IONCHECK(ion_stream_unpin(preader->istream));
+
+    iRETURN;
+}
+
 iERR _ion_reader_read_lob_bytes_helper(ION_READER *preader, BOOL accept_partial, BYTE *p_buf, SIZE buf_max, SIZE *p_length) 
 {
     iENTER;
@@ -1780,6 +2272,11 @@ iERR _ion_reader_close_helper(ION_READER *preader)
 
     ASSERT(preader);
 
+    // a stream the reader doesn't own outlives it, so it mustn't be left pinned
+    if (preader->type == ion_type_binary_reader && preader->istream && !preader->_reader_owns_stream) {
+        UPDATEERROR(_ion_reader_binary_release_directories(preader));
+    }
+
     // Release the stream, then free any memory attached to the reader.
     if (preader->_reader_owns_stream) {
         ion_stream_close(preader->istream);
@@ -1848,6 +2345,7 @@ iERR _ion_reader_reset_local_symbol_table(ION_READER *preader )
     IONCHECK(_ion_reader_free_local_symbol_table(preader));
     IONCHECK(_ion_symbol_table_get_system_symbol_helper(&system, ION_SYSTEM_VERSION));
     preader->_current_symtab = system;
+    preader->_symbol_table_epoch++;
 
     iRETURN;
 }
@@ -1920,6 +2418,7 @@ iERR _ion_reader_process_possible_symbol_table(ION_READER *preader, BOOL *is_sym
         }
         preader->_local_symtab_pool = owner;
         preader->_current_symtab = local;
+        preader->_symbol_table_epoch++;
     }
     return IERR_OK;
 fail:
@@ -2117,6 +2616,8 @@ iERR _ion_reader_set_symbol_table_helper(ION_READER *preader, ION_SYMBOL_TABLE *
     }
 
     preader->_current_symtab = symtab;
+
+    preader->_symbol_table_epoch++;
     SUCCEED();
 
     iRETURN;
@@ -2155,6 +2656,29 @@ iERR ion_reader_get_value_offset(hREADER hreader, POSITION *p_offset)
     iRETURN;
 }
 
+iERR ion_reader_get_value_bytes(hREADER hreader, BYTE **p_start, SIZE *p_length)
+{
+    iENTER;
+    ION_READER *preader;
+
+    if (!hreader) FAILWITH(IERR_INVALID_ARG);
+    preader = HANDLE_TO_PTR(hreader, ION_READER);
+    if (!p_start) FAILWITH(IERR_INVALID_ARG);
+    if (!p_length) FAILWITH(IERR_INVALID_ARG);
+
+    switch(preader->type) {
+    case ion_type_binary_reader:
+        IONCHECK(_ion_reader_binary_get_value_bytes(preader, p_start, p_length));
+        break;
+    case ion_type_text_reader:
+    case ion_type_unknown_reader:
+    default:
+        FAILWITH(IERR_INVALID_STATE);
+    }
+
+    iRETURN;
+}
+
 iERR ion_reader_get_value_position(hREADER hreader, int64_t *p_offset, int32_t *p_line, int32_t *p_col_offset) {
     iENTER;
     ION_READER *preader;
@@ -39,6 +39,7 @@ iERR _ion_reader_binary_open(ION_READER *preader)
 
     _ion_collection_initialize(preader, &binary->_parent_stack, sizeof(BINARY_PARENT_STATE)); // array of BINARY_PARENT_STATE
     _ion_collection_initialize(preader, &binary->_annotation_sids, sizeof(SID)); // array of SID's
+    _ion_collection_initialize(preader, &binary->_field_scan, sizeof(BINARY_FIELD_ENTRY)); // array of BINARY_FIELD_ENTRY
 
     binary->_local_end = ION_STREAM_MAX_LENGTH;
     binary->_state = S_BEFORE_TID;
@@ -64,8 +65,10 @@ iERR _ion_reader_binary_reset(ION_READER *preader, ION_TYPE parent_tid, POSITION
 
     binary = &preader->typed_reader.binary;
 
+    IONCHECK(_ion_reader_binary_release_directories(preader));
     _ion_collection_reset(&binary->_parent_stack); // array of BINARY_PARENT_STATE
     _ion_collection_reset(&binary->_annotation_sids); // array of SID's
+    binary->_annotation_bytes = NULL;
 
     binary->_state = S_BEFORE_TID;
 
@@ -93,6 +96,17 @@ iERR _ion_reader_binary_reset(ION_READER *preader, ION_TYPE parent_tid, POSITION
 }
 
 iERR _ion_reader_binary_next(ION_READER *preader, ION_TYPE *p_value_type)
+{
+    iENTER;
+
+    IONCHECK(_ion_reader_binary_next_helper(preader, UNKNOWN_SID, p_value_type));
+
+    iRETURN;
+}
+
+// moves to the next value, with the field sid already read from the stream
+// when read_field_sid isn't UNKNOWN_SID (see _ion_reader_binary_find_field)
+iERR _ion_reader_binary_next_helper(ION_READER *preader, SID read_field_sid, ION_TYPE *p_value_type)
 {
     iENTER;
     ION_BINARY_READER *binary;
@@ -132,9 +146,14 @@ begin:
     // reset the value fields
     type_desc_byte = -1;
     _ion_collection_reset(&binary->_annotation_sids);
+    binary->_annotation_bytes = NULL;
 
     // read the field sid if we are in a structure
-    if (binary->_in_struct) {
+    if (binary->_in_struct && read_field_sid != UNKNOWN_SID) {
+        binary->_value_field_id = read_field_sid;
+        read_field_sid = UNKNOWN_SID; // padding sends us back around for the next field
+    }
+    else if (binary->_in_struct) {
         IONCHECK(ion_binary_read_var_uint_32(preader->istream, &field_sid));
         binary->_value_field_id = field_sid;
     }
@@ -186,14 +205,24 @@ begin:
             IONCHECK(ion_binary_read_var_uint_32(preader->istream, &annotation_len));
             if (annotation_len < 1) FAILWITH(IERR_INVALID_BINARY);
 
-            // no - we'll just read them now while we're in the neighborhood
-            annotation_end = ion_stream_get_position(preader->istream) + annotation_len;
-            for (;;) {
-                pos = ion_stream_get_position(preader->istream);
-                if (pos >= annotation_end) break;
-                psid = (SID *)_ion_collection_append(&binary->_annotation_sids);
-                if (!psid) FAILWITH(IERR_NO_MEMORY);
-                IONCHECK(ion_binary_read_var_uint_32(preader->istream, (uint32_t*)psid));
+            if (!_ion_stream_is_paged(preader->istream)
+                && annotation_len <= (uint32_t)(preader->istream->_limit - preader->istream->_curr)) {
+                // the whole list is in memory, so just remember where it is and
+                // decode the sids if and when someone asks for the annotations
+                binary->_annotation_bytes = preader->istream->_curr;
+                binary->_annotation_bytes_len = (SIZE)annotation_len;
+                preader->istream->_curr += annotation_len;
+            }
+            else {
+                // a page boundary may fall inside the list, so read them now while we're in the neighborhood
+                annotation_end = ion_stream_get_position(preader->istream) + annotation_len;
+                for (;;) {
+                    pos = ion_stream_get_position(preader->istream);
+                    if (pos >= annotation_end) break;
+                    psid = (SID *)_ion_collection_append(&binary->_annotation_sids);
+                    if (!psid) FAILWITH(IERR_NO_MEMORY);
+                    IONCHECK(ion_binary_read_var_uint_32(preader->istream, (uint32_t*)psid));
+                }
             }
 
             //      read tid again
@@ -256,7 +285,9 @@ begin:
             else if(getTypeCode(binary->_value_tid) == TID_NULL && getLowNibble(binary->_value_tid) != ION_lnIsNull) {
                 // This is NOP padding.
                 if (binary->_value_len) {
-                    if (binary->_value_len > (preader->istream->_limit - preader->istream->_curr)) {
+                    // a paged stream may not have the rest of the pad in memory yet, skipping it checks for the end
+                    if (!_ion_stream_is_paged(preader->istream)
+                        && binary->_value_len > (preader->istream->_limit - preader->istream->_curr)) {
                         FAILWITH(IERR_UNEXPECTED_EOF);
                     }
                     binary->_state = S_BEFORE_CONTENTS; // This forces a skip.
@@ -285,6 +316,362 @@ at_eof:
 }
 
 
+iERR _ion_reader_binary_find_field(ION_READER *preader, SID sid, ION_TYPE *p_value_type)
+{
+    iENTER;
+    ION_BINARY_READER *binary;
+    ION_STREAM        *istream;
+    uint32_t           field_sid;
+    int                td;
+    SIZE               skipped;
+
+    ASSERT(preader && preader->type == ion_type_binary_reader);
+    ASSERT(p_value_type);
+
+    binary = &preader->typed_reader.binary;
+    istream = preader->istream;
+
+    if (!binary->_in_struct) FAILWITH(IERR_INVALID_STATE);
+
+    // hop from field to field on the length prefixes alone, only the
+    // matching field goes through next() to be set up as the current value
+    while (!preader->_eof) {
+        if (binary->_state == S_BEFORE_CONTENTS && binary->_value_len) {
+            IONCHECK(ion_stream_skip(istream, binary->_value_len, &skipped));
+            if (binary->_value_len != skipped) FAILWITH(IERR_UNEXPECTED_EOF);
+        }
+        binary->_state = S_BEFORE_TID;
+        if (ion_stream_get_position(istream) >= binary->_local_end) break;
+
+        IONCHECK(ion_binary_read_var_uint_32(istream, &field_sid));
+        if (sid != UNKNOWN_SID && (SID)field_sid == sid) {
+            IONCHECK(_ion_reader_binary_next_helper(preader, (SID)field_sid, p_value_type));
+            SUCCEED();
+        }
+
+        ION_GET(istream, td);
+        if (td == EOF) FAILWITH(IERR_UNEXPECTED_EOF);
+        IONCHECK(_ion_reader_binary_local_read_length(preader, td, &binary->_value_len));
+        IONCHECK(_ion_binary_reader_fits_container(preader, binary->_value_len));
+        binary->_value_tid = td;
+        binary->_state = S_BEFORE_CONTENTS;
+    }
+
+    // not in this struct, let next() report the end of it
+    IONCHECK(_ion_reader_binary_next(preader, p_value_type));
+
+    iRETURN;
+}
+
+iERR _ion_reader_binary_index_struct(ION_READER *preader)
+{
+    iENTER;
+    ION_BINARY_READER   *binary;
+    ION_STREAM          *istream;
+    BINARY_PARENT_STATE *pparent_state;
+    BINARY_FIELD_ENTRY  *pentry, *directory;
+    ION_COLLECTION_CURSOR cursor;
+    POSITION             start, offset;
+    uint32_t             field_sid;
+    int                  td, len;
+    int32_t              capacity, idx;
+    SIZE                 skipped;
+
+    ASSERT(preader && preader->type == ion_type_binary_reader);
+
+    binary = &preader->typed_reader.binary;
+    istream = preader->istream;
+
+    if (!binary->_in_struct) FAILWITH(IERR_INVALID_STATE);
+    pparent_state = (BINARY_PARENT_STATE *)_ion_collection_head(&binary->_parent_stack);
+    ASSERT(pparent_state);
+    if (pparent_state->_directory) SUCCEED();
+
+    // the scan has to see every field, so it has to start before the first one
+    start = ion_stream_get_position(istream);
+    if (binary->_state != S_BEFORE_TID || start != pparent_state->_start) FAILWITH(IERR_INVALID_STATE);
+
+    // keep the struct in memory so seeking back into it never has to re-read the input
+    IONCHECK(ion_stream_pin(istream, start));
+    pparent_state->_pinned = TRUE;
+
+    _ion_collection_reset(&binary->_field_scan);
+    while (ion_stream_get_position(istream) < binary->_local_end) {
+        IONCHECK(ion_binary_read_var_uint_32(istream, &field_sid));
+        offset = ion_stream_get_position(istream);
+        ION_GET(istream, td);
+        if (td == EOF) FAILWITH(IERR_UNEXPECTED_EOF);
+        IONCHECK(_ion_reader_binary_local_read_length(preader, td, &len));
+        IONCHECK(_ion_binary_reader_fits_container(preader, len));
+        if (getTypeCode(td) != TID_NULL || getLowNibble(td) == ION_lnIsNull) { // padding isn't a field
+            pentry = (BINARY_FIELD_ENTRY *)_ion_collection_append(&binary->_field_scan);
+            if (!pentry) FAILWITH(IERR_NO_MEMORY);
+            pentry->_sid = (SID)field_sid;
+            pentry->_offset = offset;
+        }
+        IONCHECK(ion_stream_skip(istream, len, &skipped));
+        if (skipped != len) FAILWITH(IERR_UNEXPECTED_EOF);
+    }
+
+    // at most half full, so probe runs stay short
+    capacity = 8;
+    while (capacity < 2 * ION_COLLECTION_SIZE(&binary->_field_scan)) {
+        capacity *= 2;
+    }
+    directory = (BINARY_FIELD_ENTRY *)ion_alloc_with_owner(preader->_temp_entity_pool, capacity * sizeof(BINARY_FIELD_ENTRY));
+    if (!directory) FAILWITH(IERR_NO_MEMORY);
+    for (idx = 0; idx < capacity; idx++) {
+        directory[idx]._sid = UNKNOWN_SID;
+    }
+    ION_COLLECTION_OPEN(&binary->_field_scan, cursor);
+    for (;;) {
+        ION_COLLECTION_NEXT(cursor, pentry);
+        if (!pentry) break;
+        // repeated names keep their first field
+        for (idx = pentry->_sid & (capacity - 1); directory[idx]._sid != UNKNOWN_SID; idx = (idx + 1) & (capacity - 1)) {
+            if (directory[idx]._sid == pentry->_sid) break;
+        }
+        if (directory[idx]._sid == UNKNOWN_SID) {
+            directory[idx] = *pentry;
+        }
+    }
+    ION_COLLECTION_CLOSE(cursor);
+    pparent_state->_directory = directory;
+    pparent_state->_directory_mask = capacity - 1;
+
+    IONCHECK(ion_stream_seek(istream, start));
+    binary->_state = S_BEFORE_TID;
+
+    iRETURN;
+}
+
+iERR _ion_reader_binary_seek_field(ION_READER *preader, SID sid, ION_TYPE *p_value_type)
+{
+    iENTER;
+    ION_BINARY_READER   *binary;
+    BINARY_PARENT_STATE *pparent_state;
+    BINARY_FIELD_ENTRY  *directory;
+    POSITION             target;
+    int32_t              idx, mask;
+
+    ASSERT(preader && preader->type == ion_type_binary_reader);
+    ASSERT(p_value_type);
+
+    binary = &preader->typed_reader.binary;
+    if (!binary->_in_struct) FAILWITH(IERR_INVALID_STATE);
+    pparent_state = (BINARY_PARENT_STATE *)_ion_collection_head(&binary->_parent_stack);
+    ASSERT(pparent_state);
+    directory = pparent_state->_directory;
+    if (!directory) FAILWITH(IERR_INVALID_STATE);
+
+    // a missing field leaves the reader at the end of the struct
+    target = pparent_state->_next_position;
+    if (sid > UNKNOWN_SID) {
+        mask = pparent_state->_directory_mask;
+        for (idx = sid & mask; directory[idx]._sid != UNKNOWN_SID; idx = (idx + 1) & mask) {
+            if (directory[idx]._sid == sid) {
+                target = directory[idx]._offset;
+                break;
+            }
+        }
+    }
+
+    IONCHECK(ion_stream_seek(preader->istream, target));
+    binary->_state = S_BEFORE_TID;
+    preader->_eof = FALSE;
+    if (target == pparent_state->_next_position) {
+        IONCHECK(_ion_reader_binary_next(preader, p_value_type));
+    }
+    else {
+        IONCHECK(_ion_reader_binary_next_helper(preader, sid, p_value_type));
+    }
+
+    iRETURN;
+}
+
+// drops the pins of any struct directories still open, for when the parent stack is thrown away
+iERR _ion_reader_binary_release_directories(ION_READER *preader)
+{
+    iENTER;
+    ION_BINARY_READER    *binary;
+    BINARY_PARENT_STATE  *pparent_state;
+    ION_COLLECTION_CURSOR cursor;
+
+    ASSERT(preader && preader->type == ion_type_binary_reader);
+
+    binary = &preader->typed_reader.binary;
+    ION_COLLECTION_OPEN(&binary->_parent_stack, cursor);
+    for (;;) {
+        ION_COLLECTION_NEXT(cursor, pparent_state);
+        if (!pparent_state) break;
+        if (pparent_state->_pinned) {
+            pparent_state->_pinned = FALSE;
+            IONCHECK(ion_stream_unpin(preader->istream));
+        }
+    }
+    ION_COLLECTION_CLOSE(cursor);
+
+    iRETURN;
+}
+
+// adds sid to the layout's slots as the symbol of field, doubling the slots
+// when they would be more than half full
+static iERR _ion_reader_binary_add_layout_slot(ION_READER *preader, ION_READER_LAYOUT *layout, SID sid, int32_t field,
+                                               int32_t *p_used)
+{
+    iENTER;
+    ION_READER_LAYOUT_SLOT *old_slots = layout->_slots;
+    int32_t                 ii, slot, old_mask = layout->_slot_mask;
+
+    if (2 * (*p_used + 1) > layout->_slot_mask + 1) {
+        layout->_slots = (ION_READER_LAYOUT_SLOT *)ion_alloc_with_owner(preader,
+                                                        2 * (old_mask + 1) * sizeof(ION_READER_LAYOUT_SLOT));
+        if (!layout->_slots) {
+            layout->_slots = old_slots;
+            FAILWITH(IERR_NO_MEMORY);
+        }
+        layout->_slot_mask = 2 * (old_mask + 1) - 1;
+        for (ii = 0; ii <= layout->_slot_mask; ii++) {
+            layout->_slots[ii]._sid = UNKNOWN_SID;
+        }
+        *p_used = 0;
+        for (ii = 0; ii <= old_mask; ii++) {
+            if (old_slots[ii]._sid != UNKNOWN_SID) {
+                IONCHECK(_ion_reader_binary_add_layout_slot(preader, layout, old_slots[ii]._sid, old_slots[ii]._field,
+                                                            p_used));
+            }
+        }
+    }
+    slot = sid & layout->_slot_mask;
+    while (layout->_slots[slot]._sid != UNKNOWN_SID) {
+        slot = (slot + 1) & layout->_slot_mask;
+    }
+    layout->_slots[slot]._sid = sid;
+    layout->_slots[slot]._field = field;
+    (*p_used)++;
+
+    iRETURN;
+}
+
+// maps the symbol IDs of the current symbol table to the layout's fields. a
+// table can give the same text more than one sid, so every symbol is looked
+// at rather than just the first sid each name resolves to
+static iERR _ion_reader_binary_fill_layout(ION_READER *preader, ION_READER_LAYOUT *layout)
+{
+    iENTER;
+    ION_STRING *name;
+    int32_t     ii, used = 0;
+    SID         sid, max_id;
+
+    for (ii = 0; ii <= layout->_slot_mask; ii++) {
+        layout->_slots[ii]._sid = UNKNOWN_SID;
+    }
+    IONCHECK(_ion_symbol_table_get_max_sid_helper(preader->_current_symtab, &max_id));
+    for (sid = 1; sid <= max_id; sid++) {
+        IONCHECK(_ion_symbol_table_find_by_sid_helper(preader->_current_symtab, sid, &name));
+        if (!name || ION_STRING_IS_NULL(name)) continue;
+        for (ii = 0; ii < layout->_field_count; ii++) {
+            if (ION_STRING_EQUALS(&layout->_fields[ii].name, name)) {
+                IONCHECK(_ion_reader_binary_add_layout_slot(preader, layout, sid, ii, &used));
+                break;
+            }
+        }
+    }
+    layout->_epoch = preader->_symbol_table_epoch;
+
+    iRETURN;
+}
+
+iERR _ion_reader_binary_read_struct_into(ION_READER *preader, ION_READER_LAYOUT *layout, void *dst)
+{
+    iENTER;
+    ION_BINARY_READER       *binary;
+    ION_READER_LAYOUT_FIELD *field;
+    ION_STRING              *pstr;
+    ION_TYPE                 type;
+    BYTE                    *member;
+    int32_t                  slot;
+    SID                      sid;
+    SIZE                     length;
+    BOOL                     stepped_in = FALSE;
+
+    ASSERT(preader && preader->type == ion_type_binary_reader);
+    ASSERT(layout);
+    ASSERT(dst);
+
+    binary = &preader->typed_reader.binary;
+    if (binary->_value_type != tid_STRUCT) FAILWITH(IERR_INVALID_STATE);
+    if (getLowNibble(binary->_value_tid) == ION_lnIsNull) SUCCEED();
+    if (layout->_epoch != preader->_symbol_table_epoch) {
+        IONCHECK(_ion_reader_binary_fill_layout(preader, layout));
+    }
+
+    IONCHECK(_ion_reader_step_in_helper(preader));
+    stepped_in = TRUE;
+    for (;;) {
+        IONCHECK(_ion_reader_binary_next(preader, &type));
+        if (type == tid_EOF) break;
+
+        sid = binary->_value_field_id;
+        if (sid <= 0) continue;
+        slot = sid & layout->_slot_mask;
+        while (layout->_slots[slot]._sid != sid && layout->_slots[slot]._sid != UNKNOWN_SID) {
+            slot = (slot + 1) & layout->_slot_mask;
+        }
+        if (layout->_slots[slot]._sid == UNKNOWN_SID) continue;
+        field = &layout->_fields[layout->_slots[slot]._field];
+
+        if (getLowNibble(binary->_value_tid) == ION_lnIsNull) continue;
+        if (!ION_READER_LAYOUT_ACCEPTS(field->type, type)) FAILWITH(IERR_INVALID_STATE);
+
+        member = (BYTE *)dst + field->offset;
+        switch ((intptr_t)field->type) {
+        case (intptr_t)tid_BOOL:
+            IONCHECK(_ion_reader_binary_read_bool(preader, (BOOL *)member));
+            break;
+        case (intptr_t)tid_INT:
+            IONCHECK(_ion_reader_binary_read_int64(preader, (int64_t *)member));
+            break;
+        case (intptr_t)tid_FLOAT:
+            IONCHECK(_ion_reader_binary_read_double(preader, (double *)member));
+            break;
+        case (intptr_t)tid_TIMESTAMP:
+            IONCHECK(_ion_reader_binary_read_timestamp(preader, (ION_TIMESTAMP *)member));
+            break;
+        case (intptr_t)tid_SYMBOL:
+        case (intptr_t)tid_STRING:
+            // strings are copied into the temp pool, symbols point at their symbol table text
+            pstr = (ION_STRING *)member;
+            ION_STRING_INIT(pstr);
+            IONCHECK(_ion_reader_binary_read_string(preader, pstr));
+            break;
+        case (intptr_t)tid_CLOB:
+        case (intptr_t)tid_BLOB:
+            pstr = (ION_STRING *)member;
+            IONCHECK(_ion_reader_binary_get_lob_size(preader, &length));
+            ION_STRING_INIT(pstr);
+            pstr->value = ion_alloc_with_owner(preader->_temp_entity_pool, length > 0 ? length : 1);
+            if (!pstr->value) FAILWITH(IERR_NO_MEMORY);
+            IONCHECK(_ion_reader_binary_read_lob_bytes(preader, FALSE, pstr->value, length, &pstr->length));
+            break;
+        case (intptr_t)tid_STRUCT:
+            IONCHECK(_ion_reader_binary_read_struct_into(preader, HANDLE_TO_PTR(field->layout, ION_READER_LAYOUT),
+                                                         member));
+            break;
+        default:
+            FAILWITH(IERR_INVALID_STATE);
+        }
+    }
+    SUCCEED();
+
+fail:
+    // on the way out, successful or not, the reader is left on the struct rather than inside it
+    if (stepped_in) {
+        UPDATEERROR(_ion_reader_step_out_helper(preader));
+    }
+    RETURN(__location_name__, __line__, __count__++, err);
+}
+
 iERR _ion_reader_binary_step_in(ION_READER *preader)
 {
     iENTER;
@@ -330,6 +717,9 @@ iERR _ion_reader_binary_step_in(ION_READER *preader)
     pparent_state->_next_position = next_start;
     pparent_state->_tid           = binary->_parent_tid;
     pparent_state->_local_end     = binary->_local_end;
+    pparent_state->_start         = next_start - binary->_value_len;
+    pparent_state->_directory     = NULL;
+    pparent_state->_pinned        = FALSE;
 
     // now we set up for this collections contents
     binary->_local_end = next_start;
@@ -364,6 +754,10 @@ iERR _ion_reader_binary_step_out(ION_READER *preader)
     binary->_local_end  = pparent_state->_local_end;
     binary->_in_struct  = (binary->_parent_tid == TID_STRUCT);
 
+    if (pparent_state->_pinned) {
+        pparent_state->_pinned = FALSE;
+        IONCHECK(ion_stream_unpin(preader->istream));
+    }
     _ion_collection_pop_head(&binary->_parent_stack);
 
     curr_pos = ion_stream_get_position(preader->istream);
@@ -437,6 +831,36 @@ iERR _ion_reader_binary_get_value_length(ION_READER *preader, SIZE *p_length)
     iRETURN;
 }
 
+iERR _ion_reader_binary_get_value_bytes(ION_READER *preader, BYTE **p_start, SIZE *p_length)
+{
+    iENTER;
+    ION_STREAM *istream;
+    POSITION    offset;
+    SIZE        length;
+
+    ASSERT(preader && preader->type == ion_type_binary_reader);
+    ASSERT(p_start);
+    ASSERT(p_length);
+
+    if (preader->_eof) FAILWITH(IERR_INVALID_STATE);
+    IONCHECK(_ion_reader_binary_get_value_offset(preader, &offset));
+    IONCHECK(_ion_reader_binary_get_value_length(preader, &length));
+
+    // the value (annotations, type descriptor and contents) has to be
+    // sitting in the stream's current buffer, we don't fetch or copy here
+    istream = preader->istream;
+    if (offset < istream->_offset
+     || offset + length > istream->_offset + (istream->_limit - istream->_buffer)
+    ) {
+        FAILWITH(IERR_INVALID_STATE);
+    }
+
+    *p_start = istream->_buffer + (SIZE)(offset - istream->_offset);
+    *p_length = length;
+
+    iRETURN;
+}
+
 iERR _ion_reader_binary_get_value_offset(ION_READER *preader, POSITION *p_offset)
 {
     iENTER;
@@ -508,6 +932,39 @@ iERR _ion_reader_binary_has_any_annotations(ION_READER *preader, BOOL *p_has_any
     iRETURN;
 }
 
+iERR _ion_reader_binary_load_annotations(ION_READER *preader)
+{
+    iENTER;
+    ION_BINARY_READER *binary;
+    BYTE              *p, *limit;
+    uint32_t           value;
+    SID               *psid;
+
+    ASSERT(preader && preader->type == ion_type_binary_reader);
+
+    binary = &preader->typed_reader.binary;
+    p = binary->_annotation_bytes;
+    if (!p) SUCCEED();
+    binary->_annotation_bytes = NULL;
+
+    limit = p + binary->_annotation_bytes_len;
+    while (p < limit) {
+        // the same var_uint decoding as ion_binary_read_var_uint_32, but out of the saved bytes
+        value = 0;
+        for (;;) {
+            if (p >= limit) FAILWITH(IERR_INVALID_BINARY);
+            if (value > (UINT32_MAX >> 7)) FAILWITH(IERR_NUMERIC_OVERFLOW);
+            value = (value << 7) | (*p & 0x7F);
+            if (*p++ & 0x80) break;
+        }
+        psid = (SID *)_ion_collection_append(&binary->_annotation_sids);
+        if (!psid) FAILWITH(IERR_NO_MEMORY);
+        *psid = (SID)value;
+    }
+
+    iRETURN;
+}
+
 iERR _ion_reader_binary_has_annotation(ION_READER *preader, ION_STRING *annotation, BOOL *p_annotation_found)
 {
     iENTER;
@@ -520,6 +977,7 @@ iERR _ion_reader_binary_has_annotation(ION_READER *preader, ION_STRING *annotati
 
     // we load the sid array (since this is binary)
     binary = &preader->typed_reader.binary;
+    IONCHECK(_ion_reader_binary_load_annotations(preader));
 
     // now translate the users string into a local sid (since they gave us a string
     IONCHECK(_ion_symbol_table_find_by_name_helper(preader->_current_symtab, annotation, &user_sid, NULL, FALSE));
@@ -554,6 +1012,7 @@ iERR _ion_reader_binary_get_annotation_count(ION_READER *preader, int32_t *p_cou
     ASSERT(preader && preader->type == ion_type_binary_reader);
 
     binary = &preader->typed_reader.binary;
+    IONCHECK(_ion_reader_binary_load_annotations(preader));
 
     *p_count = ION_COLLECTION_SIZE(&binary->_annotation_sids);
     SUCCEED();
@@ -593,6 +1052,7 @@ iERR _ion_reader_binary_get_an_annotation_sid(ION_READER *preader, int32_t idx,
     ASSERT(p_sid != NULL);
 
     binary = &preader->typed_reader.binary;
+    IONCHECK(_ion_reader_binary_load_annotations(preader));
 
     if (idx >= ION_COLLECTION_SIZE(&binary->_annotation_sids)) 
     {
@@ -691,6 +1151,7 @@ iERR _ion_reader_binary_get_annotations(ION_READER *preader, ION_STRING *p_annot
     ASSERT(p_count != NULL);
 
     binary = &preader->typed_reader.binary;
+    IONCHECK(_ion_reader_binary_load_annotations(preader));
 
     count = ION_COLLECTION_SIZE(&binary->_annotation_sids);
     if (count > max_count) {
@@ -731,6 +1192,7 @@ iERR _ion_reader_binary_get_annotation_symbols(ION_READER *preader, ION_SYMBOL *
     ASSERT(p_count != NULL);
 
     binary = &preader->typed_reader.binary;
+    IONCHECK(_ion_reader_binary_load_annotations(preader));
 
     count = ION_COLLECTION_SIZE(&binary->_annotation_sids);
     if (count > max_count) {
@@ -1151,6 +1613,147 @@ iERR _ion_reader_binary_read_double(ION_READER *preader, double *p_value)
     iRETURN;
 }
 
+// the bytes of the current container that are already in the stream's buffer,
+// or NULL if the reader isn't between the values of a list or sexp
+static BYTE *_ion_reader_binary_buffered_contents(ION_READER *preader, BYTE **p_limit)
+{
+    ION_BINARY_READER *binary = &preader->typed_reader.binary;
+    ION_STREAM        *istream = preader->istream;
+    int64_t            remaining;
+
+    if (binary->_state != S_BEFORE_TID || binary->_in_struct || ION_COLLECTION_IS_EMPTY(&binary->_parent_stack)) {
+        return NULL;
+    }
+    remaining = binary->_local_end - ion_stream_get_position(istream);
+    *p_limit = istream->_limit;
+    if (remaining < *p_limit - istream->_curr) {
+        *p_limit = istream->_curr + remaining;
+    }
+    return istream->_curr;
+}
+
+// reads the length of a value whose length nibble is ln, NULL if the length
+// runs past limit
+static BYTE *_ion_reader_binary_scan_length(BYTE *p, BYTE *limit, int ln, int *p_len)
+{
+    int len = 0, b;
+
+    if (ln != ION_lnIsVarLen) {
+        *p_len = ln;
+        return p;
+    }
+    do {
+        if (p >= limit || len > (INT32_MAX >> 7)) return NULL;
+        b = *p++;
+        len = (len << 7) | (b & 0x7F);
+    } while (!(b & 0x80));
+    *p_len = len;
+    return p;
+}
+
+// leaves the reader on the last value of a run, the way next() and a read
+// of that value would have. the run ends at the stream's current position
+static void _ion_reader_binary_finish_run(ION_READER *preader, BYTE *last, int td, int len)
+{
+    ION_BINARY_READER *binary = &preader->typed_reader.binary;
+
+    _ion_collection_reset(&binary->_annotation_sids);
+    binary->_annotation_bytes = NULL;
+    binary->_annotation_start = -1;
+    binary->_value_field_id   = -1;
+    binary->_value_tid        = td;
+    binary->_value_len        = len;
+    binary->_value_start      = ion_stream_get_position(preader->istream) - (preader->istream->_curr - last);
+    binary->_value_type       = ion_helper_get_iontype_from_tid(getTypeCode(td));
+    binary->_state            = S_BEFORE_TID;
+}
+
+iERR _ion_reader_binary_read_int64_run(ION_READER *preader, int64_t *p_values, SIZE max_count, SIZE *p_count)
+{
+    iENTER;
+    BYTE     *p, *q, *limit, *last = NULL;
+    SIZE      count = 0;
+    int       td, tid, len, ii, last_td = 0, last_len = 0;
+    uint64_t  magnitude;
+
+    ASSERT(preader && preader->type == ion_type_binary_reader);
+
+    p = _ion_reader_binary_buffered_contents(preader, &limit);
+    if (p) {
+        // anything that isn't a plain int that fits is left for
+        // _ion_reader_binary_next and read_int64 to deal with
+        while (count < max_count && p < limit) {
+            td = *p;
+            tid = getTypeCode(td);
+            if ((tid != TID_POS_INT && tid != TID_NEG_INT) || getLowNibble(td) == ION_lnIsNull) break;
+            q = _ion_reader_binary_scan_length(p + 1, limit, getLowNibble(td), &len);
+            if (!q || len > (int)sizeof(int64_t) || limit - q < len) break;
+            magnitude = 0;
+            for (ii = 0; ii < len; ii++) {
+                magnitude = (magnitude << 8) | q[ii];
+            }
+            if (tid == TID_NEG_INT && magnitude == 0) break;
+            if (cast_to_int64(magnitude, (tid == TID_NEG_INT), &p_values[count]) != IERR_OK) break;
+            last = p;
+            last_td = td;
+            last_len = len;
+            p = q + len;
+            count++;
+        }
+        preader->istream->_curr = p;
+        if (count > 0) _ion_reader_binary_finish_run(preader, last, last_td, last_len);
+    }
+    *p_count = count;
+
+    iRETURN;
+}
+
+iERR _ion_reader_binary_read_double_run(ION_READER *preader, double *p_values, SIZE max_count, SIZE *p_count)
+{
+    iENTER;
+    BYTE     *p, *limit, *last = NULL;
+    SIZE      count = 0;
+    int       td, len, ii;
+    uint64_t  bits;
+    uint32_t  bits_32;
+    float     value_32;
+
+    ASSERT(preader && preader->type == ion_type_binary_reader);
+
+    p = _ion_reader_binary_buffered_contents(preader, &limit);
+    if (p) {
+        while (count < max_count && p < limit) {
+            td = *p;
+            len = getLowNibble(td);
+            if (getTypeCode(td) != TID_FLOAT || (len != 0 && len != 4 && len != 8)) break;
+            if (limit - p <= len) break;
+            bits = 0;
+            for (ii = 1; ii <= len; ii++) {
+                bits = (bits << 8) | p[ii];
+            }
+            if (len == 0) {
+                p_values[count] = 0;
+            }
+            else if (len == 4) {
+                bits_32 = (uint32_t)bits;
+                memcpy(&value_32, &bits_32, sizeof(value_32));
+                p_values[count] = value_32;
+            }
+            else {
+                memcpy(&p_values[count], &bits, sizeof(bits));
+            }
+            last = p;
+            p += 1 + len;
+            count++;
+        }
+        preader->istream->_curr = p;
+        if (count > 0) _ion_reader_binary_finish_run(preader, last, *last, getLowNibble(*last));
+    }
+    *p_count = count;
+
+    iRETURN;
+}
+
 iERR _ion_reader_binary_read_decimal(ION_READER *preader, decQuad *p_quad, decNumber **p_num)
 {
     iENTER;
@@ -1184,6 +1787,56 @@ iERR _ion_reader_binary_read_decimal(ION_READER *preader, decQuad *p_quad, decNu
     iRETURN;
 }
 
+iERR _ion_reader_binary_read_decimal_parts(ION_READER *preader, int64_t *p_mantissa, int32_t *p_exponent, BOOL *p_fits)
+{
+    iENTER;
+    ION_BINARY_READER *binary;
+    ION_STREAM        *istream;
+    decQuad            quad;
+    decNumber         *num = NULL;
+    BOOL               decoded = FALSE;
+    int                tid;
+
+    ASSERT(preader && preader->type == ion_type_binary_reader);
+
+    binary = &preader->typed_reader.binary;
+    istream = preader->istream;
+
+    if (binary->_state != S_BEFORE_CONTENTS) {
+        FAILWITH(IERR_INVALID_STATE);
+    }
+
+    tid = getTypeCode(binary->_value_tid);
+    if (tid != TID_DECIMAL) {
+        FAILWITH(IERR_INVALID_STATE);
+    }
+
+    if (getLowNibble(binary->_value_tid) == ION_lnIsNull) {
+        FAILWITH(IERR_NULL_VALUE);
+    }
+
+    IONCHECK(_ion_binary_reader_fits_container(preader, binary->_value_len));
+
+    // decode straight from the buffer when the whole value is there, and
+    // through a decQuad otherwise
+    if (istream->_limit - istream->_curr >= binary->_value_len) {
+        IONCHECK(_ion_binary_decode_decimal_parts(istream->_curr, binary->_value_len, p_mantissa, p_exponent, p_fits,
+                                                  &decoded));
+        if (decoded) {
+            istream->_curr += binary->_value_len;
+        }
+    }
+    if (!decoded) {
+        IONCHECK(ion_binary_read_decimal(istream, binary->_value_len, &preader->_deccontext, &quad, &num));
+        // a decNumber means more digits than a decQuad holds, far more than an int64_t does
+        *p_fits = (num == NULL) && decQuadToInt64Parts(&quad, p_mantissa, p_exponent);
+    }
+
+    binary->_state = S_BEFORE_TID; // now we (should be) just in front of the next value
+
+    iRETURN;
+}
+
 iERR _ion_reader_binary_read_timestamp(ION_READER *preader, iTIMESTAMP p_value)
 {
     iENTER;
@@ -1220,6 +1873,55 @@ iERR _ion_reader_binary_read_timestamp(ION_READER *preader, iTIMESTAMP p_value)
     iRETURN;
 }
 
+iERR _ion_reader_binary_read_timestamp_epoch_nanos(ION_READER *preader, int64_t *p_epoch_nanos, int *p_precision, int *p_offset_minutes)
+{
+    iENTER;
+    ION_BINARY_READER *binary;
+    ION_STREAM        *istream;
+    ION_TIMESTAMP      ti;
+    BOOL               decoded = FALSE;
+    int                tid;
+
+    ASSERT(preader && preader->type == ion_type_binary_reader);
+
+    binary = &preader->typed_reader.binary;
+    istream = preader->istream;
+
+    if (binary->_state != S_BEFORE_CONTENTS) {
+        FAILWITH(IERR_INVALID_STATE);
+    }
+
+    tid = getTypeCode(binary->_value_tid);
+    if (tid != TID_TIMESTAMP) {
+        FAILWITH(IERR_INVALID_STATE);
+    }
+
+    if (getLowNibble(binary->_value_tid) == ION_lnIsNull) {
+        FAILWITH(IERR_NULL_VALUE);
+    }
+
+    IONCHECK(_ion_binary_reader_fits_container(preader, binary->_value_len));
+
+    // decode straight from the buffer when the whole value is there, and
+    // through an ION_TIMESTAMP (and its decQuad fraction) otherwise
+    if (istream->_limit - istream->_curr >= binary->_value_len) {
+        IONCHECK(_ion_timestamp_binary_decode_epoch_nanos(istream->_curr, binary->_value_len, p_epoch_nanos,
+                                                          p_precision, p_offset_minutes, &decoded));
+        if (decoded) {
+            istream->_curr += binary->_value_len;
+        }
+    }
+    if (!decoded) {
+        IONCHECK(ion_binary_read_timestamp(istream, binary->_value_len, &preader->_deccontext, &ti));
+        IONCHECK(_ion_timestamp_to_epoch_nanos(&ti, &preader->_deccontext, p_epoch_nanos, p_precision,
+                                               p_offset_minutes));
+    }
+
+    binary->_state = S_BEFORE_TID; // now we (should be) just in front of the next value
+
+    iRETURN;
+}
+
 iERR _ion_reader_binary_read_symbol_sid_helper(ION_READER *preader, ION_BINARY_READER *binary, SID *p_value)
 {
     iENTER;
@@ -1615,6 +2317,109 @@ iERR _ion_reader_binary_read_lob_bytes(ION_READER *preader, BOOL accept_partial,
     iRETURN;
 }
 
+// hands out the next length bytes of the stream as runs of the pages they are
+// on, which the caller must have pinned, running the stream past them
+static iERR _ion_reader_binary_collect_view(ION_STREAM *istream, SIZE length, ION_STRING *p_slices, SIZE max_slices, SIZE *p_slice_count)
+{
+    iENTER;
+    SIZE        available, count = 0;
+    ION_STRING *last = NULL;
+
+    while (length > 0) {
+        available = (SIZE)(istream->_limit - istream->_curr);
+        if (available < 1) {
+            err = _ion_stream_fetch_position(istream, ion_stream_get_position(istream));
+            if (err == IERR_EOF) FAILWITH(IERR_UNEXPECTED_EOF);
+            IONCHECK(err);
+            available = (SIZE)(istream->_limit - istream->_curr);
+            if (available < 1) FAILWITH(IERR_UNEXPECTED_EOF);
+        }
+        if (available > length) {
+            available = length;
+        }
+        if (last && last->value + last->length == istream->_curr) {
+            // the page was filled further rather than replaced
+            last->length += available;
+        }
+        else {
+            if (count >= max_slices) FAILWITH(IERR_INTERNAL_ERROR);
+            last = &p_slices[count++];
+            last->value = istream->_curr;
+            last->length = available;
+        }
+        istream->_curr += available;
+        length -= available;
+    }
+    *p_slice_count = count;
+
+    iRETURN;
+}
+
+iERR _ion_reader_binary_pin_value_view(ION_READER *preader, ION_STRING *p_slices, SIZE max_slices, SIZE *p_slice_count)
+{
+    iENTER;
+    ION_BINARY_READER *binary;
+    ION_STREAM        *istream;
+    POSITION           start;
+    SIZE               length, count, expected_utf8 = 0;
+    int                tid, ii;
+
+    ASSERT(preader && preader->type == ion_type_binary_reader);
+    ASSERT(p_slice_count != NULL);
+
+    binary = &preader->typed_reader.binary;
+    istream = preader->istream;
+
+    if (binary->_state != S_BEFORE_CONTENTS) {
+        FAILWITH(IERR_INVALID_STATE);
+    }
+    tid = getTypeCode(binary->_value_tid);
+    if (tid != TID_STRING && tid != TID_CLOB && tid != TID_BLOB) {
+        FAILWITH(IERR_INVALID_STATE);
+    }
+    if (getLowNibble(binary->_value_tid) == ION_lnIsNull) {
+        FAILWITH(IERR_NULL_VALUE);
+    }
+
+    length = binary->_value_len;
+    IONCHECK(_ion_binary_reader_fits_container(preader, length));
+
+    // a run can only be broken where a page ends
+    start = ion_stream_get_position(istream);
+    count = 0;
+    if (length > 0) {
+        count = 1;
+        if (_ion_stream_is_paged(istream)) {
+            count += _ion_stream_page_id_from_offset(istream, start + length - 1)
+                   - _ion_stream_page_id_from_offset(istream, start);
+        }
+    }
+    if (count > max_slices) {
+        *p_slice_count = count;
+        FAILWITH(IERR_BUFFER_TOO_SMALL);
+    }
+
+    IONCHECK(ion_stream_pin(istream, start));
+    err = _ion_reader_binary_collect_view(istream, length, p_slices, max_slices, &count);
+    if (err == IERR_OK && tid == TID_STRING && !preader->options.skip_character_validation) {
+        for (ii = 0; err == IERR_OK && ii < count; ii++) {
+            err = _ion_reader_binary_validate_utf8(p_slices[ii].value, p_slices[ii].length, expected_utf8, &expected_utf8);
+        }
+        if (err == IERR_OK && expected_utf8 > 0) {
+            err = IERR_INVALID_UTF8;
+        }
+    }
+    if (err != IERR_OK) {
+        ion_stream_unpin(istream);
+        FAILWITH(err);
+    }
+
+    binary->_state = S_BEFORE_TID; // now we (should be) just in front of the next value
+    *p_slice_count = count;
+
+    iRETURN;
+}
+
 // these are local routines that shouldn't need to be called
 // from anywhere else - they are declared at the top of this file
 
@@ -125,11 +125,25 @@ typedef enum _ion_reader_binary_state
     S_BEFORE_CONTENTS  =  3
 } BINARY_STATE;
 
+// a slot of a struct's field directory, an open addressed table keyed by sid
+typedef struct _ion_reader_binary_field_entry
+{
+    SID      _sid;      // UNKNOWN_SID for an empty slot
+    POSITION _offset;   // position of the field value's type descriptor
+} BINARY_FIELD_ENTRY;
+
 typedef struct _ion_reader_binary_parent_state
 {
     int64_t _next_position;
     int     _tid;
     int64_t _local_end;
+    int64_t _start;                 // position of the container's first child
+
+    // set by ion_reader_index_struct, the directory lives in the temp pool
+    // and the struct's pages stay pinned until we step back out
+    BINARY_FIELD_ENTRY *_directory;
+    int32_t             _directory_mask;
+    BOOL                _pinned;
 } BINARY_PARENT_STATE;
 
 typedef struct _ion_reader_binary
@@ -148,10 +162,14 @@ typedef struct _ion_reader_binary
     int32_t         _value_len;
 
     ION_COLLECTION _annotation_sids; // ~ 6 ints array of ION_STRING+
+    BYTE           *_annotation_bytes;     // encoded annotation sids not yet decoded into _annotation_sids, or NULL
+    SIZE            _annotation_bytes_len;
 
     // local stack for stepInto() and stepOut()
     ION_COLLECTION _parent_stack;
 
+    ION_COLLECTION _field_scan; // array of BINARY_FIELD_ENTRY, scratch space for ion_reader_index_struct
+
 } ION_BINARY_READER;
 
 #define BINARY(preader) (&((preader)->typed_reader.binary))
@@ -177,6 +195,7 @@ struct _ion_reader
     BOOL                _return_system_values;
 
     ION_SYMBOL_TABLE   *_current_symtab;
+    uint32_t            _symbol_table_epoch;        // changes whenever _current_symtab is replaced, see ION_READER_LAYOUT
     ION_SYMBOL_TABLE   *_local_symtab_pool;         // memory pool for local symbol table we recycle
     void               *_temp_entity_pool;          // memory pool for top level objects that we'll throw away
 
@@ -194,6 +213,33 @@ struct _ion_reader
     } typed_reader;
 };
 
+// a slot of a layout's field table, an open addressed table keyed by sid
+typedef struct _ion_reader_layout_slot
+{
+    SID      _sid;      // UNKNOWN_SID for an empty slot
+    int32_t  _field;    // index into the layout's fields
+} ION_READER_LAYOUT_SLOT;
+
+// a struct layout created by ion_reader_create_layout, owned by the reader.
+// the slots are only good for the symbol table epoch they were filled in
+typedef struct _ion_reader_layout
+{
+    ION_READER  *_reader;
+    SIZE         _field_count;
+    ION_READER_LAYOUT_FIELD *_fields;   // names owned by the reader
+    ION_READER_LAYOUT_SLOT  *_slots;
+    int32_t      _slot_mask;
+    uint32_t     _epoch;                // 0 until the slots are first filled
+
+} ION_READER_LAYOUT;
+
+// whether a value of value_type can be stored in a layout field of layout_type:
+// strings and symbols both go into ION_STRINGs, as do both kinds of lob
+#define ION_READER_LAYOUT_ACCEPTS(layout_type, value_type) \
+    ((layout_type) == (value_type) \
+  || (((layout_type) == tid_STRING || (layout_type) == tid_SYMBOL) && ((value_type) == tid_STRING || (value_type) == tid_SYMBOL)) \
+  || (((layout_type) == tid_CLOB || (layout_type) == tid_BLOB) && ((value_type) == tid_CLOB || (value_type) == tid_BLOB)))
+
 //
 // shared internal reader routines
 //
@@ -210,6 +256,8 @@ iERR _ion_reader_get_catalog_helper(ION_READER *preader, ION_CATALOG **p_pcatalo
 iERR _ion_reader_get_symbol_table_helper(ION_READER *preader, ION_SYMBOL_TABLE **p_psymtab);
 iERR _ion_reader_set_symbol_table_helper(ION_READER *preader, ION_SYMBOL_TABLE *symtab);
 iERR _ion_reader_next_helper(ION_READER *preader, ION_TYPE *p_value_type);
+iERR _ion_reader_find_field_helper(ION_READER *preader, ION_STRING *field_name, SID field_sid, ION_TYPE *p_value_type);
+iERR _ion_reader_read_struct_into_helper(ION_READER *preader, ION_READER_LAYOUT *layout, void *dst);
 iERR _ion_reader_step_in_helper(ION_READER *preader);
 iERR _ion_reader_step_out_helper(ION_READER *preader);
 iERR _ion_reader_get_depth_helper(ION_READER *preader, SIZE *p_depth);
@@ -235,6 +283,7 @@ iERR _ion_reader_read_mixed_int_helper(ION_READER *preader);
 iERR _ion_reader_read_double_helper(ION_READER *preader, double *p_value);
 iERR _ion_reader_read_decimal_helper(ION_READER *preader, decQuad *p_value);
 iERR _ion_reader_read_ion_decimal_helper(ION_READER *preader, ION_DECIMAL *p_value);
+iERR _ion_reader_read_decimal_parts_helper(ION_READER *preader, int64_t *p_mantissa, int32_t *p_exponent, BOOL *p_fits);
 iERR _ion_reader_read_timestamp_helper(ION_READER *preader, ION_TIMESTAMP *p_value);
 iERR _ion_reader_read_symbol_helper(ION_READER *preader, ION_SYMBOL *p_symbol);
 
@@ -275,15 +324,23 @@ iERR _ion_reader_binary_open                (ION_READER *preader);
 iERR _ion_reader_binary_reset               (ION_READER *preader, ION_TYPE parent_tid, POSITION value_start, POSITION local_end);
 
 iERR _ion_reader_binary_next                (ION_READER *preader, ION_TYPE *p_value_type);
+iERR _ion_reader_binary_next_helper         (ION_READER *preader, SID read_field_sid, ION_TYPE *p_value_type);
+iERR _ion_reader_binary_find_field          (ION_READER *preader, SID sid, ION_TYPE *p_value_type);
+iERR _ion_reader_binary_index_struct        (ION_READER *preader);
+iERR _ion_reader_binary_seek_field          (ION_READER *preader, SID sid, ION_TYPE *p_value_type);
+iERR _ion_reader_binary_release_directories (ION_READER *preader);
+iERR _ion_reader_binary_read_struct_into    (ION_READER *preader, ION_READER_LAYOUT *layout, void *dst);
 iERR _ion_reader_binary_get_local_symbol_table_helper(ION_READER *preader, ION_SYMBOL_TABLE **pplocal );
 iERR _ion_reader_binary_step_in             (ION_READER *preader);
 iERR _ion_reader_binary_step_out            (ION_READER *preader);
 iERR _ion_reader_binary_get_depth           (ION_READER *preader, SIZE *p_depth);
 iERR _ion_reader_binary_get_value_length    (ION_READER *preader, SIZE *p_length);
 iERR _ion_reader_binary_get_value_offset    (ION_READER *preader, POSITION *p_offset);
+iERR _ion_reader_binary_get_value_bytes     (ION_READER *preader, BYTE **p_start, SIZE *p_length);
 
 iERR _ion_reader_binary_get_type            (ION_READER *preader, ION_TYPE *p_value_type);
 iERR _ion_reader_binary_has_any_annotations (ION_READER *preader, BOOL *p_has_any_annotations);
+iERR _ion_reader_binary_load_annotations    (ION_READER *preader);
 iERR _ion_reader_binary_has_annotation      (ION_READER *preader, iSTRING annotation, BOOL *p_annotation_found);
 iERR _ion_reader_binary_get_annotation_count(ION_READER *preader, int32_t *p_count);
 iERR _ion_reader_binary_get_an_annotation   (ION_READER *preader, int32_t idx, ION_STRING *p_str);
@@ -303,8 +360,12 @@ iERR _ion_reader_binary_read_int32          (ION_READER *preader, int32_t *p_val
 iERR _ion_reader_binary_read_int64          (ION_READER *preader, int64_t *p_value);
 iERR _ion_reader_binary_read_ion_int        (ION_READER *preader, ION_INT *p_value);
 iERR _ion_reader_binary_read_double         (ION_READER *preader, double *p_value);
+iERR _ion_reader_binary_read_int64_run      (ION_READER *preader, int64_t *p_values, SIZE max_count, SIZE *p_count);
+iERR _ion_reader_binary_read_double_run     (ION_READER *preader, double *p_values, SIZE max_count, SIZE *p_count);
 iERR _ion_reader_binary_read_decimal        (ION_READER *preader, decQuad *p_value, decNumber **p_num);
+iERR _ion_reader_binary_read_decimal_parts  (ION_READER *preader, int64_t *p_mantissa, int32_t *p_exponent, BOOL *p_fits);
 iERR _ion_reader_binary_read_timestamp      (ION_READER *preader, iTIMESTAMP p_value);
+iERR _ion_reader_binary_read_timestamp_epoch_nanos(ION_READER *preader, int64_t *p_epoch_nanos, int *p_precision, int *p_offset_minutes);
 iERR _ion_reader_binary_read_symbol_sid     (ION_READER *preader, SID *p_value);
 iERR _ion_reader_binary_read_symbol_sid_helper(ION_READER *preader, ION_BINARY_READER *binary, SID *p_value);
 iERR _ion_reader_binary_read_symbol         (ION_READER *preader, ION_SYMBOL *p_symbol);
@@ -315,6 +376,7 @@ iERR _ion_reader_binary_read_string         (ION_READER *preader, ION_STRING *ps
 
 iERR _ion_reader_binary_get_lob_size        (ION_READER *preader, SIZE *p_length);
 iERR _ion_reader_binary_read_lob_bytes      (ION_READER *preader, BOOL accept_partial, BYTE *p_buf, SIZE buf_max, SIZE *p_length);
+iERR _ion_reader_binary_pin_value_view      (ION_READER *preader, ION_STRING *p_slices, SIZE max_slices, SIZE *p_slice_count);
 
 iERR _ion_reader_binary_validate_utf8       (BYTE *buf, SIZE len, SIZE expected_remaining, SIZE *p_expected_remaining);
 
@@ -49,6 +49,7 @@ double _ION_FLOAT64_NAN() {
 #define IST_RECORD( NAME, TTT, STATE, FLAGS ) ION_SUB_TYPE NAME = & g_##NAME ;
 #include "ion_sub_type_records.h"
 #include "ion_decimal_impl.h"
+#include "ion_float_impl.h"
 
 /**
  *        open the reader, allocate supporting buffers for fieldname, annotations,
@@ -1125,6 +1126,7 @@ iERR _ion_reader_text_get_symbol_table(ION_READER *preader, ION_SYMBOL_TABLE **p
     if (preader->_current_symtab == NULL) {
         IONCHECK(_ion_symbol_table_get_system_symbol_helper(&system, ION_SYSTEM_VERSION));
         preader->_current_symtab = system;
+        preader->_symbol_table_epoch++;
     }
     *p_return = preader->_current_symtab;
 
@@ -1337,6 +1339,20 @@ iERR _ion_reader_text_read_bool(ION_READER *preader, BOOL *p_value)
     iRETURN;
 }
 
+static BOOL _ion_reader_text_value_is_small_int(ION_TEXT_READER *text)
+{
+    return text->_scanner._number_is_small
+        && (text->_value_sub_type == IST_INT_POS_DECIMAL || text->_value_sub_type == IST_INT_NEG_DECIMAL);
+}
+
+static BOOL _ion_reader_text_value_is_small_decimal(ION_TEXT_READER *text)
+{
+    return text->_scanner._number_is_small
+        && (text->_value_sub_type == IST_DECIMAL || text->_value_sub_type == IST_DECIMAL_D)
+        && text->_scanner._number_exponent >= DECQUAD_EXP_MIN
+        && text->_scanner._number_exponent <= DECQUAD_EXP_MAX;
+}
+
 iERR _ion_reader_text_read_mixed_int_helper(ION_READER *preader)
 {
     iENTER;
@@ -1457,7 +1473,11 @@ iERR _ion_reader_text_read_int64(ION_READER *preader, int64_t *p_value)
     value_start = text->_scanner._value_image.value; // if this is hexadecimal, we may need to skip past the "0x"
 
     // convert only the magnitude
-    if (text->_value_sub_type == IST_INT_POS_DECIMAL) {
+    if (_ion_reader_text_value_is_small_int(text)) {
+        // the scanner already accumulated it
+        magnitude = text->_scanner._number_magnitude;
+    }
+    else if (text->_value_sub_type == IST_INT_POS_DECIMAL) {
         magnitude = STR_TO_UINT64(value_start, &value_end, 10);
     }
     else if (text->_value_sub_type == IST_INT_NEG_DECIMAL) {
@@ -1504,6 +1524,7 @@ iERR _ion_reader_text_read_ion_int_helper(ION_READER *preader, ION_INT *p_value)
 {
     iENTER;
     ION_TEXT_READER *text = &preader->typed_reader.text;
+    int64_t          magnitude;
 
     ASSERT(preader);
     ASSERT(p_value);
@@ -1519,7 +1540,11 @@ iERR _ion_reader_text_read_ion_int_helper(ION_READER *preader, ION_INT *p_value)
     }
  
     // choose the right ion_int conversion routine
-    if (text->_value_sub_type == IST_INT_POS_DECIMAL || text->_value_sub_type == IST_INT_NEG_DECIMAL) {
+    if (_ion_reader_text_value_is_small_int(text)) {
+        magnitude = (int64_t)text->_scanner._number_magnitude;
+        IONCHECK(ion_int_from_long(p_value, (text->_value_sub_type == IST_INT_NEG_DECIMAL) ? -magnitude : magnitude));
+    }
+    else if (text->_value_sub_type == IST_INT_POS_DECIMAL || text->_value_sub_type == IST_INT_NEG_DECIMAL) {
         IONCHECK(ion_int_from_string(p_value, &text->_scanner._value_image));
     }
     else if (text->_value_sub_type == IST_INT_POS_HEX || text->_value_sub_type == IST_INT_NEG_HEX) {
@@ -1557,8 +1582,7 @@ iERR _ion_reader_text_read_double(ION_READER *preader, double *p_value)
     if (text->_value_sub_type == IST_FLOAT_64) {
         ASSERT(text->_scanner._value_location == SVL_VALUE_IMAGE);
         ASSERT(text->_scanner._value_image.length > 0);
-        ASSERT(text->_scanner._value_image.value[text->_scanner._value_image.length] == 0);
-        double_value = atof(text->_scanner._value_image.value);
+        IONCHECK(_ion_float_parse_double((char *)text->_scanner._value_image.value, text->_scanner._value_image.length, &double_value));
     }
     else if (text->_value_sub_type == IST_PLUS_INF) {
         double_value = ION_FLOAT64_POS_INF;
@@ -1599,12 +1623,57 @@ iERR _ion_reader_text_read_decimal(ION_READER *preader, decQuad *p_quad, decNumb
     ASSERT(text->_scanner._value_image.length > 0);
     ASSERT(text->_scanner._value_image.value[text->_scanner._value_image.length] == 0);
 
+    if (_ion_reader_text_value_is_small_decimal(text)) {
+        // the scanner already accumulated the coefficient and exponent, which fit a decQuad exactly
+        decQuadFromUInt64(p_quad, text->_scanner._number_magnitude, text->_scanner._number_exponent,
+                          text->_scanner._value_image.value[0] == '-');
+        SUCCEED();
+    }
     IONCHECK(_ion_decimal_from_string_helper((char *)text->_scanner._value_image.value, &preader->_deccontext,
                                              preader, p_quad, p_num));
 
     iRETURN;
 }
 
+iERR _ion_reader_text_read_decimal_parts(ION_READER *preader, int64_t *p_mantissa, int32_t *p_exponent, BOOL *p_fits)
+{
+    iENTER;
+    ION_TEXT_READER *text = &preader->typed_reader.text;
+    decQuad          quad;
+    decNumber       *num = NULL;
+    BOOL             is_negative;
+
+    ASSERT(preader);
+    ASSERT(p_mantissa && p_exponent && p_fits);
+
+    if (text->_state == IPS_ERROR
+     || text->_state == IPS_NONE
+     || text->_value_sub_type->base_type != tid_DECIMAL
+    ) {
+        FAILWITH(IERR_INVALID_STATE);
+    }
+    if ((text->_value_sub_type->flags & FCF_IS_NULL) != 0) {
+        FAILWITH(IERR_NULL_VALUE);
+    }
+
+    if (text->_scanner._number_is_small) {
+        // at most 18 digits, so the magnitude converts without overflow
+        is_negative = (text->_scanner._value_image.value[0] == '-');
+        *p_fits = !(is_negative && text->_scanner._number_magnitude == 0);
+        if (*p_fits) {
+            *p_mantissa = is_negative ? -(int64_t)text->_scanner._number_magnitude
+                                      : (int64_t)text->_scanner._number_magnitude;
+            *p_exponent = text->_scanner._number_exponent;
+        }
+        SUCCEED();
+    }
+
+    IONCHECK(_ion_reader_text_read_decimal(preader, &quad, &num));
+    *p_fits = (num == NULL) && decQuadToInt64Parts(&quad, p_mantissa, p_exponent);
+
+    iRETURN;
+}
+
 iERR _ion_reader_text_read_timestamp(ION_READER *preader, ION_TIMESTAMP *p_value)
 {
     iENTER;
@@ -323,6 +323,7 @@ iERR _ion_reader_text_read_ion_int_helper       (ION_READER *preader, ION_INT *p
 iERR _ion_reader_text_read_double               (ION_READER *preader, double *p_value);
 //iERR _ion_reader_text_read_float32              (ION_READER *preader, float *p_value);
 iERR _ion_reader_text_read_decimal              (ION_READER *preader, decQuad *p_quad, decNumber **p_num);
+iERR _ion_reader_text_read_decimal_parts        (ION_READER *preader, int64_t *p_mantissa, int32_t *p_exponent, BOOL *p_fits);
 iERR _ion_reader_text_read_timestamp            (ION_READER *preader, ION_TIMESTAMP *p_value);
 iERR _ion_reader_text_read_symbol               (ION_READER *preader, ION_SYMBOL *p_symbol);
 
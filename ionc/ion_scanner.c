@@ -23,12 +23,25 @@
 
 #include <ionc/ion.h>
 #include "ion_internal.h"
+#include "ion_byte_scan.h"
 
 // this macro is just to keep the lines of code shorter, the do-while 
 // forces the need for a ';' and it executes exactly once
 // still - use with care it depends on local variables and good behavior!
 #define PUSH_VALUE_BYTE(x) do { if (remaining <= 0) { FAILWITH(IERR_TOKEN_TOO_LONG); } remaining--; *dst++ = MAKE_BYTE(x); } while(FALSE)
 
+static inline void _ion_scanner_accumulate_digit(ION_SCANNER *scanner, int c)
+{
+    if (scanner->_number_digits < ION_SCANNER_SMALL_NUMBER_DIGITS) {
+        scanner->_number_magnitude = scanner->_number_magnitude * 10 + (c - '0');
+        // leading zeros aren't significant
+        if (scanner->_number_magnitude != 0) scanner->_number_digits++;
+    }
+    else {
+        scanner->_number_is_small = FALSE;
+    }
+}
+
 static inline BOOL _ion_scanner_is_control_character(int c)
 {
     return c <= 0x1F && 0x00 <= c;
@@ -206,6 +219,8 @@ iERR _ion_scanner_next_actual(ION_SCANNER *scanner, ION_SUB_TYPE *p_ist)
 
     // read the first character of a token, tokens may be preceeded
     // by whitespace
+    scanner->_number_is_small = FALSE;
+
     IONCHECK(_ion_scanner_read_past_whitespace(scanner, &c));
 
     // it's actually in the stream until it gets read into the value buffer
@@ -527,12 +542,54 @@ iERR _ion_scanner_read_char_newline_helper(ION_SCANNER *scanner, int *p_char)
     iRETURN;
 }
 
+// Consumes the bytes already buffered in the current stream page up to the first
+// member of `set`. None of them can be a new line, so the column moves exactly as
+// it would if each byte had gone through _ion_scanner_read_char.
+static void _ion_scanner_skip_to_byte_in_set(ION_SCANNER *scanner, const ION_BYTE_SET *set)
+{
+    ION_STREAM *stream = scanner->_stream;
+    BYTE       *p = (BYTE *)_ion_byte_scan_find(stream->_curr, stream->_limit, set);
+
+    scanner->_col_offset += (int)(p - stream->_curr);
+    stream->_curr = p;
+}
+
+// Consumes the spaces, tabs and complete new lines (\n or \r\n) already buffered
+// in the current stream page, with the same line and column bookkeeping as
+// _ion_scanner_read_char_newline_helper. Anything else, including a \r whose
+// follower isn't buffered yet, is left for the per character path.
+static void _ion_scanner_skip_blank_lines(ION_SCANNER *scanner)
+{
+    ION_STREAM *stream = scanner->_stream;
+    BYTE       *p = stream->_curr, *limit = stream->_limit, *start;
+
+    for (;;) {
+        start = p;
+        p = (BYTE *)_ion_byte_scan_skip_blanks(p, limit);
+        scanner->_col_offset += (int)(p - start);
+        if (p < limit && *p == '\n') {
+            p++;
+        }
+        else if (p + 1 < limit && p[0] == '\r' && p[1] == '\n') {
+            p += 2;
+        }
+        else {
+            break;
+        }
+        scanner->_saved_col_offset = scanner->_col_offset + 1;
+        scanner->_line++;
+        scanner->_col_offset = 0;
+    }
+    stream->_curr = p;
+}
+
 iERR _ion_scanner_read_past_whitespace(ION_SCANNER *scanner, int *p_char)
 {
     iENTER;
     int c;
 
     for (;;) {
+        _ion_scanner_skip_blank_lines(scanner);
         IONCHECK(_ion_scanner_read_char(scanner, &c));
         switch (c) {
         case ION_unicode_byte_order_mark_utf8_start:
@@ -1073,6 +1130,7 @@ iERR _ion_scanner_skip_plain_string(ION_SCANNER *scanner)
     int c;
 
     for (;;) {
+        _ion_scanner_skip_to_byte_in_set(scanner, &_ion_byte_set_string_plain);
         IONCHECK(_ion_scanner_read_char(scanner, &c));
         switch (c) {
         case '"':
@@ -1136,6 +1194,7 @@ iERR _ion_scanner_skip_one_long_string(ION_SCANNER *scanner)
     int c;
 
     for (;;) {
+        _ion_scanner_skip_to_byte_in_set(scanner, &_ion_byte_set_string_quoted);
         IONCHECK(_ion_scanner_read_char(scanner, &c));
         switch (c) {
         case '\'':
@@ -1165,6 +1224,7 @@ iERR _ion_scanner_skip_single_quoted_string(ION_SCANNER *scanner)
     int c;
 
     for (;;) {
+        _ion_scanner_skip_to_byte_in_set(scanner, &_ion_byte_set_string_quoted);
         IONCHECK(_ion_scanner_read_char(scanner, &c));
         switch (c) {
         case '\'':
@@ -1311,12 +1371,197 @@ iERR _ion_scanner_skip_struct(ION_SCANNER *scanner)
     iRETURN;
 }
 
+// the number of containers _ion_scanner_skip_container_in_buffer tracks before it
+// recurses for the deeper ones
+#define ION_SCANNER_SKIP_MAX_DEPTH 64
+
+static iERR _ion_scanner_skip_container_by_char(ION_SCANNER *scanner, int close_char);
+
+// Consumes the new line at p, \n, \r\n or a lone \r, counting it the same way
+// _ion_scanner_read_char_newline_helper does.
+static BYTE *_ion_scanner_skip_new_line_in_buffer(ION_SCANNER *scanner, BYTE *p, BYTE *limit)
+{
+    ASSERT(*p == '\n' || *p == '\r');
+
+    scanner->_col_offset++;
+    if (*p++ == '\r' && p < limit && *p == '\n') {
+        p++;
+    }
+    scanner->_saved_col_offset = scanner->_col_offset;
+    scanner->_line++;
+    scanner->_col_offset = 0;
+    return p;
+}
+
+// Consumes a string or quoted symbol whose opening quote has already been
+// consumed, up to and including the closing `quote`.
+static iERR _ion_scanner_skip_quoted_in_buffer(ION_SCANNER *scanner, BYTE **p_curr, BYTE *limit, const ION_BYTE_SET *set, BYTE quote)
+{
+    iENTER;
+    BYTE *p = *p_curr, *next;
+
+    for (;;) {
+        next = (BYTE *)_ion_byte_scan_find(p, limit, set);
+        scanner->_col_offset += (int)(next - p);
+        p = next;
+        if (p >= limit) FAILWITH(IERR_UNEXPECTED_EOF);
+        if (*p == quote) {
+            p++;
+            scanner->_col_offset++;
+            break;
+        }
+        if (*p == '\\') {
+            // as in _ion_scanner_skip_plain_string the escaped char is simply passed over
+            p++;
+            scanner->_col_offset++;
+            if (p >= limit) FAILWITH(IERR_UNEXPECTED_EOF);
+        }
+        if (*p == '\n' || *p == '\r') {
+            p = _ion_scanner_skip_new_line_in_buffer(scanner, p, limit);
+        }
+        else {
+            p++;
+            scanner->_col_offset++;
+        }
+    }
+    *p_curr = p;
+
+    iRETURN;
+}
+
+// Skips to the end of a container when the whole input is in the stream's one
+// buffer, so the end of the buffer is the end of the input. Brackets, strings,
+// quoted symbols and new lines are matched directly in the buffer, with a stack
+// of the expected close characters instead of a recursive call per container.
+// Comments, long strings and lobs are rare enough that they are handed to the
+// per character routines, after which the buffer scan picks up again.
+static iERR _ion_scanner_skip_container_in_buffer(ION_SCANNER *scanner, int close_char)
+{
+    iENTER;
+    ION_STREAM *stream = scanner->_stream;
+    BYTE       *p = stream->_curr, *limit = stream->_limit, *next;
+    int         closers[ION_SCANNER_SKIP_MAX_DEPTH];
+    int         depth = 0, c;
+
+    closers[depth++] = close_char;
+    while (depth > 0) {
+        // nothing outside of the container set can open or close a nested value
+        next = (BYTE *)_ion_byte_scan_find(p, limit, &_ion_byte_set_container);
+        scanner->_col_offset += (int)(next - p);
+        p = next;
+        if (p >= limit) FAILWITH(IERR_UNEXPECTED_EOF);
+
+        c = *p;
+        switch (c) {
+        case '\n':
+        case '\r':
+            p = _ion_scanner_skip_new_line_in_buffer(scanner, p, limit);
+            continue;
+        case '"':
+            p++;
+            scanner->_col_offset++;
+            IONCHECK(_ion_scanner_skip_quoted_in_buffer(scanner, &p, limit, &_ion_byte_set_string_plain, '"'));
+            continue;
+        case '\'':
+            if (p + 1 < limit && p[1] == '\'') {
+                if (p + 2 < limit && p[2] == '\'') {
+                    p += 3;
+                    scanner->_col_offset += 3;
+                    stream->_curr = p;
+                    IONCHECK(_ion_scanner_skip_one_long_string(scanner));
+                    p = stream->_curr;
+                }
+                else {
+                    // the empty symbol ''
+                    p += 2;
+                    scanner->_col_offset += 2;
+                }
+            }
+            else {
+                p++;
+                scanner->_col_offset++;
+                IONCHECK(_ion_scanner_skip_quoted_in_buffer(scanner, &p, limit, &_ion_byte_set_string_quoted, '\''));
+            }
+            continue;
+        case '/':
+            if (p + 1 < limit && (p[1] == '/' || p[1] == '*')) {
+                stream->_curr = p;
+                IONCHECK(_ion_scanner_read_past_whitespace(scanner, &c));
+                if (c == EOF) FAILWITH(IERR_UNEXPECTED_EOF);
+                IONCHECK(_ion_scanner_unread_char(scanner, c));
+                p = stream->_curr;
+                continue;
+            }
+            break;
+        case ION_unicode_byte_order_mark_utf8_start:
+            // a byte order mark is just whitespace, anything else starting with this byte is passed over
+            if (p + 2 < limit && p[1] == 0xBB && p[2] == 0xBF) {
+                p += 3;
+                scanner->_col_offset += 3;
+                continue;
+            }
+            break;
+        case '{':
+            if (p + 1 < limit && p[1] == '{') {
+                p += 2;
+                scanner->_col_offset += 2;
+                stream->_curr = p;
+                IONCHECK(_ion_scanner_skip_unknown_lob(scanner));
+                p = stream->_curr;
+                continue;
+            }
+            // fall through
+        case '[':
+        case '(':
+            p++;
+            scanner->_col_offset++;
+            c = (c == '{') ? '}' : (c == '[') ? ']' : ')';
+            if (depth < ION_SCANNER_SKIP_MAX_DEPTH) {
+                closers[depth++] = c;
+            }
+            else {
+                stream->_curr = p;
+                IONCHECK(_ion_scanner_skip_container_in_buffer(scanner, c));
+                p = stream->_curr;
+            }
+            continue;
+        default:
+            // one of the close characters, which only counts if it closes the innermost container
+            if (c == closers[depth - 1]) {
+                depth--;
+            }
+            break;
+        }
+        p++;
+        scanner->_col_offset++;
+    }
+    stream->_curr = p;
+
+    iRETURN;
+}
+
 iERR _ion_scanner_skip_container(ION_SCANNER *scanner, int close_char)
+{
+    iENTER;
+
+    if (!_ion_stream_is_paged(scanner->_stream)) {
+        IONCHECK(_ion_scanner_skip_container_in_buffer(scanner, close_char));
+    }
+    else {
+        IONCHECK(_ion_scanner_skip_container_by_char(scanner, close_char));
+    }
+
+    iRETURN;
+}
+
+static iERR _ion_scanner_skip_container_by_char(ION_SCANNER *scanner, int close_char)
 {
     iENTER;
     int c;
 
     for (;;) {
+        // nothing outside of the container set can open or close a nested value
+        _ion_scanner_skip_to_byte_in_set(scanner, &_ion_byte_set_container);
         IONCHECK(_ion_scanner_read_past_whitespace(scanner, &c));
 just_another_char: // yes this is evil
         switch (c) {
@@ -1496,7 +1741,8 @@ iERR _ion_scanner_read_as_string_to_quote(ION_SCANNER *scanner, BYTE *buf, SIZE
     iENTER;
     ION_STREAM *stream = scanner->_stream;
     BOOL        is_triple_quote, triple_quote_terminator = FALSE, eos_encountered = FALSE;
-    BYTE       *dst = buf;
+    BOOL        copy_directly = (ist != IST_CLOB_PLAIN && ist != IST_CLOB_LONG);
+    BYTE       *dst = buf, *p;
     SIZE        remaining = len, written;
     int         c, c2;
 
@@ -1533,6 +1779,20 @@ iERR _ion_scanner_read_as_string_to_quote(ION_SCANNER *scanner, BYTE *buf, SIZE
     // interpret utf8, write utf8 char out, count bytes written
     // the terminator is single quote, double quote, triple quote
     while (remaining > 0) {
+        if (copy_directly) {
+            // printable ascii other than quotes and escapes, and utf8 bytes, are copied as is
+            p = (BYTE *)_ion_byte_scan_find(stream->_curr, stream->_limit, &_ion_byte_set_string_special);
+            written = (SIZE)(p - stream->_curr);
+            if (written > remaining) written = remaining;
+            if (written > 0) {
+                memcpy(dst, stream->_curr, written);
+                stream->_curr += written;
+                scanner->_col_offset += (int)written;
+                dst += written;
+                remaining -= written;
+                continue;
+            }
+        }
         IONCHECK(_ion_scanner_read_char_with_validation(scanner, ist, &c));
         switch (c) {
         case EOF:
@@ -2135,11 +2395,32 @@ iERR _ion_scanner_read_as_base64(ION_SCANNER *scanner, BYTE *buf, SIZE len, SIZE
 // we'll copy bytes into _value_buffer as we process them. they'll be nice and need
 // (and not hold page buffers);
 
+// Adds the exponent pushed into [start, end) by _ion_scanner_read_exponent to
+// the small number's exponent, or gives up on the small form if it's huge.
+static void _ion_scanner_add_decimal_exponent(ION_SCANNER *scanner, BYTE *start, BYTE *end)
+{
+    BOOL    is_negative = FALSE;
+    int32_t exponent = 0;
+
+    if (start < end && (*start == '-' || *start == '+')) {
+        is_negative = (*start == '-');
+        start++;
+    }
+    for (; start < end; start++) {
+        exponent = exponent * 10 + (*start - '0');
+        if (exponent > ION_SCANNER_SMALL_EXPONENT_MAX) {
+            scanner->_number_is_small = FALSE;
+            return;
+        }
+    }
+    scanner->_number_exponent += is_negative ? -exponent : exponent;
+}
+
 iERR _ion_scanner_read_possible_number(ION_SCANNER *scanner, int c, int sign, ION_SUB_TYPE *p_ist)
 {
     iENTER;
     ION_SUB_TYPE    t = IST_NONE;
-    BYTE           *dst = scanner->_value_buffer;
+    BYTE           *dst = scanner->_value_buffer, *exponent_start;
     SIZE            remaining_before, remaining = scanner->_value_buffer_length;
     BOOL            is_zero;
 
@@ -2155,17 +2436,24 @@ iERR _ion_scanner_read_possible_number(ION_SCANNER *scanner, int c, int sign, IO
         PUSH_VALUE_BYTE('-');
     }
     PUSH_VALUE_BYTE(c);
+    scanner->_number_is_small  = TRUE;
+    scanner->_number_digits    = 0;
+    scanner->_number_magnitude = 0;
+    scanner->_number_exponent  = 0;
+    _ion_scanner_accumulate_digit(scanner, c);
     is_zero = (c == '0'); // we need to save this to complain later if someone includes unnessesary leading 0's <sigh>
 
     IONCHECK(_ion_scanner_read_char(scanner, &c));
 
     // if we have an x we have a hexadecimal int
     if (c == 'x' || c == 'X') {
+        scanner->_number_is_small = FALSE;
         PUSH_VALUE_BYTE(c);
         IONCHECK(_ion_scanner_read_hex_int(scanner, &dst, &remaining, &c));
         t = (sign == -1) ? IST_INT_NEG_HEX : IST_INT_POS_HEX;
     }
     else if (c == 'b' || c == 'B') {
+        scanner->_number_is_small = FALSE;
         PUSH_VALUE_BYTE(c);
         IONCHECK(_ion_scanner_read_binary_int(scanner, &dst, &remaining, &c));
         t = (sign == -1) ? IST_INT_NEG_BINARY : IST_INT_POS_BINARY;
@@ -2182,6 +2470,7 @@ iERR _ion_scanner_read_possible_number(ION_SCANNER *scanner, int c, int sign, IO
         if (IS_1_BYTE_UTF8(c) && (isdigit(c) || c == '_')) {
             if (isdigit(c)) {
                 PUSH_VALUE_BYTE(c);
+                _ion_scanner_accumulate_digit(scanner, c);
                 IONCHECK(_ion_scanner_read_digits_with_underscores(scanner, &dst, &remaining, &c, TRUE));
             }
             else { // c == '_'
@@ -2199,6 +2488,7 @@ iERR _ion_scanner_read_possible_number(ION_SCANNER *scanner, int c, int sign, IO
                 // no negative timestamps and a year is 4 digits long
                 FAILWITH(IERR_INVALID_TIMESTAMP);
             }
+            scanner->_number_is_small = FALSE;
             IONCHECK(_ion_scanner_read_timestamp(scanner, c, &dst, &remaining, &c, &t));
             // note that read timestamp doesn't overread
         }
@@ -2216,7 +2506,10 @@ iERR _ion_scanner_read_possible_number(ION_SCANNER *scanner, int c, int sign, IO
             // for the exponent
             if (c == '.') {
                 PUSH_VALUE_BYTE(c);
+                remaining_before = remaining;
                 IONCHECK(_ion_scanner_read_digits_with_underscores(scanner, &dst, &remaining, &c, FALSE));
+                // every digit after the point was pushed (the underscores are not)
+                scanner->_number_exponent = -(int32_t)(remaining_before - remaining);
                 // with a decimal point we'll presume this is a a decimal unless we see a 'e'
                 t = IST_DECIMAL;
             }
@@ -2227,11 +2520,16 @@ iERR _ion_scanner_read_possible_number(ION_SCANNER *scanner, int c, int sign, IO
 
             if (c == 'd' || c == 'D') {
                 PUSH_VALUE_BYTE(c);
+                exponent_start = dst;
                 IONCHECK(_ion_scanner_read_exponent(scanner, &dst, &remaining, &c));
+                if (scanner->_number_is_small) {
+                    _ion_scanner_add_decimal_exponent(scanner, exponent_start, dst);
+                }
                 // ahh, this is a decimal *with* a 'd'
                 t = IST_DECIMAL_D;
             }
             else if (c == 'e' || c == 'E') {
+                scanner->_number_is_small = FALSE;
                 PUSH_VALUE_BYTE(c);
                 IONCHECK(_ion_scanner_read_exponent(scanner, &dst, &remaining, &c));
                 // it's a float 64 with a 'e'
@@ -2284,6 +2582,9 @@ iERR _ion_scanner_read_radix_int(ION_SCANNER *scanner, BYTE **p_dst, SIZE *p_rem
             break;
         }
         PUSH_VALUE_BYTE(c);
+        if (radix == ION_INT_DECIMAL) {
+            _ion_scanner_accumulate_digit(scanner, c);
+        }
         underscore_allowed = TRUE;
     }
 
@@ -124,8 +124,22 @@ typedef struct _ion_scanner
      */
     int             _saved_col_offset;            //  = 0;
 
+    /** The magnitude and exponent of the decimal int or decimal value just scanned,
+     *  accumulated as its digits are read. These are only valid when _number_is_small
+     *  is set, which it is when there are no more than ION_SCANNER_SMALL_NUMBER_DIGITS
+     *  significant digits, so the readers can skip ION_INT and decNumber.
+     *
+     */
+    BOOL            _number_is_small;
+    int             _number_digits;
+    uint64_t        _number_magnitude;
+    int32_t         _number_exponent;
+
 } ION_SCANNER;
 
+#define ION_SCANNER_SMALL_NUMBER_DIGITS 18     /* 999,999,999,999,999,999 fits any int64 */
+#define ION_SCANNER_SMALL_EXPONENT_MAX  999999 /* well past any decimal's exponent range */
+
 
 #define NEW_LINE_3             -8 /* carraige return */
 #define NEW_LINE_2             -7 /* carraige newline return */
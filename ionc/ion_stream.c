@@ -858,6 +858,53 @@ iERR ion_stream_write_byte_no_checks(ION_STREAM *stream, int byte)
 }
 
 
+iERR ion_stream_reserve(ION_STREAM *stream, SIZE len, BYTE **p_dst)
+{
+  iENTER;
+  SIZE room;
+
+  if (!stream) FAILWITH(IERR_INVALID_ARG);
+  if (len < 0) FAILWITH(IERR_INVALID_ARG);
+  if (!p_dst) FAILWITH(IERR_INVALID_ARG);
+  if (_ion_stream_can_write(stream) == FALSE) FAILWITH(IERR_INVALID_ARG);
+
+  room = stream->_buffer_size - (SIZE)(stream->_curr - stream->_buffer);
+  if (room < 1) {
+    // if there's no room get the next page, just as write does
+    IONCHECK(_ion_stream_fetch_position( stream, _ion_stream_position(stream) ));
+    room = stream->_buffer_size - (SIZE)(stream->_curr - stream->_buffer);
+  }
+
+  // the span can't cross a page boundary, so the caller has to fall
+  // back to ion_stream_write when the rest of the page is too short
+  *p_dst = (room >= len) ? stream->_curr : NULL;
+  SUCCEED();
+
+  iRETURN;
+}
+
+iERR ion_stream_commit(ION_STREAM *stream, SIZE len)
+{
+  iENTER;
+
+  if (!stream) FAILWITH(IERR_INVALID_ARG);
+  if (len < 0) FAILWITH(IERR_INVALID_ARG);
+  if (len > stream->_buffer_size - (SIZE)(stream->_curr - stream->_buffer)) FAILWITH(IERR_INVALID_ARG);
+  if (len == 0) SUCCEED();
+
+  if (stream->_dirty_start == NULL) {
+    stream->_dirty_start = stream->_curr;
+  }
+  stream->_dirty_length += len;
+  stream->_curr += len;
+  if (stream->_curr > stream->_limit) {
+    stream->_limit = stream->_curr;
+  }
+  SUCCEED();
+
+  iRETURN;
+}
+
 #define TEMP_BUFFER_LEN (8096)
 
 // this writes some number of bytes from an input stream
@@ -1080,7 +1127,7 @@ iERR _ion_stream_mark_clear_helper( ION_STREAM_PAGED *paged, POSITION position )
   iENTER;
   ION_STREAM *stream = UNPAGED_STREAM(paged);
   POSITION    mark_position; // _ion_stream_position(stream)
-  PAGE_ID     page_id, current_page;
+  PAGE_ID     page_id, current_page, pin_page;
   ION_PAGE   *page;
    
   ASSERT(stream);
@@ -1103,6 +1150,11 @@ iERR _ion_stream_mark_clear_helper( ION_STREAM_PAGED *paged, POSITION position )
   if (position > stream->_buffer_size) { 
       // -1 on pos since it's the next char and we need to keep the next char in place
       current_page = _ion_stream_page_id_from_offset(stream, (position - 1)); 
+      if (_ion_stream_is_pinned(stream)) {
+          // pinned pages stay until the pin is removed
+          pin_page = _ion_stream_page_id_from_offset(stream, stream->_pin);
+          if (pin_page < current_page) current_page = pin_page;
+      }
       while (page_id < current_page) {
           IONCHECK(_ion_stream_page_find(paged, page_id, &page));
           _ion_stream_page_release(paged, page);
@@ -1116,6 +1168,82 @@ iERR _ion_stream_mark_clear_helper( ION_STREAM_PAGED *paged, POSITION position )
 }
 
 
+iERR ion_stream_pin( ION_STREAM *stream, POSITION position )
+{
+  iENTER;
+  ION_PAGE *page;
+
+  if (!stream) FAILWITH(IERR_INVALID_ARG);
+  if (position < 0 || position > _ion_stream_position(stream)) FAILWITH(IERR_INVALID_ARG);
+
+  // the bytes at position have to still be around to be worth pinning
+  if (_ion_stream_is_paged(stream) && position < stream->_offset) {
+      IONCHECK(_ion_stream_page_find(PAGED_STREAM(stream), _ion_stream_page_id_from_offset(stream, position), &page));
+      if (!page) FAILWITH(IERR_INVALID_ARG);
+  }
+
+  if (stream->_pin_count == 0 || position < stream->_pin) {
+      stream->_pin = position;
+  }
+  stream->_pin_count++;
+  SUCCEED();
+
+  iRETURN;
+}
+
+iERR ion_stream_unpin( ION_STREAM *stream )
+{
+  iENTER;
+
+  if (!stream) FAILWITH(IERR_INVALID_ARG);
+  if (stream->_pin_count < 1) FAILWITH(IERR_INVALID_STATE);
+
+  stream->_pin_count--;
+  if (stream->_pin_count == 0) {
+      if (_ion_stream_is_paged(stream) && !_ion_stream_is_fully_buffered(stream)) {
+          IONCHECK(_ion_stream_unpin_helper(PAGED_STREAM(stream)));
+      }
+      stream->_pin = -1;
+  }
+  SUCCEED();
+
+  iRETURN;
+}
+
+// releases the pages that were only kept because they were pinned, that is the
+// pages from the pin up to the current page (or up to the mark, when one is open)
+iERR _ion_stream_unpin_helper( ION_STREAM_PAGED *paged )
+{
+  iENTER;
+  ION_STREAM *stream = UNPAGED_STREAM(paged);
+  PAGE_ID     page_id, end_page_id, mark_page_id;
+  ION_PAGE   *page;
+
+  ASSERT(stream);
+  ASSERT(stream->_pin >= 0);
+  ASSERT(_ion_stream_is_paged(stream));
+  ASSERT(!_ion_stream_is_fully_buffered(stream));
+
+  if (!paged->_curr_page) SUCCEED();
+
+  page_id = _ion_stream_page_id_from_offset(stream, stream->_pin);
+  end_page_id = paged->_curr_page->_page_id;
+  if (_ion_stream_is_mark_open(stream)) {
+      mark_page_id = _ion_stream_page_id_from_offset(stream, stream->_mark);
+      if (mark_page_id < end_page_id) end_page_id = mark_page_id;
+  }
+  for (; page_id < end_page_id; page_id++) {
+      IONCHECK(_ion_stream_page_find(paged, page_id, &page));
+      if (page) {
+          _ion_stream_page_release(paged, page);
+      }
+  }
+  SUCCEED();
+
+  iRETURN;
+}
+
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 //                     internal constructor helpers
@@ -1155,6 +1283,8 @@ iERR _ion_stream_open_helper(ION_STREAM_FLAG flags, SIZE page_size, ION_STREAM *
 
   stream->_flags = flags;
   stream->_mark =  -1;
+  stream->_pin =  -1;
+  stream->_pin_count = 0;
   stream->_dirty_start = NULL;
   stream->_dirty_length = 0;
   stream->_buffer_size = page_size;
@@ -1251,6 +1381,12 @@ BOOL _ion_stream_is_mark_open(ION_STREAM *stream)
   return mark_in_progress;
 }
 
+BOOL _ion_stream_is_pinned(ION_STREAM *stream)
+{
+  BOOL   is_pinned = (stream->_pin_count > 0);
+  return is_pinned;
+}
+
 BOOL _ion_stream_can_random_seek(ION_STREAM *stream)
 {
   BOOL   can_seek = IS_FLAG_ON(STREAM_FLAGS(stream), FLAG_RANDOM_ACCESS);
@@ -1331,7 +1467,7 @@ BOOL _ion_stream_is_fully_buffered(ION_STREAM *stream)
 }
 BOOL _ion_stream_is_caching( ION_STREAM *stream)
 {
-  BOOL   is_caching = _ion_stream_is_mark_open(stream) || _ion_stream_is_fully_buffered(stream);
+  BOOL   is_caching = _ion_stream_is_mark_open(stream) || _ion_stream_is_pinned(stream) || _ion_stream_is_fully_buffered(stream);
   return is_caching;
 }
 FILE *_ion_stream_get_file_stream( ION_STREAM *stream )
@@ -1588,6 +1724,109 @@ iERR _ion_stream_fetch_fill_page( ION_STREAM *stream, ION_PAGE *page, POSITION t
     iRETURN;
 }
 
+// returns a pointer to the bytes between position and the current position
+// when they are all still in the current page and haven't been flushed, so
+// that they can be rewritten or moved in place. returns NULL otherwise.
+BYTE *_ion_stream_unflushed_tail( ION_STREAM *stream, POSITION position )
+{
+    ASSERT(stream);
+    ASSERT(_ion_stream_can_write(stream));
+
+    if (position < stream->_offset || position > _ion_stream_position(stream)) {
+        return NULL;
+    }
+    if (_ion_stream_is_file_backed(stream) || _ion_stream_is_fd_backed(stream)) {
+        // anything before the dirty start is already in the file
+        if (stream->_dirty_start == NULL || position < IH_POSITION_OF(stream->_dirty_start)) {
+            return NULL;
+        }
+    }
+    return IH_CURR_OF(position);
+}
+
+// drops the last distance bytes written, which must all be in the unflushed
+// tail of the current page. the stream must be positioned at its end.
+iERR _ion_stream_retract( ION_STREAM *stream, SIZE distance )
+{
+    iENTER;
+
+    ASSERT(stream);
+    ASSERT(stream->_curr == stream->_limit);
+
+    if (distance < 0) FAILWITH(IERR_INVALID_ARG);
+    if (distance == 0) SUCCEED();
+    if (_ion_stream_unflushed_tail(stream, _ion_stream_position(stream) - distance) == NULL) {
+        FAILWITH(IERR_INVALID_ARG);
+    }
+
+    stream->_curr -= distance;
+    stream->_limit = stream->_curr;
+    if (stream->_dirty_start != NULL) {
+        stream->_dirty_length -= distance;
+        if (stream->_dirty_length <= 0) {
+            stream->_dirty_start = NULL;
+            stream->_dirty_length = 0;
+        }
+    }
+
+    iRETURN;
+}
+
+// overwrites len bytes which were already written at position, leaving the
+// current position where it is. bytes which are still buffered are changed
+// in memory, otherwise the stream is flushed and the file is written directly.
+iERR _ion_stream_patch( ION_STREAM *stream, POSITION position, BYTE *buf, SIZE len )
+{
+    iENTER;
+    POSITION end;
+    SIZE     written;
+    BYTE    *tail;
+
+    ASSERT(stream);
+    ASSERT(buf);
+
+    if (!_ion_stream_can_write(stream) || !_ion_stream_can_random_seek(stream)) FAILWITH(IERR_INVALID_ARG);
+    end = _ion_stream_position(stream);
+    if (len < 0 || position < 0 || position + len > end) FAILWITH(IERR_INVALID_ARG);
+    if (len == 0) SUCCEED();
+
+    tail = _ion_stream_unflushed_tail(stream, position);
+    if (tail != NULL) {
+        memcpy(tail, buf, len);
+    }
+    else if (!_ion_stream_is_file_backed(stream) && !_ion_stream_is_fd_backed(stream)) {
+        // memory streams keep every page, so we just go back and write over the bytes
+        IONCHECK(ion_stream_seek(stream, position));
+        IONCHECK(ion_stream_write(stream, buf, len, &written));
+        if (written != len) FAILWITH(IERR_WRITE_ERROR);
+        IONCHECK(ion_stream_seek(stream, end));
+    }
+    else {
+        IONCHECK(_ion_stream_flush_helper(stream));
+        IONCHECK(_ion_stream_fseek(stream, position));
+        if (_ion_stream_is_fd_backed(stream)) {
+            written = (SIZE)WRITE((int)stream->_fp, buf, len);
+        }
+        else {
+            written = (SIZE)fwrite(buf, sizeof(BYTE), len, stream->_fp);
+        }
+        if (written != len) FAILWITH(IERR_WRITE_ERROR);
+        IONCHECK(_ion_stream_fseek(stream, end));
+
+        // keep the copy in the current page in step with the file
+        if (_ion_stream_current_page_contains_position(stream, position + len - 1)) {
+            if (position >= stream->_offset) {
+                memcpy(IH_CURR_OF(position), buf, len);
+            }
+            else {
+                memcpy(stream->_buffer, buf + (stream->_offset - position), (SIZE)(position + len - stream->_offset));
+            }
+        }
+    }
+
+    iRETURN;
+}
+
 // _ion_stream_fseek wraps fseek (for normal files) and
 // stream only seek files
 
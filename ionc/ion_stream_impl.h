@@ -181,6 +181,8 @@ struct _ion_stream
   BYTE            *_limit;        // end of buffered data
 
   POSITION         _mark;         // -1 for no mark otherwise the file position where the mark started
+  POSITION         _pin;          // -1 when nothing is pinned otherwise the lowest pinned position
+  int32_t          _pin_count;    // number of open ion_stream_pin calls
 
   BYTE            *_dirty_start;  // pointer to first dirty byte in current buffer
   SIZE             _dirty_length; // number of dirty bytes (only contiguous bytes in the current buffer are allowed to be dirty)
@@ -244,6 +246,7 @@ iERR _ion_stream_flush_helper( ION_STREAM *stream );
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 BOOL      _ion_stream_is_mark_open        ( ION_STREAM *stream );
+BOOL      _ion_stream_is_pinned           ( ION_STREAM *stream );
 BOOL      _ion_stream_can_random_seek     ( ION_STREAM *stream );
 BOOL      _ion_stream_can_seek_to         ( ION_STREAM *stream, POSITION pos );
 BOOL      _ion_stream_can_read            ( ION_STREAM *stream );
@@ -261,6 +264,7 @@ FILE *    _ion_stream_get_file_stream     ( ION_STREAM *stream );
 POSITION  _ion_stream_get_mark_start      ( ION_STREAM *stream );
 POSITION  _ion_stream_get_marked_length   ( ION_STREAM *stream );
 iERR      _ion_stream_mark_clear_helper   ( ION_STREAM_PAGED *paged, POSITION position );
+iERR      _ion_stream_unpin_helper        ( ION_STREAM_PAGED *paged );
 
 PAGE_ID   _ion_stream_page_id_from_offset ( ION_STREAM *stream, POSITION file_offset );
 POSITION  _ion_stream_offset_from_page_id ( ION_STREAM *stream, PAGE_ID page_id );
@@ -282,6 +286,11 @@ iERR _ion_stream_read_for_seek            ( ION_STREAM *stream, POSITION target_
 iERR _ion_stream_fread                    ( ION_STREAM *stream, BYTE *dst, BYTE *end, SIZE *p_bytes_read);
 iERR _ion_stream_console_read             ( ION_STREAM *stream, BYTE *dst, BYTE *end, SIZE *p_bytes_read);
 
+// support for writers that go back and fill in bytes (lengths) they have already written
+BYTE *_ion_stream_unflushed_tail          ( ION_STREAM *stream, POSITION position );
+iERR _ion_stream_retract                  ( ION_STREAM *stream, SIZE distance );
+iERR _ion_stream_patch                    ( ION_STREAM *stream, POSITION position, BYTE *buf, SIZE len );
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 
 //            PAGE ROUTINES - these manage pages for the paged streams
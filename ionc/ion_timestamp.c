@@ -207,6 +207,82 @@ iERR _ion_timestamp_scientific_notation_fraction_to_string(char *scientific_frac
     iRETURN;
 }
 
+// the common shapes, minute or second precision with no more than nine
+// fraction digits, have a fixed layout: each field is written at its place
+// with a digit pair table instead of going through the general routine.
+// returns FALSE, having written nothing, for anything else
+static BOOL _ion_timestamp_to_string_fast(ION_TIMESTAMP *ptime, char *buffer, SIZE buf_length, SIZE *p_length_written)
+{
+    char     *pos = buffer;
+    uint8_t   bcd[DECQUAD_Pmax];
+    uint32_t  coefficient = 0;
+    int32_t   exponent = 0;
+    int       offset, ii;
+
+    if (buf_length < ION_TIMESTAMP_FAST_STRING_LENGTH + 1) return FALSE;
+    if (!IS_FLAG_ON(ptime->precision, ION_TT_BIT_MIN)) return FALSE;
+    if (ptime->year > 9999 || ptime->month > 12 || ptime->day > 31
+     || ptime->hours > 23 || ptime->minutes > 59 || ptime->seconds > 59
+    ) {
+        return FALSE;
+    }
+    if (IS_FLAG_ON(ptime->precision, ION_TT_BIT_FRAC)) {
+        exponent = decQuadGetExponent(&ptime->fraction);
+        if (exponent < -9 || exponent >= 0 || decQuadIsSigned(&ptime->fraction) || !decQuadIsFinite(&ptime->fraction)) {
+            return FALSE;
+        }
+        decQuadGetCoefficient(&ptime->fraction, bcd);
+        for (ii = 0; ii < DECQUAD_Pmax + exponent; ii++) {
+            if (bcd[ii]) return FALSE; // not less than one
+        }
+        for (; ii < DECQUAD_Pmax; ii++) {
+            coefficient = coefficient * 10 + bcd[ii];
+        }
+    }
+    offset = HAS_TZ_OFFSET(ptime) ? ptime->tz_offset : 0;
+    if (offset <= -24 * 60 || offset >= 24 * 60) return FALSE;
+
+    _ion_uint32_to_chars_padded(ptime->year, pos, 4);
+    pos[4] = '-';
+    _ion_uint32_to_chars_padded(ptime->month, pos + 5, 2);
+    pos[7] = '-';
+    _ion_uint32_to_chars_padded(ptime->day, pos + 8, 2);
+    pos[10] = 'T';
+    _ion_uint32_to_chars_padded(ptime->hours, pos + 11, 2);
+    pos[13] = ':';
+    _ion_uint32_to_chars_padded(ptime->minutes, pos + 14, 2);
+    pos += 16;
+    if (IS_FLAG_ON(ptime->precision, ION_TT_BIT_SEC)) {
+        pos[0] = ':';
+        _ion_uint32_to_chars_padded(ptime->seconds, pos + 1, 2);
+        pos += 3;
+        if (IS_FLAG_ON(ptime->precision, ION_TT_BIT_FRAC)) {
+            *pos++ = '.';
+            _ion_uint32_to_chars_padded(coefficient, pos, -exponent);
+            pos += -exponent;
+        }
+    }
+    if (!HAS_TZ_OFFSET(ptime)) {
+        memcpy(pos, ION_TIMESTAMP_NULL_OFFSET_IMAGE, ION_TIMESTAMP_NULL_OFFSET_IMAGE_LEN);
+        pos += ION_TIMESTAMP_NULL_OFFSET_IMAGE_LEN;
+    }
+    else if (offset == 0) {
+        *pos++ = 'Z';
+    }
+    else {
+        *pos++ = (offset > 0) ? '+' : '-';
+        if (offset < 0) offset = -offset;
+        _ion_uint32_to_chars_padded(offset / 60, pos, 2);
+        pos[2] = ':';
+        _ion_uint32_to_chars_padded(offset % 60, pos + 3, 2);
+        pos += 5;
+    }
+    *pos = '\0';
+
+    if (p_length_written) *p_length_written = (SIZE)(pos - buffer);
+    return TRUE;
+}
+
 iERR ion_timestamp_to_string(ION_TIMESTAMP *ptime, char *buffer, SIZE buf_length, SIZE *p_length_written, decContext *pcontext)
 {
     iENTER;
@@ -231,6 +307,10 @@ iERR ion_timestamp_to_string(ION_TIMESTAMP *ptime, char *buffer, SIZE buf_length
         SUCCEED();
     }
 
+    if (_ion_timestamp_to_string_fast(ptime, buffer, buf_length, p_length_written)) {
+        SUCCEED();
+    }
+
     // if it's not null, we get out raw values
     IONCHECK(ion_timestamp_get_local_offset(ptime, &offset));
 
@@ -461,6 +541,166 @@ static BOOL _ion_timestamp_is_valid_day(int year, int one_based_month, int day)
     return TRUE;
 }
 
+// the 8 characters at src as a word, the first character in the low byte
+// whatever the platform's byte order
+static uint64_t _ion_timestamp_load_word(const char *src)
+{
+    const BYTE *b = (const BYTE *)src;
+
+    return  (uint64_t)b[0]        | ((uint64_t)b[1] << 8)  | ((uint64_t)b[2] << 16) | ((uint64_t)b[3] << 24)
+         | ((uint64_t)b[4] << 32) | ((uint64_t)b[5] << 40) | ((uint64_t)b[6] << 48) | ((uint64_t)b[7] << 56);
+}
+
+// TRUE if the bytes of word under digit_mask are all '0' to '9' and the
+// others equal separators. the bytes are checked all at once: a digit has
+// 3 in its high nibble both before and after adding 6
+static BOOL _ion_timestamp_word_matches(uint64_t word, uint64_t digit_mask, uint64_t separators)
+{
+    uint64_t digits = word & digit_mask;
+
+    return (word & ~digit_mask) == separators
+        && (digits & ION_TIMESTAMP_WORD_HIGH_NIBBLES) == (ION_TIMESTAMP_WORD_ZEROS & digit_mask)
+        && ((digits + (ION_TIMESTAMP_WORD_SIXES & digit_mask)) & ION_TIMESTAMP_WORD_HIGH_NIBBLES)
+               == (ION_TIMESTAMP_WORD_ZEROS & digit_mask);
+}
+
+// turns the digit bytes of a matched word into their values, then each byte
+// into the two digit number that starts there
+static uint64_t _ion_timestamp_word_pairs(uint64_t word, uint64_t digit_mask)
+{
+    uint64_t digits = (word & digit_mask) - (ION_TIMESTAMP_WORD_ZEROS & digit_mask);
+
+    return digits * 10 + (digits >> 8);
+}
+
+#define ION_TIMESTAMP_WORD_BYTE(word, n) ((int)(((word) >> ((n) * 8)) & 0xFF))
+
+// the value of 8 digits in a matched word, combining pairs, then fours, then the two halves
+static uint32_t _ion_timestamp_word_value(uint64_t word)
+{
+    uint64_t pairs = _ion_timestamp_word_pairs(word, ~(uint64_t)0);
+
+    return (uint32_t)(((( pairs        & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)))
+                      + (((pairs >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32);
+}
+
+static BOOL _ion_timestamp_is_terminator(int c)
+{
+    switch (c) {
+    case NEW_LINE_1:
+    case NEW_LINE_2:
+    case NEW_LINE_3:
+    case   0:
+    case ' ': case '\t': case '\n': case '\r':
+    case ',': case  '"': case '\'':
+    case '(': case ')':
+    case '[': case ']':
+    case '{': case '}':
+    case '/':
+        return TRUE;
+    default:
+        return FALSE;
+    }
+}
+
+// parses the common YYYY-MM-DDThh:mm:ss[.f{1,9}](Z|+hh:mm|-hh:mm) shape,
+// checking the fixed parts of the layout a word at a time. returns FALSE,
+// with ptime untouched, for anything else (including invalid values) so the
+// general parser can take over and report the error
+static BOOL _ion_timestamp_parse_fast(ION_TIMESTAMP *ptime, char *buffer, SIZE buf_length, SIZE *p_chars_used,
+                                      decContext *pcontext)
+{
+    char     *cp = buffer, *end_of_buffer = buffer + buf_length;
+    uint64_t  date, time;
+    uint32_t  fraction = 0;
+    int       year, month, day, hours, minutes, seconds, fraction_digits = 0, offset = 0;
+    BOOL      has_offset = TRUE, is_negative;
+
+    if (buf_length < ION_TIMESTAMP_FAST_MIN_LENGTH) return FALSE;
+
+    date = _ion_timestamp_load_word(cp);
+    time = _ion_timestamp_load_word(cp + 8);
+    if (!_ion_timestamp_word_matches(date, ION_TIMESTAMP_DATE_DIGITS, ION_TIMESTAMP_DATE_SEPARATORS)
+     || !_ion_timestamp_word_matches(time, ION_TIMESTAMP_TIME_DIGITS, ION_TIMESTAMP_TIME_SEPARATORS)
+     || cp[16] != ':' || !isdigit(cp[17]) || !isdigit(cp[18])
+    ) {
+        return FALSE;
+    }
+    date = _ion_timestamp_word_pairs(date, ION_TIMESTAMP_DATE_DIGITS);
+    time = _ion_timestamp_word_pairs(time, ION_TIMESTAMP_TIME_DIGITS);
+    year    = ION_TIMESTAMP_WORD_BYTE(date, 0) * 100 + ION_TIMESTAMP_WORD_BYTE(date, 2);
+    month   = ION_TIMESTAMP_WORD_BYTE(date, 5);
+    day     = ION_TIMESTAMP_WORD_BYTE(time, 0);
+    hours   = ION_TIMESTAMP_WORD_BYTE(time, 3);
+    minutes = ION_TIMESTAMP_WORD_BYTE(time, 6);
+    seconds = (cp[17] - '0') * 10 + (cp[18] - '0');
+    cp += 19;
+
+    if (cp < end_of_buffer && *cp == '.') {
+        cp++;
+        if (end_of_buffer - cp >= 8 && _ion_timestamp_word_matches(_ion_timestamp_load_word(cp), ~(uint64_t)0, 0)) {
+            fraction = _ion_timestamp_word_value(_ion_timestamp_load_word(cp));
+            fraction_digits = 8;
+            cp += 8;
+        }
+        while (cp < end_of_buffer && isdigit(*cp)) {
+            if (fraction_digits == 9) return FALSE;
+            fraction = fraction * 10 + (*cp++ - '0');
+            fraction_digits++;
+        }
+        if (fraction_digits == 0) return FALSE;
+    }
+
+    if (cp >= end_of_buffer) return FALSE;
+    if (*cp == 'Z') {
+        cp++;
+    }
+    else if (*cp == '+' || *cp == '-') {
+        is_negative = (*cp == '-');
+        if (end_of_buffer - cp < 6 || !isdigit(cp[1]) || !isdigit(cp[2]) || cp[3] != ':'
+         || !isdigit(cp[4]) || !isdigit(cp[5])
+        ) {
+            return FALSE;
+        }
+        offset = ((cp[1] - '0') * 10 + (cp[2] - '0')) * 60 + (cp[4] - '0') * 10 + (cp[5] - '0');
+        if (cp[1] > '2' || (cp[1] == '2' && cp[2] > '3') || cp[4] > '5') return FALSE;
+        if (is_negative) {
+            // -00:00 is the unknown offset
+            has_offset = (offset != 0);
+            offset = -offset;
+        }
+        cp += 6;
+    }
+    else {
+        return FALSE;
+    }
+    if (!_ion_timestamp_is_terminator(*cp)) return FALSE;
+
+    if (year < 1 || !_ion_timestamp_is_valid_day(year, month, day) || hours > 23 || minutes > 59 || seconds > 59) {
+        return FALSE;
+    }
+
+    _ion_timestamp_initialize(ptime);
+    ptime->precision = ION_TS_SEC;
+    ptime->year      = (uint16_t)year;
+    ptime->month     = (uint16_t)month;
+    ptime->day       = (uint16_t)day;
+    ptime->hours     = (uint16_t)hours;
+    ptime->minutes   = (uint16_t)minutes;
+    ptime->seconds   = (uint16_t)seconds;
+    if (fraction_digits) {
+        SET_FLAG_ON(ptime->precision, ION_TS_FRAC);
+        decQuadFromUInt32(&ptime->fraction, fraction);
+        decQuadSetExponent(&ptime->fraction, pcontext, -fraction_digits);
+    }
+    if (has_offset) {
+        SET_FLAG_ON(ptime->precision, ION_TT_BIT_TZ);
+        ptime->tz_offset = (int16_t)offset;
+    }
+    *p_chars_used = (SIZE)(cp - buffer);
+    return TRUE;
+}
+
 // this expects a null terminated string
 iERR ion_timestamp_parse(ION_TIMESTAMP *ptime, char *buffer, SIZE buf_length, SIZE *p_chars_used, decContext *pcontext)
 {
@@ -484,6 +724,10 @@ iERR ion_timestamp_parse(ION_TIMESTAMP *ptime, char *buffer, SIZE buf_length, SI
     if (!buffer)        FAILWITH(IERR_INVALID_ARG);
     if (buf_length < 1) FAILWITH(IERR_INVALID_ARG);
 
+    if (_ion_timestamp_parse_fast(ptime, buffer, buf_length, p_chars_used, pcontext)) {
+        SUCCEED();
+    }
+
     // zero out the passed in time buffer
     IONCHECK(_ion_timestamp_initialize(ptime));
 
@@ -665,22 +909,10 @@ end_of_time:
 
 end_of_days:
     // check for one of our valid timestamp termination characters
-    switch (*cp) {
-    case NEW_LINE_1:
-    case NEW_LINE_2:
-    case NEW_LINE_3:
-    case   0:
-    case ' ': case '\t': case '\n': case '\r':
-    case ',': case  '"': case '\'':
-    case '(': case ')': 
-    case '[': case ']': 
-    case '{': case '}':
-    case '/':
-        *p_chars_used = (SIZE)(cp - buffer);    // TODO - this needs 64bit care
-        break;
-    default:
+    if (!_ion_timestamp_is_terminator(*cp)) {
         FAILWITH(IERR_INVALID_TIMESTAMP);
     }
+    *p_chars_used = (SIZE)(cp - buffer);    // TODO - this needs 64bit care
 
     // now we have put it all together into a real timestamp
     IONCHECK(_ion_timestamp_initialize(ptime));
@@ -1411,3 +1643,245 @@ timestamp_is_finished:
 
     iRETURN;
 }
+
+// the days_from_civil and civil_from_days algorithms from Howard Hinnant's
+// "chrono-Compatible Low-Level Date Algorithms", over 400 year eras that
+// start on March 1st so the leap day is the last day of the year
+int64_t _ion_timestamp_days_from_civil(int year, int month, int day)
+{
+    int64_t y = year - (month <= 2);
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    int64_t yoe = y - era * 400;                                            // [0, 399]
+    int64_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1; // [0, 365]
+    int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;                    // [0, 146096]
+
+    return era * 146097 + doe - 719468;
+}
+
+void _ion_timestamp_civil_from_days(int64_t days, int *p_year, int *p_month, int *p_day)
+{
+    int64_t z = days + 719468;
+    int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    int64_t doe = z - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+
+    *p_day = (int)(doy - (153 * mp + 2) / 5 + 1);
+    *p_month = (int)(mp < 10 ? mp + 3 : mp - 9);
+    *p_year = (int)(yoe + era * 400 + (*p_month <= 2));
+}
+
+void _ion_timestamp_set_epoch_seconds(ION_TIMESTAMP *ptime, int64_t epoch_seconds)
+{
+    int64_t days, seconds_of_day;
+    int     year, month, day;
+
+    ASSERT(ptime);
+
+    days = epoch_seconds / ION_TIMESTAMP_SECONDS_PER_DAY;
+    seconds_of_day = epoch_seconds % ION_TIMESTAMP_SECONDS_PER_DAY;
+    if (seconds_of_day < 0) {
+        days--;
+        seconds_of_day += ION_TIMESTAMP_SECONDS_PER_DAY;
+    }
+    _ion_timestamp_civil_from_days(days, &year, &month, &day);
+
+    ptime->year    = (uint16_t)year;
+    ptime->month   = (uint16_t)month;
+    ptime->day     = (uint16_t)day;
+    ptime->hours   = (uint16_t)(seconds_of_day / 3600);
+    ptime->minutes = (uint16_t)((seconds_of_day / 60) % 60);
+    ptime->seconds = (uint16_t)(seconds_of_day % 60);
+}
+
+iERR _ion_timestamp_epoch_nanos_from_fields(int year, int month, int day, int hours, int minutes, int seconds,
+                                            int32_t nanos, int64_t *p_epoch_nanos)
+{
+    iENTER;
+    int64_t epoch_seconds;
+
+    ASSERT(p_epoch_nanos);
+    ASSERT(nanos >= 0 && nanos < ION_TIMESTAMP_NANOS_PER_SECOND);
+
+    // years run from 1 to 9999, so the seconds always fit, only the nanoseconds can overflow
+    epoch_seconds = _ion_timestamp_days_from_civil(year, month, day) * ION_TIMESTAMP_SECONDS_PER_DAY
+                  + (int64_t)hours * 3600 + (int64_t)minutes * 60 + seconds;
+    if (epoch_seconds > (MAX_INT64 - nanos) / ION_TIMESTAMP_NANOS_PER_SECOND
+     || epoch_seconds < (MIN_INT64) / ION_TIMESTAMP_NANOS_PER_SECOND
+    ) {
+        FAILWITH(IERR_NUMERIC_OVERFLOW);
+    }
+    *p_epoch_nanos = epoch_seconds * ION_TIMESTAMP_NANOS_PER_SECOND + nanos;
+
+    iRETURN;
+}
+
+iERR _ion_timestamp_to_epoch_nanos(const ION_TIMESTAMP *ptime, decContext *pcontext, int64_t *p_epoch_nanos,
+                                   int *p_precision, int *p_offset_minutes)
+{
+    iENTER;
+    decQuad  scaled, nanos_per_second;
+    int32_t  nanos = 0;
+    int      offset = 0;
+
+    ASSERT(ptime && pcontext);
+
+    if (IS_FLAG_ON(ptime->precision, ION_TT_BIT_FRAC)) {
+        decQuadFromInt32(&nanos_per_second, ION_TIMESTAMP_NANOS_PER_SECOND);
+        decQuadMultiply(&scaled, &ptime->fraction, &nanos_per_second, pcontext);
+        nanos = decQuadToInt32(&scaled, pcontext, DEC_ROUND_DOWN);
+        if (nanos < 0 || nanos >= ION_TIMESTAMP_NANOS_PER_SECOND) FAILWITH(IERR_INVALID_TIMESTAMP);
+    }
+    if (HAS_TZ_OFFSET(ptime)) {
+        offset = ptime->tz_offset;
+    }
+    // the fields are local time, so the offset comes off the minutes
+    IONCHECK(_ion_timestamp_epoch_nanos_from_fields(ptime->year, ptime->month, ptime->day, ptime->hours,
+                                                    ptime->minutes - offset, ptime->seconds, nanos, p_epoch_nanos));
+    *p_precision = ptime->precision & 0x7f;
+    *p_offset_minutes = HAS_TZ_OFFSET(ptime) ? offset : ION_TIMESTAMP_UNKNOWN_OFFSET;
+
+    iRETURN;
+}
+
+iERR _ion_timestamp_binary_decode_epoch_nanos(BYTE *p, SIZE len, int64_t *p_epoch_nanos, int *p_precision,
+                                              int *p_offset_minutes, BOOL *p_decoded)
+{
+    iENTER;
+    BYTE     *end = p + len;
+    int       b, offset, precision, exponent, year, month = 1, day = 1, hours = 0, minutes = 0, seconds = 0;
+    int32_t   nanos = 0;
+    uint64_t  coefficient, scale;
+    BOOL      has_offset, is_negative;
+    SIZE      coefficient_len, ii;
+
+    ASSERT(p && p_epoch_nanos && p_precision && p_offset_minutes && p_decoded);
+
+    *p_decoded = TRUE;
+
+    // the offset, as a var_int of 1 or 2 bytes, longer (padded) ones are left to the caller
+    if (p >= end) FAILWITH(IERR_INVALID_BINARY);
+    b = *p++;
+    is_negative = (b & 0x40);
+    offset = b & 0x3F;
+    if ((b & 0x80) == 0) {
+        if (p >= end) FAILWITH(IERR_INVALID_BINARY);
+        b = *p++;
+        offset = (offset << 7) + (b & 0x7F);
+        if ((b & 0x80) == 0) {
+            *p_decoded = FALSE;
+            SUCCEED();
+        }
+    }
+    has_offset = !(is_negative && offset == 0);
+    if (is_negative) offset = -offset;
+
+    // the year, as a var_uint of 1 or 2 bytes, the same as the offset
+    if (p >= end) FAILWITH(IERR_INVALID_BINARY);
+    b = *p++;
+    year = b & 0x7F;
+    if ((b & 0x80) == 0) {
+        if (p >= end) FAILWITH(IERR_INVALID_BINARY);
+        b = *p++;
+        year = (year << 7) + (b & 0x7F);
+        if ((b & 0x80) == 0) {
+            *p_decoded = FALSE;
+            SUCCEED();
+        }
+    }
+    if (year < 1 || year > 9999) FAILWITH(IERR_INVALID_BINARY);
+    precision = ION_TS_YEAR;
+
+    // the remaining fields are single byte var_uints, so each has to carry the end bit
+    if (p < end) {
+        b = *p++;
+        if ((b & 0x80) == 0) FAILWITH(IERR_INVALID_BINARY);
+        month = b & 0x7F;
+        precision = ION_TS_MONTH;
+        if (month < 1 || month > 12) FAILWITH(IERR_INVALID_BINARY);
+    }
+    if (p < end) {
+        b = *p++;
+        if ((b & 0x80) == 0) FAILWITH(IERR_INVALID_BINARY);
+        day = b & 0x7F;
+        precision = ION_TS_DAY;
+        if (!_ion_timestamp_is_valid_day(year, month, day)) FAILWITH(IERR_INVALID_BINARY);
+    }
+    if (p < end) {
+        if (end - p < 2) FAILWITH(IERR_INVALID_BINARY);
+        if ((p[0] & 0x80) == 0 || (p[1] & 0x80) == 0) FAILWITH(IERR_INVALID_BINARY);
+        hours = *p++ & 0x7F;
+        minutes = *p++ & 0x7F;
+        precision = ION_TS_MIN;
+        if (hours > 23 || minutes > 59) FAILWITH(IERR_INVALID_BINARY);
+    }
+    if (p < end) {
+        b = *p++;
+        if ((b & 0x80) == 0) FAILWITH(IERR_INVALID_BINARY);
+        seconds = b & 0x7F;
+        precision = ION_TS_SEC;
+        if (seconds > 59) FAILWITH(IERR_INVALID_BINARY);
+    }
+    if (p < end) {
+        // the fraction, a var_int exponent and a signed int coefficient
+        b = *p++;
+        is_negative = (b & 0x40);
+        exponent = b & 0x3F;
+        while ((b & 0x80) == 0) {
+            if (p >= end || exponent > (INT32_MAX >> 7)) FAILWITH(IERR_INVALID_BINARY);
+            b = *p++;
+            exponent = (exponent << 7) + (b & 0x7F);
+        }
+        if (is_negative) exponent = -exponent;
+
+        coefficient_len = (SIZE)(end - p);
+        if (coefficient_len > (SIZE)sizeof(uint64_t)) {
+            *p_decoded = FALSE;
+            SUCCEED();
+        }
+        coefficient = 0;
+        is_negative = FALSE;
+        for (ii = 0; ii < coefficient_len; ii++) {
+            b = p[ii];
+            if (ii == 0) {
+                is_negative = (b & 0x80);
+                b &= 0x7F;
+            }
+            coefficient = (coefficient << 8) | (uint64_t)b;
+        }
+        // negative zero is zero, any other negative fraction is an error
+        if (is_negative && coefficient != 0) FAILWITH(IERR_INVALID_BINARY);
+
+        if (exponent >= 0) {
+            // a zero coefficient with a non negative exponent is ignored
+            if (coefficient != 0) FAILWITH(IERR_INVALID_BINARY);
+        }
+        else {
+            // the fraction has to be less than one, 10^-exponent is bigger than
+            // any coefficient once it runs past 19 digits
+            if (exponent >= -19) {
+                for (scale = 1, ii = 0; ii < -exponent; ii++) scale *= 10;
+                if (coefficient >= scale) FAILWITH(IERR_INVALID_BINARY);
+            }
+            if (exponent >= -9) {
+                for (scale = 1, ii = 0; ii < 9 + exponent; ii++) scale *= 10;
+                nanos = (int32_t)(coefficient * scale);
+            }
+            else if (exponent >= -28) {
+                for (scale = 1, ii = 0; ii < -exponent - 9; ii++) scale *= 10;
+                nanos = (int32_t)(coefficient / scale);
+            }
+            precision = ION_TS_FRAC;
+        }
+    }
+
+    // binary timestamps hold UTC fields, the offset is only for presentation
+    // and doesn't exist for values with less than minute precision
+    if (!IS_FLAG_ON(precision, ION_TT_BIT_MIN)) has_offset = FALSE;
+    IONCHECK(_ion_timestamp_epoch_nanos_from_fields(year, month, day, hours, minutes, seconds, nanos, p_epoch_nanos));
+    *p_precision = precision;
+    *p_offset_minutes = has_offset ? offset : ION_TIMESTAMP_UNKNOWN_OFFSET;
+
+    iRETURN;
+}
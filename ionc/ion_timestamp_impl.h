@@ -30,6 +30,21 @@ extern "C" {
 #define ION_TIMESTAMP_NULL_OFFSET_IMAGE     "-00:00"
 #define ION_TIMESTAMP_NULL_OFFSET_IMAGE_LEN 6
 
+// the longest string the fixed layout formatter writes, YYYY-MM-DDThh:mm:ss.fffffffff+hh:mm,
+// and the shortest one the fixed layout parser reads, YYYY-MM-DDThh:mm:ssZ
+#define ION_TIMESTAMP_FAST_STRING_LENGTH    35
+#define ION_TIMESTAMP_FAST_MIN_LENGTH       20
+
+// words of 8 characters with the first character in the low byte: the
+// digit bytes and separators of "YYYY-MM-" and "DDThh:mm"
+#define ION_TIMESTAMP_WORD_ZEROS            0x3030303030303030ULL
+#define ION_TIMESTAMP_WORD_SIXES            0x0606060606060606ULL
+#define ION_TIMESTAMP_WORD_HIGH_NIBBLES     0xF0F0F0F0F0F0F0F0ULL
+#define ION_TIMESTAMP_DATE_DIGITS           0x00FFFF00FFFFFFFFULL
+#define ION_TIMESTAMP_DATE_SEPARATORS       0x2D00002D00000000ULL
+#define ION_TIMESTAMP_TIME_DIGITS           0xFFFF00FFFF00FFFFULL
+#define ION_TIMESTAMP_TIME_SEPARATORS       0x00003A0000540000ULL
+
 #define ION_TS_NULL      0x00
 #define ION_TT_BIT_TZ    0x80
 #define ION_TS_SUB_DATE  (ION_TT_BIT_MIN | ION_TT_BIT_SEC | ION_TT_BIT_FRAC)
@@ -110,6 +125,43 @@ iERR _ion_timestamp_to_utc(const ION_TIMESTAMP *ptime, ION_TIMESTAMP *pout);
  */
 iERR _ion_timestamp_validate_fraction(decQuad *p_fraction, decContext *pcontext, iERR error_code);
 
+#define ION_TIMESTAMP_NANOS_PER_SECOND 1000000000
+#define ION_TIMESTAMP_SECONDS_PER_DAY  86400
+
+/**
+ * Days since 1970-01-01 of the given proleptic Gregorian date, and back.
+ */
+int64_t _ion_timestamp_days_from_civil(int year, int month, int day);
+void    _ion_timestamp_civil_from_days(int64_t days, int *p_year, int *p_month, int *p_day);
+
+/**
+ * Sets the date and time fields of ptime, through seconds, to the instant epoch_seconds. The precision, offset
+ * and fraction are left alone.
+ */
+void _ion_timestamp_set_epoch_seconds(ION_TIMESTAMP *ptime, int64_t epoch_seconds);
+
+/**
+ * Nanoseconds since 1970-01-01T00:00Z of the given UTC date and time.
+ * @return IERR_NUMERIC_OVERFLOW if the instant does not fit in an int64_t.
+ */
+iERR _ion_timestamp_epoch_nanos_from_fields(int year, int month, int day, int hours, int minutes, int seconds,
+                                            int32_t nanos, int64_t *p_epoch_nanos);
+
+/**
+ * Converts ptime to nanoseconds since the epoch, its precision and its local offset (ION_TIMESTAMP_UNKNOWN_OFFSET if
+ * it has none). Fractions finer than a nanosecond are truncated.
+ */
+iERR _ion_timestamp_to_epoch_nanos(const ION_TIMESTAMP *ptime, decContext *pcontext, int64_t *p_epoch_nanos,
+                                   int *p_precision, int *p_offset_minutes);
+
+/**
+ * Decodes the len bytes of a binary timestamp at p the way ion_timestamp_binary_read does, straight to nanoseconds
+ * since the epoch. If the offset or year is padded past 2 bytes, or the fraction's coefficient is longer than 8 bytes,
+ * *p_decoded is set to FALSE and nothing else is set, and the caller reads the value through an ION_TIMESTAMP instead.
+ */
+iERR _ion_timestamp_binary_decode_epoch_nanos(BYTE *p, SIZE len, int64_t *p_epoch_nanos, int *p_precision,
+                                              int *p_offset_minutes, BOOL *p_decoded);
+
 #ifdef __cplusplus
 }
 #endif
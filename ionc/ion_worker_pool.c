@@ -0,0 +1,128 @@
+/*
+ * Copyright 2012-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at:
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ */
+
+#include "ion_internal.h"
+#include "ion_worker_pool.h"
+
+#ifdef ION_PLATFORM_WINDOWS
+    #include <windows.h>
+    typedef HANDLE ION_WORKER_THREAD;
+#else
+    #include <pthread.h>
+    #include <unistd.h>
+    typedef pthread_t ION_WORKER_THREAD;
+#endif
+
+typedef struct _ion_worker {
+    ION_WORKER_FN       fn;
+    void               *context;
+    int                 worker_id;
+    iERR                err;
+    ION_WORKER_THREAD   thread;
+    BOOL                started;
+} ION_WORKER;
+
+#ifdef ION_PLATFORM_WINDOWS
+static DWORD WINAPI _ion_worker_pool_thread_main(LPVOID arg)
+#else
+static void *_ion_worker_pool_thread_main(void *arg)
+#endif
+{
+    ION_WORKER *worker = (ION_WORKER *)arg;
+    worker->err = worker->fn(worker->context, worker->worker_id);
+    return 0;
+}
+
+int _ion_worker_pool_default_size(void)
+{
+    long count;
+#ifdef ION_PLATFORM_WINDOWS
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    count = (long)info.dwNumberOfProcessors;
+#else
+    count = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return (count < 1) ? 1 : (int)count;
+}
+
+long _ion_worker_counter_claim(ION_WORKER_COUNTER *counter)
+{
+#ifdef ION_PLATFORM_WINDOWS
+    return InterlockedIncrement(&counter->next) - 1;
+#else
+    return __sync_fetch_and_add(&counter->next, 1);
+#endif
+}
+
+iERR _ion_worker_pool_run(int num_workers, ION_WORKER_FN fn, void *context)
+{
+    iENTER;
+    ION_WORKER *workers = NULL;
+    int         ii;
+
+    ASSERT(fn);
+
+    if (num_workers < 1) FAILWITH(IERR_INVALID_ARG);
+    if (num_workers == 1) {
+        // No need for any threads at all.
+        IONCHECK(fn(context, 0));
+        SUCCEED();
+    }
+
+    workers = (ION_WORKER *)ion_xalloc(num_workers * sizeof(ION_WORKER));
+    if (!workers) FAILWITH(IERR_NO_MEMORY);
+    memset(workers, 0, num_workers * sizeof(ION_WORKER));
+
+    for (ii = 0; ii < num_workers; ii++) {
+        workers[ii].fn = fn;
+        workers[ii].context = context;
+        workers[ii].worker_id = ii;
+    }
+
+    // Worker 0 runs on the calling thread, so only num_workers - 1 threads are started. If a thread can't be
+    // started the remaining work is still drained by the workers that did start, since they claim work items
+    // from a shared counter.
+    for (ii = 1; ii < num_workers; ii++) {
+#ifdef ION_PLATFORM_WINDOWS
+        workers[ii].thread = CreateThread(NULL, 0, _ion_worker_pool_thread_main, &workers[ii], 0, NULL);
+        workers[ii].started = (workers[ii].thread != NULL);
+#else
+        workers[ii].started = (pthread_create(&workers[ii].thread, NULL, _ion_worker_pool_thread_main, &workers[ii]) == 0);
+#endif
+        if (!workers[ii].started) break;
+    }
+
+    _ion_worker_pool_thread_main(&workers[0]);
+
+    for (ii = 1; ii < num_workers; ii++) {
+        if (!workers[ii].started) continue;
+#ifdef ION_PLATFORM_WINDOWS
+        WaitForSingleObject(workers[ii].thread, INFINITE);
+        CloseHandle(workers[ii].thread);
+#else
+        pthread_join(workers[ii].thread, NULL);
+#endif
+    }
+
+    for (ii = 0; ii < num_workers; ii++) {
+        UPDATEERROR(workers[ii].err);
+    }
+
+fail:
+    if (workers) {
+        ion_xfree(workers);
+    }
+    RETURN(__location_name__, __line__, __count__++, err);
+}
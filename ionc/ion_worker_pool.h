@@ -0,0 +1,64 @@
+/*
+ * Copyright 2012-2017 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License").
+ * You may not use this file except in compliance with the License.
+ * A copy of the License is located at:
+ *
+ *     http://aws.amazon.com/apache2.0/
+ *
+ * or in the "license" file accompanying this file. This file is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ */
+
+//
+// Minimal fork/join worker support used by the batch APIs. Ion readers and writers are single-threaded objects; the
+// batch APIs give each worker its own reader or writer and use this only to fan work out and join it back.
+//
+
+#ifndef ION_WORKER_POOL_H_
+#define ION_WORKER_POOL_H_
+
+#include <ionc/ion_types.h>
+#include <ionc/ion_platform_config.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The body run by each worker. `worker_id` is in [0, num_workers).
+ */
+typedef iERR (*ION_WORKER_FN)(void *context, int worker_id);
+
+/**
+ * A work item counter shared by all workers of one run. Workers claim items by index until the counter passes the
+ * number of items, which balances uneven item sizes without any up-front partitioning.
+ */
+typedef struct _ion_worker_counter {
+    volatile long next;
+} ION_WORKER_COUNTER;
+
+/**
+ * Returns the number of workers to use when the caller does not specify one: the number of online processors,
+ * or 1 if that cannot be determined.
+ */
+int  _ion_worker_pool_default_size(void);
+
+/**
+ * Runs `fn` on `num_workers` workers and waits for all of them to finish. Worker 0 runs on the calling thread.
+ * Returns the error of the lowest-numbered worker that failed, or IERR_OK.
+ */
+iERR _ion_worker_pool_run(int num_workers, ION_WORKER_FN fn, void *context);
+
+/**
+ * Atomically claims the next work item index from the counter.
+ */
+long _ion_worker_counter_claim(ION_WORKER_COUNTER *counter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ION_WORKER_POOL_H_ */
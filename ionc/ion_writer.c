@@ -19,6 +19,7 @@
 
 #include "ion_internal.h"
 #include "ion_writer_impl.h"
+#include "ion_worker_pool.h"
 
 #define IONCLOSEpWRITER(x)   { if (x != NULL)  { UPDATEERROR(_ion_writer_close_helper(x)); x = NULL;}}
 
@@ -207,6 +208,7 @@ iERR _ion_writer_initialize_local_symbol_table(ION_WRITER *pwriter)
     ASSERT( pwriter->symbol_table == NULL || pwriter->symbol_table == system );
 
     IONCHECK(_ion_symbol_table_open_helper(&pwriter->symbol_table, pwriter->_temp_entity_pool, system));
+    pwriter->_symbol_table_epoch++;
 
     ION_COLLECTION_OPEN(&pwriter->_imported_symbol_tables, import_cursor);
     for (;;) {
@@ -264,6 +266,12 @@ iERR _ion_writer_open_helper(ION_WRITER **p_pwriter, ION_STREAM *stream, ION_WRI
     }
     _ion_writer_initialize_option_defaults(&(pwriter->options));
 
+    // the reserve is written as a nop pad, so it has to hold at least the pad's type descriptor
+    if (p_options && p_options->output_as_binary && pwriter->options.patch_lengths_in_output
+        && pwriter->options.symbol_table_reserve < ION_BINARY_TYPE_DESC_LENGTH) {
+        FAILWITH(IERR_INVALID_ARG);
+    }
+
     // initialize decimal context
     if (pwriter->options.decimal_context == NULL) {
         decContextDefault(&pwriter->deccontext, DEC_INIT_DECQUAD);
@@ -359,6 +367,11 @@ void _ion_writer_initialize_option_defaults(ION_WRITER_OPTIONS *p_options)
         p_options->allocation_page_size = DEFAULT_BLOCK_SIZE;
     }
 
+    // room for the local symbol table in front of containers written straight to the output, default is 4096
+    if (!p_options->symbol_table_reserve) {
+        p_options->symbol_table_reserve = ION_WRITER_SYMBOL_TABLE_RESERVE_DEFAULT;
+    }
+
     return;
 }
 
@@ -606,6 +619,7 @@ iERR _ion_writer_set_symbol_table_helper(ION_WRITER *pwriter, ION_SYMBOL_TABLE *
     }
 
     pwriter->symbol_table = psymtab;
+    pwriter->_symbol_table_epoch++;
 
     iRETURN;
 }
@@ -1215,6 +1229,295 @@ iERR _ion_writer_add_annotation_symbol_helper(ION_WRITER *pwriter, ION_SYMBOL *a
     iRETURN;
 }
 
+iERR ion_writer_intern_symbol(hWRITER hwriter, iSTRING text, hSYMBOLREF *p_ref)
+{
+    iENTER;
+    ION_WRITER            *pwriter;
+    ION_WRITER_SYMBOL_REF *ref;
+
+    if (!hwriter) FAILWITH(IERR_BAD_HANDLE);
+    pwriter = HANDLE_TO_PTR(hwriter, ION_WRITER);
+    if (!text || ION_STRING_IS_NULL(text) || text->length < 0) FAILWITH(IERR_INVALID_ARG);
+    if (!p_ref) FAILWITH(IERR_INVALID_ARG);
+
+    // the writer owns the reference, so it lives as long as the writer does
+    ref = (ION_WRITER_SYMBOL_REF *)ion_alloc_with_owner(pwriter, sizeof(ION_WRITER_SYMBOL_REF));
+    if (!ref) FAILWITH(IERR_NO_MEMORY);
+    IONCHECK(_ion_writer_init_symbol_ref_helper(pwriter, ref, text));
+
+    *p_ref = PTR_TO_HANDLE(ref);
+
+    iRETURN;
+}
+
+iERR _ion_writer_init_symbol_ref_helper(ION_WRITER *pwriter, ION_WRITER_SYMBOL_REF *ref, ION_STRING *text)
+{
+    iENTER;
+
+    ASSERT(pwriter);
+    ASSERT(ref);
+
+    ION_STRING_INIT(&ref->_text);
+    IONCHECK(ion_strdup(pwriter, &ref->_text, text));
+    ref->_sid = UNKNOWN_SID;
+    ref->_is_local = FALSE;
+    ref->_epoch = 0;
+
+    iRETURN;
+}
+
+iERR _ion_writer_symbol_ref_as_sid_helper(ION_WRITER *pwriter, ION_WRITER_SYMBOL_REF *ref, SID *p_sid)
+{
+    iENTER;
+    ION_SYMBOL_TABLE *system;
+    SID               max_id;
+
+    ASSERT(pwriter);
+    ASSERT(ref);
+    ASSERT(p_sid);
+
+    if (ref->_sid <= UNKNOWN_SID || ref->_epoch != pwriter->_symbol_table_epoch) {
+        IONCHECK(_ion_writer_make_symbol_helper(pwriter, &ref->_text, &ref->_sid));
+        IONCHECK(_ion_symbol_table_get_system_symbol_helper(&system, ION_SYSTEM_VERSION));
+        IONCHECK(_ion_symbol_table_get_max_sid_helper(system, &max_id));
+        ref->_is_local = (ref->_sid > max_id);
+        ref->_epoch = pwriter->_symbol_table_epoch;
+    }
+    else if (ref->_is_local) {
+        // make_symbol would have noted this, the table may have been written since
+        pwriter->_has_local_symbols = TRUE;
+    }
+    *p_sid = ref->_sid;
+
+    iRETURN;
+}
+
+iERR ion_writer_write_field_name_ref(hWRITER hwriter, hSYMBOLREF ref)
+{
+    iENTER;
+    ION_WRITER            *pwriter;
+    ION_WRITER_SYMBOL_REF *pref;
+
+    if (!hwriter) FAILWITH(IERR_BAD_HANDLE);
+    pwriter = HANDLE_TO_PTR(hwriter, ION_WRITER);
+    if (!ref) FAILWITH(IERR_INVALID_ARG);
+    pref = HANDLE_TO_PTR(ref, ION_WRITER_SYMBOL_REF);
+
+    // text writers write the text anyway, and symbol tables being written
+    // by hand look at the field names, both take the usual path
+    if (pwriter->type != ion_type_binary_writer || pwriter->_current_symtab_intercept_state != iWSIS_NONE) {
+        IONCHECK(ion_writer_write_field_name(hwriter, &pref->_text));
+        SUCCEED();
+    }
+    if (!pwriter->_in_struct) FAILWITH(IERR_INVALID_STATE);
+
+    IONCHECK(_ion_writer_symbol_ref_as_sid_helper(pwriter, pref, &pwriter->field_name.sid));
+    ION_STRING_INIT(&pwriter->field_name.value);
+
+    iRETURN;
+}
+
+iERR ion_writer_add_annotation_ref(hWRITER hwriter, hSYMBOLREF ref)
+{
+    iENTER;
+    ION_WRITER            *pwriter;
+    ION_WRITER_SYMBOL_REF *pref;
+    ION_SYMBOL            *annotation_symbol;
+    SID                    sid;
+
+    if (!hwriter) FAILWITH(IERR_BAD_HANDLE);
+    pwriter = HANDLE_TO_PTR(hwriter, ION_WRITER);
+    if (!ref) FAILWITH(IERR_INVALID_ARG);
+    pref = HANDLE_TO_PTR(ref, ION_WRITER_SYMBOL_REF);
+
+    if (pwriter->type != ion_type_binary_writer || pwriter->_current_symtab_intercept_state != iWSIS_NONE) {
+        IONCHECK(ion_writer_add_annotation(hwriter, &pref->_text));
+        SUCCEED();
+    }
+
+    if (!pwriter->annotations) {
+        IONCHECK(_ion_writer_set_max_annotation_count_helper(pwriter, DEFAULT_ANNOTATION_LIMIT));
+    }
+    else if (pwriter->annotation_curr >= pwriter->annotation_count) FAILWITH(IERR_TOO_MANY_ANNOTATIONS);
+
+    IONCHECK(_ion_writer_symbol_ref_as_sid_helper(pwriter, pref, &sid));
+
+    annotation_symbol = &pwriter->annotations[pwriter->annotation_curr];
+    ION_STRING_INIT(&annotation_symbol->value);
+    annotation_symbol->sid = sid;
+    annotation_symbol->add_count = 0;
+    ION_STRING_INIT(&annotation_symbol->import_location.name);
+    annotation_symbol->import_location.location = UNKNOWN_SID;
+
+    pwriter->annotation_curr++;
+
+    iRETURN;
+}
+
+iERR ion_writer_write_symbol_ref(hWRITER hwriter, hSYMBOLREF ref)
+{
+    iENTER;
+    ION_WRITER            *pwriter;
+    ION_WRITER_SYMBOL_REF *pref;
+    SID                    sid;
+
+    if (!hwriter) FAILWITH(IERR_BAD_HANDLE);
+    pwriter = HANDLE_TO_PTR(hwriter, ION_WRITER);
+    if (!ref) FAILWITH(IERR_INVALID_ARG);
+    pref = HANDLE_TO_PTR(ref, ION_WRITER_SYMBOL_REF);
+
+    if (pwriter->type != ion_type_binary_writer || pwriter->_current_symtab_intercept_state != iWSIS_NONE) {
+        IONCHECK(ion_writer_write_symbol(hwriter, &pref->_text));
+        SUCCEED();
+    }
+
+    IONCHECK(_ion_writer_symbol_ref_as_sid_helper(pwriter, pref, &sid));
+    IONCHECK(_ion_writer_binary_write_symbol_id(pwriter, sid));
+
+    iRETURN;
+}
+
+iERR ion_writer_create_template(hWRITER hwriter, ION_STRING *field_names, ION_TYPE *field_types, SIZE field_count,
+                                hTEMPLATE *p_template)
+{
+    iENTER;
+    ION_WRITER                *pwriter;
+    ION_WRITER_TEMPLATE       *tmpl;
+    ION_WRITER_TEMPLATE_FIELD *field;
+    SIZE                       ii;
+
+    if (!hwriter) FAILWITH(IERR_BAD_HANDLE);
+    pwriter = HANDLE_TO_PTR(hwriter, ION_WRITER);
+    if (field_count < 0) FAILWITH(IERR_INVALID_ARG);
+    if (field_count > 0 && (!field_names || !field_types)) FAILWITH(IERR_INVALID_ARG);
+    if (!p_template) FAILWITH(IERR_INVALID_ARG);
+
+    for (ii = 0; ii < field_count; ii++) {
+        if (ION_STRING_IS_NULL(&field_names[ii]) || field_names[ii].length < 0) FAILWITH(IERR_INVALID_ARG);
+        switch ((intptr_t)field_types[ii]) {
+        case (intptr_t)tid_BOOL:
+        case (intptr_t)tid_INT:
+        case (intptr_t)tid_FLOAT:
+        case (intptr_t)tid_DECIMAL:
+        case (intptr_t)tid_TIMESTAMP:
+        case (intptr_t)tid_SYMBOL:
+        case (intptr_t)tid_STRING:
+        case (intptr_t)tid_CLOB:
+        case (intptr_t)tid_BLOB:
+            break;
+        default:
+            FAILWITH(IERR_INVALID_ARG);
+        }
+    }
+
+    // like symbol references, the template lives as long as the writer does
+    tmpl = (ION_WRITER_TEMPLATE *)ion_alloc_with_owner(pwriter, sizeof(ION_WRITER_TEMPLATE));
+    if (!tmpl) FAILWITH(IERR_NO_MEMORY);
+    tmpl->_field_count = field_count;
+    tmpl->_fields = NULL;
+    tmpl->_encoded = FALSE;
+    tmpl->_has_local_names = FALSE;
+    tmpl->_epoch = 0;
+    if (field_count > 0) {
+        tmpl->_fields = (ION_WRITER_TEMPLATE_FIELD *)ion_alloc_with_owner(pwriter,
+                                                         field_count * sizeof(ION_WRITER_TEMPLATE_FIELD));
+        if (!tmpl->_fields) FAILWITH(IERR_NO_MEMORY);
+    }
+
+    for (ii = 0; ii < field_count; ii++) {
+        field = &tmpl->_fields[ii];
+        IONCHECK(_ion_writer_init_symbol_ref_helper(pwriter, &field->_name, &field_names[ii]));
+        field->_type = field_types[ii];
+        // an int's type descriptor depends on its sign, the positive one stands in
+        field->_tid = (BYTE)ion_helper_get_tid_from_ion_type(field_types[ii]);
+        field->_sid_length = 0;
+    }
+
+    *p_template = PTR_TO_HANDLE(tmpl);
+
+    iRETURN;
+}
+
+iERR _ion_writer_write_template_field_helper(hWRITER hwriter, ION_WRITER_TEMPLATE_FIELD *field,
+                                             ION_WRITER_TEMPLATE_VALUE *value)
+{
+    iENTER;
+
+    ASSERT(field);
+    ASSERT(value);
+
+    IONCHECK(ion_writer_write_field_name_ref(hwriter, PTR_TO_HANDLE(&field->_name)));
+    if (value->is_null) {
+        IONCHECK(ion_writer_write_typed_null(hwriter, field->_type));
+        SUCCEED();
+    }
+
+    switch ((intptr_t)field->_type) {
+    case (intptr_t)tid_BOOL:
+        IONCHECK(ion_writer_write_bool(hwriter, value->value.bool_value));
+        break;
+    case (intptr_t)tid_INT:
+        IONCHECK(ion_writer_write_int64(hwriter, value->value.int_value));
+        break;
+    case (intptr_t)tid_FLOAT:
+        IONCHECK(ion_writer_write_double(hwriter, value->value.float_value));
+        break;
+    case (intptr_t)tid_DECIMAL:
+        IONCHECK(ion_writer_write_ion_decimal(hwriter, value->value.decimal_value));
+        break;
+    case (intptr_t)tid_TIMESTAMP:
+        IONCHECK(ion_writer_write_timestamp(hwriter, value->value.timestamp_value));
+        break;
+    case (intptr_t)tid_SYMBOL:
+        IONCHECK(ion_writer_write_symbol(hwriter, &value->value.string_value));
+        break;
+    case (intptr_t)tid_STRING:
+        IONCHECK(ion_writer_write_string(hwriter, &value->value.string_value));
+        break;
+    case (intptr_t)tid_CLOB:
+        IONCHECK(ion_writer_write_clob(hwriter, value->value.string_value.value, value->value.string_value.length));
+        break;
+    case (intptr_t)tid_BLOB:
+        IONCHECK(ion_writer_write_blob(hwriter, value->value.string_value.value, value->value.string_value.length));
+        break;
+    default:
+        FAILWITH(IERR_INVALID_ARG);
+    }
+
+    iRETURN;
+}
+
+iERR ion_writer_write_template_row(hWRITER hwriter, hTEMPLATE tmpl, ION_WRITER_TEMPLATE_VALUE *values)
+{
+    iENTER;
+    ION_WRITER          *pwriter;
+    ION_WRITER_TEMPLATE *ptmpl;
+    SIZE                 ii;
+
+    if (!hwriter) FAILWITH(IERR_BAD_HANDLE);
+    pwriter = HANDLE_TO_PTR(hwriter, ION_WRITER);
+    if (!tmpl) FAILWITH(IERR_INVALID_ARG);
+    ptmpl = HANDLE_TO_PTR(tmpl, ION_WRITER_TEMPLATE);
+    if (ptmpl->_field_count > 0 && !values) FAILWITH(IERR_INVALID_ARG);
+
+    IONCHECK(ion_writer_start_container(hwriter, tid_STRUCT));
+
+    // a struct that turned out to be a symbol table is intercepted, its
+    // fields have to go through the usual calls
+    if (pwriter->type == ion_type_binary_writer && pwriter->_current_symtab_intercept_state == iWSIS_NONE) {
+        IONCHECK(_ion_writer_binary_write_template_row(pwriter, ptmpl, values));
+    }
+    else {
+        for (ii = 0; ii < ptmpl->_field_count; ii++) {
+            IONCHECK(_ion_writer_write_template_field_helper(hwriter, &ptmpl->_fields[ii], &values[ii]));
+        }
+    }
+
+    IONCHECK(ion_writer_finish_container(hwriter));
+
+    iRETURN;
+}
+
 iERR ion_writer_write_annotations(hWRITER hwriter, iSTRING p_annotations, int32_t count)
 {
     iENTER;
@@ -1743,6 +2046,32 @@ iERR _ion_writer_write_ion_decimal_helper(ION_WRITER *pwriter, ION_DECIMAL *valu
     iRETURN;
 }
 
+iERR ion_writer_write_decimal_parts(hWRITER hwriter, int64_t mantissa, int32_t exponent)
+{
+    iENTER;
+    ION_WRITER *pwriter;
+    BOOL        is_negative = (mantissa < 0);
+    uint64_t    magnitude = is_negative ? 0 - (uint64_t)mantissa : (uint64_t)mantissa;
+
+    if (!hwriter)   FAILWITH(IERR_BAD_HANDLE);
+    pwriter = HANDLE_TO_PTR(hwriter, ION_WRITER);
+
+    ION_WRITER_SYMTAB_INTERCEPT_IGNORE(pwriter);
+
+    switch (pwriter->type) {
+    case ion_type_text_writer:
+        IONCHECK(_ion_writer_text_write_decimal_parts(pwriter, mantissa, exponent));
+        break;
+    case ion_type_binary_writer:
+        IONCHECK(_ion_writer_binary_write_decimal_small(pwriter, magnitude, exponent, is_negative));
+        break;
+    default:
+        FAILWITH(IERR_INVALID_ARG);
+    }
+
+    iRETURN;
+}
+
 iERR ion_writer_write_timestamp(hWRITER hwriter, iTIMESTAMP value)
 {
     iENTER;
@@ -1778,6 +2107,77 @@ iERR _ion_writer_write_timestamp_helper(ION_WRITER *pwriter, ION_TIMESTAMP *valu
     iRETURN;
 }
 
+iERR ion_writer_write_timestamp_epoch_nanos(hWRITER hwriter, int64_t epoch_nanos, int precision, int offset_minutes)
+{
+    iENTER;
+    ION_WRITER   *pwriter;
+    ION_TIMESTAMP timestamp;
+    int64_t       epoch_seconds;
+    int32_t       nanos, exponent;
+    uint64_t      mantissa;
+    BOOL          has_offset;
+
+    if (!hwriter) FAILWITH(IERR_BAD_HANDLE);
+    pwriter = HANDLE_TO_PTR(hwriter, ION_WRITER);
+
+    switch (precision) {
+    case ION_TS_YEAR:
+    case ION_TS_MONTH:
+    case ION_TS_DAY:
+    case ION_TS_MIN:
+    case ION_TS_SEC:
+    case ION_TS_FRAC:
+        break;
+    default:
+        FAILWITH(IERR_INVALID_ARG);
+    }
+    has_offset = (offset_minutes != ION_TIMESTAMP_UNKNOWN_OFFSET);
+    if (has_offset && (offset_minutes <= -24 * 60 || offset_minutes >= 24 * 60)) FAILWITH(IERR_INVALID_ARG);
+    // timestamps with less than minute precision have no offset
+    has_offset = has_offset && IS_FLAG_ON(precision, ION_TT_BIT_MIN);
+
+    ION_WRITER_SYMTAB_INTERCEPT_IGNORE(pwriter);
+
+    epoch_seconds = epoch_nanos / ION_TIMESTAMP_NANOS_PER_SECOND;
+    nanos = (int32_t)(epoch_nanos % ION_TIMESTAMP_NANOS_PER_SECOND);
+    if (nanos < 0) {
+        epoch_seconds--;
+        nanos += ION_TIMESTAMP_NANOS_PER_SECOND;
+    }
+
+    // the fraction gets 3, 6 or 9 digits, the fewest that hold it exactly
+    mantissa = (uint64_t)nanos;
+    exponent = -9;
+    while (exponent < -3 && mantissa % 1000 == 0) {
+        mantissa /= 1000;
+        exponent += 3;
+    }
+
+    IONCHECK(_ion_timestamp_initialize(&timestamp));
+    timestamp.precision = (uint8_t)precision;
+    if (has_offset) {
+        SET_FLAG_ON(timestamp.precision, ION_TT_BIT_TZ);
+        timestamp.tz_offset = (int16_t)offset_minutes;
+    }
+
+    if (pwriter->type == ion_type_binary_writer) {
+        // binary timestamps hold the UTC fields and an integer fraction, so
+        // there is no local time or decQuad to compute
+        _ion_timestamp_set_epoch_seconds(&timestamp, epoch_seconds);
+        IONCHECK(_ion_writer_binary_write_timestamp_epoch(pwriter, &timestamp, mantissa, exponent));
+        SUCCEED();
+    }
+
+    _ion_timestamp_set_epoch_seconds(&timestamp, epoch_seconds + (has_offset ? offset_minutes * 60 : 0));
+    if (IS_FLAG_ON(precision, ION_TT_BIT_FRAC)) {
+        decQuadFromUInt32(&timestamp.fraction, (uint32_t)mantissa);
+        decQuadSetExponent(&timestamp.fraction, &pwriter->deccontext, exponent);
+    }
+    IONCHECK(_ion_writer_write_timestamp_helper(pwriter, &timestamp));
+
+    iRETURN;
+}
+
 iERR _ion_writer_validate_symbol_id(ION_WRITER *pwriter, SID sid)
 {
     iENTER;
@@ -2096,6 +2496,80 @@ iERR _ion_writer_write_blob_helper(ION_WRITER *pwriter, BYTE *p_buf, SIZE length
     iRETURN;
 }
 
+iERR ion_writer_write_int64_list(hWRITER hwriter, int64_t *values, SIZE count)
+{
+    iENTER;
+    ION_WRITER *pwriter;
+    SIZE        ii;
+
+    if (!hwriter) FAILWITH(IERR_BAD_HANDLE);
+    pwriter = HANDLE_TO_PTR(hwriter, ION_WRITER);
+    if (count < 0 || (count > 0 && !values)) FAILWITH(IERR_INVALID_ARG);
+
+    if (pwriter->type == ion_type_binary_writer && pwriter->_current_symtab_intercept_state == iWSIS_NONE) {
+        IONCHECK(_ion_writer_binary_write_int64_list(pwriter, values, count));
+        SUCCEED();
+    }
+
+    IONCHECK(ion_writer_start_container(hwriter, tid_LIST));
+    for (ii = 0; ii < count; ii++) {
+        IONCHECK(ion_writer_write_int64(hwriter, values[ii]));
+    }
+    IONCHECK(ion_writer_finish_container(hwriter));
+
+    iRETURN;
+}
+
+iERR ion_writer_write_double_list(hWRITER hwriter, double *values, SIZE count)
+{
+    iENTER;
+    ION_WRITER *pwriter;
+    SIZE        ii;
+
+    if (!hwriter) FAILWITH(IERR_BAD_HANDLE);
+    pwriter = HANDLE_TO_PTR(hwriter, ION_WRITER);
+    if (count < 0 || (count > 0 && !values)) FAILWITH(IERR_INVALID_ARG);
+
+    if (pwriter->type == ion_type_binary_writer && pwriter->_current_symtab_intercept_state == iWSIS_NONE) {
+        IONCHECK(_ion_writer_binary_write_double_list(pwriter, values, count));
+        SUCCEED();
+    }
+
+    IONCHECK(ion_writer_start_container(hwriter, tid_LIST));
+    for (ii = 0; ii < count; ii++) {
+        IONCHECK(ion_writer_write_double(hwriter, values[ii]));
+    }
+    IONCHECK(ion_writer_finish_container(hwriter));
+
+    iRETURN;
+}
+
+iERR ion_writer_write_string_list(hWRITER hwriter, ION_STRING *values, SIZE count)
+{
+    iENTER;
+    ION_WRITER *pwriter;
+    SIZE        ii;
+
+    if (!hwriter) FAILWITH(IERR_BAD_HANDLE);
+    pwriter = HANDLE_TO_PTR(hwriter, ION_WRITER);
+    if (count < 0 || (count > 0 && !values)) FAILWITH(IERR_INVALID_ARG);
+
+    // the symbols list of a symbol table being written by hand is a list of
+    // strings too, the intercept has to see each of them
+    if (pwriter->type == ion_type_binary_writer && pwriter->_current_symtab_intercept_state == iWSIS_NONE) {
+        IONCHECK(_ion_writer_binary_write_string_list(pwriter, values, count));
+        SUCCEED();
+    }
+
+    IONCHECK(ion_writer_start_container(hwriter, tid_LIST));
+    for (ii = 0; ii < count; ii++) {
+        IONCHECK(ion_writer_write_string(hwriter, &values[ii]));
+    }
+    IONCHECK(ion_writer_finish_container(hwriter));
+
+    iRETURN;
+}
+
 iERR ion_writer_start_lob(hWRITER hwriter, ION_TYPE lob_type)
 {
     iENTER;
@@ -2383,6 +2857,7 @@ iERR _ion_writer_transition_from_symtab_intercept_state(ION_WRITER *pwriter)
                     ASSERT(pwriter->_temp_entity_pool == NULL && pwriter->_pending_temp_entity_pool != NULL);
                     pwriter->_temp_entity_pool = pwriter->_pending_temp_entity_pool;
                     pwriter->symbol_table = pwriter->_pending_symbol_table;
+                    pwriter->_symbol_table_epoch++;
                 }
                 pwriter->_pending_temp_entity_pool = NULL;
                 pwriter->_pending_symbol_table = NULL;
@@ -2749,6 +3224,184 @@ iERR ion_writer_finish(hWRITER hwriter, SIZE *p_bytes_flushed)
     iRETURN;
 }
 
+/**
+ * Shared state for one call to `ion_writer_write_batch`. Everything but `_counter` and `_abort` is read-only while the
+ * workers run; each segment's stream and result slot are written only by the worker that claimed it. Segments skipped
+ * after a failure keep a null stream and IERR_OK.
+ */
+typedef struct _ion_writer_batch {
+    ION_WRITER_OPTIONS          _writer_options;
+    ION_WRITER_BATCH_CALLBACK   _callback;
+    void                       *_user_context;
+    SIZE                        _value_count;
+    SIZE                        _values_per_segment;
+    SIZE                        _segment_count;
+    ION_STREAM                **_segments;
+    iERR                       *_results;
+    ION_WORKER_COUNTER          _counter;
+    volatile BOOL               _abort;
+} ION_WRITER_BATCH;
+
+iERR _ion_writer_write_batch_segment(ION_WRITER_BATCH *batch, SIZE segment, ION_STREAM **p_stream)
+{
+    iENTER;
+    ION_STREAM *stream = NULL;
+    hWRITER     writer = NULL;
+    SIZE        index, limit;
+
+    IONCHECK(ion_stream_open_memory_only(&stream));
+    IONCHECK(ion_writer_open(&writer, stream, &batch->_writer_options));
+
+    index = segment * batch->_values_per_segment;
+    limit = index + batch->_values_per_segment;
+    if (limit > batch->_value_count) {
+        limit = batch->_value_count;
+    }
+    for (; index < limit; index++) {
+        IONCHECK(batch->_callback(writer, batch->_user_context, index));
+        if (HANDLE_TO_PTR(writer, ION_WRITER)->depth != 0) {
+            FAILWITHMSG(IERR_INVALID_STATE, "Batch callback must leave the writer at the top level.");
+        }
+    }
+
+    err = ion_writer_close(writer);
+    writer = NULL;
+    IONCHECK(err);
+    *p_stream = stream;
+    stream = NULL;
+
+fail:
+    if (writer) {
+        ion_writer_close(writer);
+    }
+    if (stream) {
+        UPDATEERROR(ion_stream_close(stream));
+    }
+    RETURN(__location_name__, __line__, __count__++, err);
+}
+
+iERR _ion_writer_write_batch_worker(void *batch_context, int worker_id)
+{
+    iENTER;
+    ION_WRITER_BATCH *batch = (ION_WRITER_BATCH *)batch_context;
+    iERR              segment_err;
+    long              segment;
+
+    for (;;) {
+        segment = _ion_worker_counter_claim(&batch->_counter);
+        if (segment >= batch->_segment_count) {
+            break;
+        }
+        if (batch->_abort) {
+            // once a segment has failed the batch won't be written, the rest are skipped
+            continue;
+        }
+        segment_err = _ion_writer_write_batch_segment(batch, (SIZE)segment, &batch->_segments[segment]);
+        if (segment_err) {
+            batch->_results[segment] = segment_err;
+            batch->_abort = TRUE;
+        }
+    }
+    iRETURN;
+}
+
+iERR ion_writer_write_batch(hWRITER hwriter, ION_WRITER_BATCH_CALLBACK callback, void *user_context,
+                            SIZE value_count, ION_WRITER_BATCH_OPTIONS *options)
+{
+    iENTER;
+    ION_WRITER         *pwriter;
+    ION_WRITER_BATCH    batch;
+    ION_WRITER_BATCH_OPTIONS batch_options;
+    POSITION            length;
+    SIZE                ii, written;
+
+    memset(&batch, 0, sizeof(ION_WRITER_BATCH));
+
+    if (!hwriter) FAILWITH(IERR_BAD_HANDLE);
+    pwriter = HANDLE_TO_PTR(hwriter, ION_WRITER);
+    if (!callback || value_count < 0) FAILWITH(IERR_INVALID_ARG);
+    if (pwriter->depth != 0) {
+        FAILWITHMSG(IERR_INVALID_STATE, "Cannot write a batch from within a container.");
+    }
+    if (value_count == 0) SUCCEED();
+
+    if (pwriter->type != ion_type_binary_writer) {
+        // text has no symbol table context to keep apart, the values are written in place
+        for (ii = 0; ii < value_count; ii++) {
+            IONCHECK(callback(hwriter, user_context, ii));
+        }
+        SUCCEED();
+    }
+
+    if (options) {
+        batch_options = *options;
+    }
+    else {
+        memset(&batch_options, 0, sizeof(ION_WRITER_BATCH_OPTIONS));
+    }
+    if (batch_options.num_workers < 1) {
+        batch_options.num_workers = _ion_worker_pool_default_size();
+    }
+    if (batch_options.values_per_segment < 1) {
+        batch_options.values_per_segment = value_count / (batch_options.num_workers * 8);
+        if (batch_options.values_per_segment < 1) {
+            batch_options.values_per_segment = 1;
+        }
+    }
+
+    // the segments carry their own symbol tables, so everything before them
+    // has to be out, and whatever comes after needs a fresh context
+    IONCHECK(ion_writer_finish(hwriter, NULL));
+
+    batch._writer_options = pwriter->options;
+    batch._writer_options.output_as_binary = TRUE;
+    batch._writer_options.flush_every_value = FALSE;
+    batch._writer_options.patch_lengths_in_output = FALSE;
+    batch._callback = callback;
+    batch._user_context = user_context;
+    batch._value_count = value_count;
+    batch._values_per_segment = batch_options.values_per_segment;
+    batch._segment_count = (value_count + batch._values_per_segment - 1) / batch._values_per_segment;
+    if (batch_options.num_workers > batch._segment_count) {
+        batch_options.num_workers = batch._segment_count;
+    }
+
+    batch._segments = (ION_STREAM **)ion_xalloc(batch._segment_count * sizeof(ION_STREAM *));
+    batch._results = (iERR *)ion_xalloc(batch._segment_count * sizeof(iERR));
+    if (!batch._segments || !batch._results) {
+        FAILWITH(IERR_NO_MEMORY);
+    }
+    memset(batch._segments, 0, batch._segment_count * sizeof(ION_STREAM *));
+    memset(batch._results, 0, batch._segment_count * sizeof(iERR));
+
+    IONCHECK(_ion_worker_pool_run(batch_options.num_workers, &_ion_writer_write_batch_worker, &batch));
+    for (ii = 0; ii < batch._segment_count; ii++) {
+        IONCHECK(batch._results[ii]);
+    }
+
+    // splice the segments into the output in order
+    for (ii = 0; ii < batch._segment_count; ii++) {
+        length = ion_stream_get_position(batch._segments[ii]);
+        IONCHECK(ion_stream_seek(batch._segments[ii], 0));
+        IONCHECK(ion_stream_write_stream(pwriter->output, batch._segments[ii], (SIZE)length, &written));
+        if (written != (SIZE)length) FAILWITH(IERR_WRITE_ERROR);
+    }
+
+fail:
+    if (batch._segments) {
+        for (ii = 0; ii < batch._segment_count; ii++) {
+            if (batch._segments[ii]) {
+                UPDATEERROR(ion_stream_close(batch._segments[ii]));
+            }
+        }
+        ion_xfree(batch._segments);
+    }
+    if (batch._results) {
+        ion_xfree(batch._results);
+    }
+    RETURN(__location_name__, __line__, __count__++, err);
+}
+
 iERR _ion_writer_flush_helper(ION_WRITER *pwriter, SIZE *p_bytes_flushed)
 {
     iENTER;
@@ -2882,6 +3535,7 @@ iERR _ion_writer_free_local_symbol_table( ION_WRITER *pwriter )
 
     // local symbol tables are owned by the _temp_entity_pool, which is freed upon flush and close.
     pwriter->symbol_table = NULL;
+    pwriter->_symbol_table_epoch++;
 
     iRETURN;
 }
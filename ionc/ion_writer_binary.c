@@ -71,6 +71,59 @@
 
 #define LOCAL_STACK_BUFFER_SIZE 256
 
+// writes value as a var uint of exactly width bytes, padded with leading
+// zero bytes, so that a length can be filled in later without moving anything
+static void _ion_writer_binary_padded_var_uint(BYTE *dst, uint64_t value, int width)
+{
+    int ii;
+
+    ASSERT(width > 0);
+    for (ii = width - 1; ii >= 0; ii--) {
+        dst[ii] = (BYTE)(value & 0x7F);
+        value >>= 7;
+    }
+    ASSERT(value == 0);
+    dst[width - 1] |= 0x80;
+}
+
+// writes the header of a nop pad that is len bytes long (header included)
+// and returns the length of the header, the rest of the pad is zeros
+static int _ion_writer_binary_nop_pad_header(BYTE *dst, SIZE len)
+{
+    int width;
+
+    ASSERT(len > 0);
+    if (len <= ION_lnIsVarLen) {
+        dst[0] = makeTypeDescriptor(TID_NULL, (len - ION_BINARY_TYPE_DESC_LENGTH));
+        return ION_BINARY_TYPE_DESC_LENGTH;
+    }
+    width = ion_binary_len_var_uint_64(len);
+    dst[0] = makeTypeDescriptor(TID_NULL, ION_lnIsVarLen);
+    _ion_writer_binary_padded_var_uint(dst + ION_BINARY_TYPE_DESC_LENGTH, len - ION_BINARY_TYPE_DESC_LENGTH - width, width);
+    return ION_BINARY_TYPE_DESC_LENGTH + width;
+}
+
+static iERR _ion_writer_binary_write_nop_pad(ION_STREAM *out, SIZE len)
+{
+    iENTER;
+    BYTE buffer[LOCAL_STACK_BUFFER_SIZE];
+    SIZE chunk, written;
+    int  header_len;
+
+    memset(buffer, 0, sizeof(buffer));
+    header_len = _ion_writer_binary_nop_pad_header(buffer, len);
+    chunk = (len < (SIZE)sizeof(buffer)) ? len : (SIZE)sizeof(buffer);
+    while (len > 0) {
+        IONCHECK(ion_stream_write(out, buffer, chunk, &written));
+        if (written != chunk) FAILWITH(IERR_WRITE_ERROR);
+        memset(buffer, 0, header_len);
+        len -= chunk;
+        chunk = (len < (SIZE)sizeof(buffer)) ? len : (SIZE)sizeof(buffer);
+    }
+
+    iRETURN;
+}
+
 iERR _ion_writer_binary_initialize(ION_WRITER *pwriter) 
 {
     iENTER;
@@ -85,6 +138,11 @@ iERR _ion_writer_binary_initialize(ION_WRITER *pwriter)
     _ion_collection_initialize(pwriter, &bwriter->_patch_stack, sizeof(ION_BINARY_PATCH *));
     _ion_collection_initialize(pwriter, &bwriter->_patch_list,  sizeof(ION_BINARY_PATCH));
     _ion_collection_initialize(pwriter, &bwriter->_value_list, pwriter->options.allocation_page_size);
+    _ion_collection_initialize(pwriter, &bwriter->_direct_patches, sizeof(ION_BINARY_PATCH));
+
+    bwriter->_direct             = FALSE;
+    bwriter->_buffered_stream    = NULL;
+    bwriter->_symbol_table_image = NULL;
 
     // the _value_stream is the temporary output stream where we write the un-headered
     // values that will later be merged with the length prefixes in the users output
@@ -98,17 +156,156 @@ iERR _ion_writer_binary_initialize(ION_WRITER *pwriter)
 }
 
 
+// fills in the length of a value written straight to the output. if the
+// value is still in the current page the type descriptor is shrunk to the
+// usual size and the contents moved up against it, which is always the case
+// for small values, otherwise the reserved length field is written in place
+static iERR _ion_writer_binary_fill_in_length(ION_WRITER *pwriter, ION_BINARY_PATCH *patch)
+{
+    iENTER;
+    ION_STREAM *out = pwriter->_typed_writer.binary._value_stream;
+    BYTE        header[ION_BINARY_PATCHED_HEADER_LENGTH];
+    BYTE       *tail;
+    POSITION    length;
+    int         header_len;
+
+    length = ion_stream_get_position(out) - (patch->_position + ION_BINARY_PATCHED_HEADER_LENGTH);
+    ASSERT(length >= 0);
+
+    tail = _ion_stream_unflushed_tail(out, patch->_position);
+    if (tail != NULL && length <= INT32_MAX) {
+        if (length < ION_lnIsVarLen) {
+            header[0] = makeTypeDescriptor(patch->_type, (int)length);
+            header_len = ION_BINARY_TYPE_DESC_LENGTH;
+        }
+        else {
+            header_len = ion_binary_len_var_uint_64((uint64_t)length);
+            header[0] = makeTypeDescriptor(patch->_type, ION_lnIsVarLen);
+            _ion_writer_binary_padded_var_uint(header + ION_BINARY_TYPE_DESC_LENGTH, (uint64_t)length, header_len);
+            header_len += ION_BINARY_TYPE_DESC_LENGTH;
+        }
+        memcpy(tail, header, header_len);
+        memmove(tail + header_len, tail + ION_BINARY_PATCHED_HEADER_LENGTH, (size_t)length);
+        IONCHECK(_ion_stream_retract(out, ION_BINARY_PATCHED_HEADER_LENGTH - header_len));
+    }
+    else {
+        header[0] = makeTypeDescriptor(patch->_type, ION_lnIsVarLen);
+        _ion_writer_binary_padded_var_uint(header + ION_BINARY_TYPE_DESC_LENGTH, (uint64_t)length, ION_BINARY_PATCHED_LENGTH_WIDTH);
+        IONCHECK(_ion_stream_patch(out, patch->_position, header, ION_BINARY_PATCHED_HEADER_LENGTH));
+    }
+
+    iRETURN;
+}
+
+// with the patch_lengths_in_output option top level containers are written
+// straight to the output. anything buffered goes out first, followed by a nop
+// pad that saves room for the symbols the container will add to the local
+// symbol table, and then the writer writes into the output instead of its
+// value stream until the container is finished
+static iERR _ion_writer_binary_start_direct(ION_WRITER *pwriter)
+{
+    iENTER;
+    ION_BINARY_WRITER *bwriter = &pwriter->_typed_writer.binary;
+    ION_STREAM        *out = pwriter->output;
+
+    ASSERT(!bwriter->_direct);
+    ASSERT(ION_COLLECTION_IS_EMPTY(&bwriter->_patch_stack));
+
+    IONCHECK(_ion_writer_binary_flush_to_output(pwriter));
+
+    bwriter->_symbol_table_reserve_start = ion_stream_get_position(out);
+    IONCHECK(_ion_writer_binary_write_nop_pad(out, pwriter->options.symbol_table_reserve));
+
+    bwriter->_buffered_stream = bwriter->_value_stream;
+    bwriter->_value_stream    = out;
+    bwriter->_direct          = TRUE;
+
+    iRETURN;
+}
+
+// puts the in memory value stream back and writes the symbols the container
+// added into the space in front of it. if the space and the container are
+// still in the current page the unused part of the space is dropped
+static iERR _ion_writer_binary_finish_direct(ION_WRITER *pwriter)
+{
+    iENTER;
+    ION_BINARY_WRITER *bwriter = &pwriter->_typed_writer.binary;
+    ION_STREAM        *out = pwriter->output;
+    ION_STREAM        *symbols = NULL;
+    SIZE               reserve = pwriter->options.symbol_table_reserve;
+    POSITION           start = bwriter->_symbol_table_reserve_start;
+    BYTE              *image, *tail;
+    int                symbols_len = 0;
+
+    ASSERT(bwriter->_direct);
+
+    bwriter->_value_stream    = bwriter->_buffered_stream;
+    bwriter->_buffered_stream = NULL;
+    bwriter->_direct          = FALSE;
+
+    if (bwriter->_symbol_table_image == NULL) {
+        bwriter->_symbol_table_image = (BYTE *)ion_alloc_with_owner(pwriter, reserve);
+        if (bwriter->_symbol_table_image == NULL) FAILWITH(IERR_NO_MEMORY);
+    }
+    image = bwriter->_symbol_table_image;
+
+    if (pwriter->_has_local_symbols) {
+        // a stream over the reserved space, which fails with IERR_BUFFER_TOO_SMALL
+        // when the symbols don't fit
+        IONCHECK(ion_stream_open_buffer(image, reserve, 0, FALSE, &symbols));
+        IONCHECK(_ion_writer_binary_serialize_symbol_table(pwriter->symbol_table, symbols, &symbols_len));
+    }
+
+    tail = _ion_stream_unflushed_tail(out, start);
+    if (tail != NULL) {
+        memmove(tail + symbols_len, tail + reserve, (size_t)(ion_stream_get_position(out) - start - reserve));
+        memcpy(tail, image, symbols_len);
+        IONCHECK(_ion_stream_retract(out, reserve - symbols_len));
+    }
+    else if (symbols_len > 0) {
+        memset(image + symbols_len, 0, reserve - symbols_len);
+        if (symbols_len < reserve) {
+            _ion_writer_binary_nop_pad_header(image + symbols_len, reserve - symbols_len);
+        }
+        IONCHECK(_ion_stream_patch(out, start, image, reserve));
+    }
+
+fail:
+    if (symbols != NULL) {
+        UPDATEERROR(ion_stream_close(symbols));
+    }
+    RETURN(__file__, __line__, __count__, err);
+}
+
 iERR _ion_writer_binary_push_position(ION_WRITER *pwriter, int type_id)
 {
     iENTER;
     ION_BINARY_WRITER *bwriter = &pwriter->_typed_writer.binary;
     ION_BINARY_PATCH  *patch, **ppatch;
+    BYTE               header[ION_BINARY_PATCHED_HEADER_LENGTH];
+    SIZE               written;
 
-    // first we create a new patch at the end of the patch list
-    patch = (ION_BINARY_PATCH *)_ion_collection_append(&bwriter->_patch_list);
-    patch->_length = 0;
-    patch->_offset = (int)ion_stream_get_position(bwriter->_value_stream);   // TODO - this needs 64bit care
-    patch->_type   = type_id;
+    if (bwriter->_direct) {
+        // the value goes straight to the output behind a type descriptor with
+        // room for any length, which is filled in when the value is popped
+        patch = (ION_BINARY_PATCH *)_ion_collection_push(&bwriter->_direct_patches);
+        patch->_length   = 0;
+        patch->_offset   = 0;
+        patch->_type     = type_id;
+        patch->_position = ion_stream_get_position(bwriter->_value_stream);
+
+        header[0] = makeTypeDescriptor(type_id, ION_lnIsVarLen);
+        _ion_writer_binary_padded_var_uint(header + ION_BINARY_TYPE_DESC_LENGTH, 0, ION_BINARY_PATCHED_LENGTH_WIDTH);
+        IONCHECK(ion_stream_write(bwriter->_value_stream, header, ION_BINARY_PATCHED_HEADER_LENGTH, &written));
+        if (written != ION_BINARY_PATCHED_HEADER_LENGTH) FAILWITH(IERR_WRITE_ERROR);
+    }
+    else {
+        // first we create a new patch at the end of the patch list
+        patch = (ION_BINARY_PATCH *)_ion_collection_append(&bwriter->_patch_list);
+        patch->_length = 0;
+        patch->_offset = (int)ion_stream_get_position(bwriter->_value_stream);   // TODO - this needs 64bit care
+        patch->_type   = type_id;
+    }
     
     // then we push a pointer to the patch onto our active stack
     ppatch = (ION_BINARY_PATCH **)_ion_collection_push(&bwriter->_patch_stack);
@@ -134,6 +331,15 @@ iERR _ion_writer_binary_pop(ION_WRITER *pwriter)
 
     ppatch = (ION_BINARY_PATCH **)_ion_collection_head( &bwriter->_patch_stack);
 
+    if (bwriter->_direct) {
+        // nothing is waiting on the length of a value in the output, the
+        // length just gets filled in
+        IONCHECK( _ion_writer_binary_fill_in_length( pwriter, *ppatch ));
+        _ion_collection_pop_head( &bwriter->_patch_stack);
+        _ion_collection_pop_head( &bwriter->_direct_patches);
+        SUCCEED();
+    }
+
     patch_down = (*ppatch)->_length;
     if (patch_down >= ION_lnIsVarLen) {
         patch_down += ion_binary_len_var_uint_64( patch_down );
@@ -159,7 +365,7 @@ iERR _ion_writer_binary_patch_lengths(ION_WRITER *pwriter, int added_length)
 //    ION_COLLECTION_CURSOR patch_cursor;
 
     ppatch = _ion_collection_head(&bwriter->_patch_stack);
-    if (ppatch) {
+    if (ppatch && !bwriter->_direct) {
         // we only patch the top of the stack right now
         // when we pop this off we'll patch the entries
         // below (by updating the next one and letting
@@ -400,6 +606,16 @@ iERR _ion_writer_binary_finish_lob(ION_WRITER *pwriter)
 iERR _ion_writer_binary_start_container(ION_WRITER *pwriter, ION_TYPE container_type)
 {
     iENTER;
+    ION_BINARY_WRITER *bwriter = &pwriter->_typed_writer.binary;
+
+    if (pwriter->options.patch_lengths_in_output
+        && !bwriter->_direct
+        && ION_COLLECTION_IS_EMPTY(&bwriter->_patch_stack)
+        && bwriter->_lob_in_progress == tid_none
+        && ion_stream_can_seek(pwriter->output)
+    ) {
+        IONCHECK( _ion_writer_binary_start_direct( pwriter ));
+    }
 
     IONCHECK( _ion_writer_binary_start_value( pwriter, ION_BINARY_UNKNOWN_LENGTH ));
     IONCHECK( _ion_writer_binary_patch_lengths( pwriter, ION_BINARY_TYPE_DESC_LENGTH ));
@@ -421,6 +637,9 @@ iERR _ion_writer_binary_finish_container(ION_WRITER *pwriter)
 
     if (ION_COLLECTION_IS_EMPTY(stack)) {
         in_struct = FALSE;
+        if (pwriter->_typed_writer.binary._direct) {
+            IONCHECK(_ion_writer_binary_finish_direct(pwriter));
+        }
         if (pwriter->options.flush_every_value) {
             IONCHECK(_ion_writer_binary_flush_to_output(pwriter));
         }
@@ -876,13 +1095,29 @@ iERR _ion_writer_binary_write_timestamp_without_fraction_helper(ION_WRITER *pwri
         SUCCEED();
     }
 
-    // first we write out the local offset (and we write a -0 if it is not known)
     if (HAS_TZ_OFFSET(ptime)) {
-        IONCHECK(ion_binary_write_var_int_64(pstream, ptime->tz_offset));
         IONCHECK(_ion_timestamp_initialize(&ptime_utc));
         IONCHECK(_ion_timestamp_to_utc(ptime, &ptime_utc)); // Binary timestamps are stored in UTC with local offset intact.
+        ptime_utc.tz_offset = ptime->tz_offset;
         ptime = &ptime_utc;
     }
+    IONCHECK(_ion_writer_binary_write_timestamp_utc_fields(pstream, ptime));
+
+    iRETURN;
+}
+
+// writes the offset and the fields of a timestamp whose fields are already in UTC
+iERR _ion_writer_binary_write_timestamp_utc_fields(ION_STREAM *pstream, ION_TIMESTAMP *ptime)
+{
+    iENTER;
+
+    ASSERT(pstream != NULL);
+    ASSERT(ptime != NULL);
+
+    // first we write out the local offset (and we write a -0 if it is not known)
+    if (HAS_TZ_OFFSET(ptime)) {
+        IONCHECK(ion_binary_write_var_int_64(pstream, ptime->tz_offset));
+    }
     else {
         ION_PUT( pstream, ION_BINARY_VAR_INT_NEGATIVE_ZERO );
     }
@@ -1020,6 +1255,27 @@ iERR _ion_writer_binary_write_timestamp_with_fraction( ION_WRITER *pwriter, ION_
     iRETURN;
 }
 
+iERR _ion_writer_binary_write_timestamp_epoch(ION_WRITER *pwriter, ION_TIMESTAMP *ptime_utc, uint64_t mantissa, int32_t exponent)
+{
+    iENTER;
+    ION_STREAM *pstream = pwriter->_typed_writer.binary._value_stream;
+    int len, patch_len;
+
+    len = _ion_writer_binary_timestamp_len_without_fraction(ptime_utc);
+    if (IS_FLAG_ON(ptime_utc->precision, ION_TT_BIT_FRAC)) {
+        IONCHECK(_ion_writer_binary_decimal_small_len(mantissa, exponent, FALSE, &len));
+    }
+
+    IONCHECK(_ion_writer_binary_write_header(pwriter, TID_TIMESTAMP, len, &patch_len));
+    IONCHECK(_ion_writer_binary_write_timestamp_utc_fields(pstream, ptime_utc));
+    if (IS_FLAG_ON(ptime_utc->precision, ION_TT_BIT_FRAC)) {
+        IONCHECK(_ion_writer_binary_write_decimal_small_helper(pstream, mantissa, exponent, FALSE));
+    }
+    IONCHECK(_ion_writer_binary_patch_lengths( pwriter, patch_len + len ));
+
+    iRETURN;
+}
+
 iERR _ion_writer_binary_write_timestamp_without_fraction(ION_WRITER *pwriter, iTIMESTAMP value)
 {
     iENTER;
@@ -1219,6 +1475,383 @@ iERR _ion_writer_binary_write_all_values(ION_WRITER *pwriter, ION_READER *preade
     iRETURN;
 }
 
+// a field's name, type descriptor, length and, for the fixed size types, its
+// value all fit in this much space
+#define ION_BINARY_TEMPLATE_HEADER_MAX_LENGTH \
+    (ION_BINARY_TEMPLATE_SID_MAX_LENGTH + ION_BINARY_TYPE_DESC_LENGTH + sizeof(uint64_t))
+
+static BYTE *_ion_writer_binary_put_var_uint(BYTE *dst, uint64_t value, int len)
+{
+    int ii;
+
+    for (ii = len - 1; ii >= 0; ii--) {
+        dst[ii] = (BYTE)(value & 0x7F);
+        value >>= 7;
+    }
+    dst[len - 1] |= 0x80;
+    return dst + len;
+}
+
+static BYTE *_ion_writer_binary_put_uint(BYTE *dst, uint64_t value, int len)
+{
+    int ii;
+
+    for (ii = len - 1; ii >= 0; ii--) {
+        dst[ii] = (BYTE)(value & 0xFF);
+        value >>= 8;
+    }
+    return dst + len;
+}
+
+// writes the type descriptor and value of a float the way ion_writer_write_double
+// does, as 32 bits if the writer compacts floats and nothing is lost
+static BYTE *_ion_writer_binary_put_float(ION_WRITER *pwriter, BYTE *dst, double value)
+{
+    float    value_32 = (float)value;
+    uint64_t bits_64;
+    uint32_t bits_32;
+    int      len;
+
+    if (pwriter->options.compact_floats && ((double)value_32) == value) {
+        len = ion_binary_len_ion_float_32(value_32);
+        *dst++ = makeTypeDescriptor(TID_FLOAT, len);
+        if (len > 0) {
+            memcpy(&bits_32, &value_32, sizeof(bits_32));
+            dst = _ion_writer_binary_put_uint(dst, bits_32, len);
+        }
+    }
+    else {
+        len = ion_binary_len_ion_float_64(value);
+        *dst++ = makeTypeDescriptor(TID_FLOAT, len);
+        if (len > 0) {
+            memcpy(&bits_64, &value, sizeof(bits_64));
+            dst = _ion_writer_binary_put_uint(dst, bits_64, len);
+        }
+    }
+    return dst;
+}
+
+static iERR _ion_writer_binary_encode_template(ION_WRITER *pwriter, ION_WRITER_TEMPLATE *tmpl)
+{
+    iENTER;
+    ION_WRITER_TEMPLATE_FIELD *field;
+    SIZE ii;
+    SID  sid;
+    int  len;
+
+    tmpl->_has_local_names = FALSE;
+    for (ii = 0; ii < tmpl->_field_count; ii++) {
+        field = &tmpl->_fields[ii];
+        IONCHECK(_ion_writer_symbol_ref_as_sid_helper(pwriter, &field->_name, &sid));
+        if (sid <= UNKNOWN_SID) FAILWITH(IERR_INVALID_STATE);
+        len = ion_binary_len_var_uint_64(sid);
+        ASSERT(len <= ION_BINARY_TEMPLATE_SID_MAX_LENGTH);
+        _ion_writer_binary_put_var_uint(field->_sid, sid, len);
+        field->_sid_length = (BYTE)len;
+        tmpl->_has_local_names |= field->_name._is_local;
+    }
+    // the sids looked up first are still good if a later one started a new
+    // local symbol table, it starts with everything the old one had
+    tmpl->_epoch = pwriter->_symbol_table_epoch;
+    tmpl->_encoded = TRUE;
+
+    iRETURN;
+}
+
+iERR _ion_writer_binary_write_template_row(ION_WRITER *pwriter, ION_WRITER_TEMPLATE *tmpl, ION_WRITER_TEMPLATE_VALUE *values)
+{
+    iENTER;
+    ION_BINARY_WRITER         *bwriter = &pwriter->_typed_writer.binary;
+    ION_STREAM                *ostream = bwriter->_value_stream;
+    ION_WRITER_TEMPLATE_FIELD *field;
+    ION_WRITER_TEMPLATE_VALUE *value;
+    BYTE      header[ION_BINARY_TEMPLATE_HEADER_MAX_LENGTH];
+    BYTE     *pb;
+    BYTE     *payload;
+    SIZE      ii, payload_len, written;
+    int       len, row_len = 0;
+    uint64_t  magnitude;
+    SID       sid;
+
+    ASSERT(pwriter->_in_struct);
+
+    if (!tmpl->_encoded || tmpl->_epoch != pwriter->_symbol_table_epoch) {
+        IONCHECK(_ion_writer_binary_encode_template(pwriter, tmpl));
+    }
+    else if (tmpl->_has_local_names) {
+        // the symbol table may have been written since, it has to be written again
+        pwriter->_has_local_symbols = TRUE;
+    }
+
+    for (ii = 0; ii < tmpl->_field_count; ii++) {
+        field = &tmpl->_fields[ii];
+        value = &values[ii];
+        payload = NULL;
+        payload_len = 0;
+
+        if (!value->is_null && (field->_tid == TID_DECIMAL || field->_tid == TID_TIMESTAMP)) {
+            // these have encodings of their own, the usual calls write them
+            // and account for their lengths
+            pwriter->field_name.sid = field->_name._sid;
+            ION_STRING_INIT(&pwriter->field_name.value);
+            if (field->_tid == TID_DECIMAL) {
+                IONCHECK(_ion_writer_write_ion_decimal_helper(pwriter, value->value.decimal_value));
+            }
+            else {
+                IONCHECK(_ion_writer_write_timestamp_helper(pwriter, value->value.timestamp_value));
+            }
+            continue;
+        }
+
+        memcpy(header, field->_sid, field->_sid_length);
+        pb = header + field->_sid_length;
+
+        if (value->is_null) {
+            *pb++ = makeTypeDescriptor(field->_tid, ION_lnIsNull);
+        }
+        else switch (field->_tid) {
+        case TID_BOOL:
+            *pb++ = value->value.bool_value ? IonTrue : IonFalse;
+            break;
+        case TID_POS_INT:
+            magnitude = abs_int64(value->value.int_value);
+            len = ion_binary_len_uint_64(magnitude);
+            *pb++ = makeTypeDescriptor((value->value.int_value < 0 ? TID_NEG_INT : TID_POS_INT), len);
+            pb = _ion_writer_binary_put_uint(pb, magnitude, len);
+            break;
+        case TID_FLOAT:
+            pb = _ion_writer_binary_put_float(pwriter, pb, value->value.float_value);
+            break;
+        case TID_SYMBOL:
+            if (!value->value.string_value.value) {
+                *pb++ = makeTypeDescriptor(TID_SYMBOL, ION_lnIsNull);
+                break;
+            }
+            IONCHECK(_ion_writer_make_symbol_helper(pwriter, &value->value.string_value, &sid));
+            ASSERT(sid != UNKNOWN_SID);
+            len = ion_binary_len_uint_64(sid);
+            *pb++ = makeTypeDescriptor(TID_SYMBOL, len);
+            pb = _ion_writer_binary_put_uint(pb, sid, len);
+            break;
+        case TID_STRING:
+        case TID_CLOB:
+        case TID_BLOB:
+            payload = value->value.string_value.value;
+            payload_len = value->value.string_value.length;
+            if (!payload) {
+                *pb++ = makeTypeDescriptor(field->_tid, ION_lnIsNull);
+                payload_len = 0;
+                break;
+            }
+            if (payload_len < 0) FAILWITH(IERR_INVALID_ARG);
+            if (payload_len < ION_lnIsVarLen) {
+                *pb++ = makeTypeDescriptor(field->_tid, payload_len);
+            }
+            else {
+                *pb++ = makeTypeDescriptor(field->_tid, ION_lnIsVarLen);
+                pb = _ion_writer_binary_put_var_uint(pb, payload_len, ion_binary_len_var_uint_64(payload_len));
+            }
+            break;
+        default:
+            FAILWITH(IERR_INVALID_STATE);
+        }
+
+        IONCHECK(ion_stream_write(ostream, header, (SIZE)(pb - header), &written));
+        if (written != (SIZE)(pb - header)) FAILWITH(IERR_WRITE_ERROR);
+        if (payload_len > 0) {
+            IONCHECK(ion_stream_write(ostream, payload, payload_len, &written));
+            if (written != payload_len) FAILWITH(IERR_WRITE_ERROR);
+        }
+        row_len += (int)(pb - header) + payload_len;
+    }
+
+    // the fields written here are only added to the struct's length once
+    IONCHECK(_ion_writer_binary_patch_lengths(pwriter, row_len));
+
+    iRETURN;
+}
+
+// the bulk list writers encode this many bytes at a time before handing them to
+// the stream
+#define ION_BINARY_LIST_CHUNK_LENGTH 512
+
+// the longest int or float in a list, with its type descriptor
+#define ION_BINARY_LIST_SCALAR_MAX_LENGTH (ION_BINARY_TYPE_DESC_LENGTH + sizeof(uint64_t))
+
+// starts a list whose contents are known to be content_len bytes long, the
+// header is written in full so nothing is patched when the list is finished
+static iERR _ion_writer_binary_start_list(ION_WRITER *pwriter, int64_t content_len, int *p_list_len)
+{
+    iENTER;
+    ION_STREAM *ostream;
+    BYTE        header[ION_BINARY_LIST_SCALAR_MAX_LENGTH];
+    BYTE       *pb = header;
+    SIZE        written;
+    int         len_len = 0;
+
+    if (content_len >= ION_lnIsVarLen) {
+        len_len = ion_binary_len_var_uint_64(content_len);
+    }
+    if (content_len > INT32_MAX - ION_BINARY_TYPE_DESC_LENGTH - len_len) FAILWITH(IERR_INVALID_ARG);
+
+    IONCHECK(_ion_writer_binary_start_value(pwriter, ION_BINARY_TYPE_DESC_LENGTH + len_len + (int)content_len));
+    if (len_len == 0) {
+        *pb++ = makeTypeDescriptor(TID_LIST, (int)content_len);
+    }
+    else {
+        *pb++ = makeTypeDescriptor(TID_LIST, ION_lnIsVarLen);
+        pb = _ion_writer_binary_put_var_uint(pb, (uint64_t)content_len, len_len);
+    }
+    // start_value may have moved the value to the output
+    ostream = pwriter->_typed_writer.binary._value_stream;
+    IONCHECK(ion_stream_write(ostream, header, (SIZE)(pb - header), &written));
+    if (written != (SIZE)(pb - header)) FAILWITH(IERR_WRITE_ERROR);
+
+    *p_list_len = ION_BINARY_TYPE_DESC_LENGTH + len_len + (int)content_len;
+
+    iRETURN;
+}
+
+static iERR _ion_writer_binary_write_chunk(ION_STREAM *ostream, BYTE *chunk, BYTE *end)
+{
+    iENTER;
+    SIZE written;
+
+    if (end > chunk) {
+        IONCHECK(ion_stream_write(ostream, chunk, (SIZE)(end - chunk), &written));
+        if (written != (SIZE)(end - chunk)) FAILWITH(IERR_WRITE_ERROR);
+    }
+
+    iRETURN;
+}
+
+iERR _ion_writer_binary_write_int64_list(ION_WRITER *pwriter, int64_t *values, SIZE count)
+{
+    iENTER;
+    BYTE      chunk[ION_BINARY_LIST_CHUNK_LENGTH];
+    BYTE     *pb;
+    int64_t   content_len = 0;
+    uint64_t  magnitude;
+    SIZE      ii;
+    int       len, list_len;
+
+    for (ii = 0; ii < count; ii++) {
+        content_len += ION_BINARY_TYPE_DESC_LENGTH + ion_binary_len_uint_64(abs_int64(values[ii]));
+    }
+    IONCHECK(_ion_writer_binary_start_list(pwriter, content_len, &list_len));
+
+    pb = chunk;
+    for (ii = 0; ii < count; ii++) {
+        if (pb + ION_BINARY_LIST_SCALAR_MAX_LENGTH > chunk + sizeof(chunk)) {
+            IONCHECK(_ion_writer_binary_write_chunk(pwriter->_typed_writer.binary._value_stream, chunk, pb));
+            pb = chunk;
+        }
+        magnitude = abs_int64(values[ii]);
+        len = ion_binary_len_uint_64(magnitude);
+        *pb++ = makeTypeDescriptor((values[ii] < 0 ? TID_NEG_INT : TID_POS_INT), len);
+        pb = _ion_writer_binary_put_uint(pb, magnitude, len);
+    }
+    IONCHECK(_ion_writer_binary_write_chunk(pwriter->_typed_writer.binary._value_stream, chunk, pb));
+
+    IONCHECK(_ion_writer_binary_patch_lengths(pwriter, list_len));
+
+    iRETURN;
+}
+
+iERR _ion_writer_binary_write_double_list(ION_WRITER *pwriter, double *values, SIZE count)
+{
+    iENTER;
+    BYTE      chunk[ION_BINARY_LIST_CHUNK_LENGTH];
+    BYTE     *pb;
+    int64_t   content_len = 0;
+    SIZE      ii;
+    int       list_len;
+
+    // the lengths are worked out by encoding the values, which is about as
+    // cheap as deciding how each of them is going to be encoded
+    for (ii = 0; ii < count; ii++) {
+        content_len += _ion_writer_binary_put_float(pwriter, chunk, values[ii]) - chunk;
+    }
+    IONCHECK(_ion_writer_binary_start_list(pwriter, content_len, &list_len));
+
+    pb = chunk;
+    for (ii = 0; ii < count; ii++) {
+        if (pb + ION_BINARY_LIST_SCALAR_MAX_LENGTH > chunk + sizeof(chunk)) {
+            IONCHECK(_ion_writer_binary_write_chunk(pwriter->_typed_writer.binary._value_stream, chunk, pb));
+            pb = chunk;
+        }
+        pb = _ion_writer_binary_put_float(pwriter, pb, values[ii]);
+    }
+    IONCHECK(_ion_writer_binary_write_chunk(pwriter->_typed_writer.binary._value_stream, chunk, pb));
+
+    IONCHECK(_ion_writer_binary_patch_lengths(pwriter, list_len));
+
+    iRETURN;
+}
+
+iERR _ion_writer_binary_write_string_list(ION_WRITER *pwriter, ION_STRING *values, SIZE count)
+{
+    iENTER;
+    ION_STREAM *ostream;
+    BYTE        chunk[ION_BINARY_LIST_CHUNK_LENGTH];
+    BYTE       *pb;
+    int64_t     content_len = 0;
+    SIZE        ii, len;
+    int         len_len, list_len;
+
+    for (ii = 0; ii < count; ii++) {
+        len = values[ii].length;
+        if (!values[ii].value) {
+            content_len += ION_BINARY_TYPE_DESC_LENGTH;
+            continue;
+        }
+        if (len < 0) FAILWITH(IERR_INVALID_ARG);
+        content_len += ION_BINARY_TYPE_DESC_LENGTH + len;
+        if (len >= ION_lnIsVarLen) {
+            content_len += ion_binary_len_var_uint_64(len);
+        }
+    }
+    IONCHECK(_ion_writer_binary_start_list(pwriter, content_len, &list_len));
+    ostream = pwriter->_typed_writer.binary._value_stream;
+
+    // short strings are copied into the chunk with their headers, longer ones
+    // go to the stream on their own
+    pb = chunk;
+    for (ii = 0; ii < count; ii++) {
+        len = values[ii].length;
+        len_len = (values[ii].value && len >= ION_lnIsVarLen) ? ion_binary_len_var_uint_64(len) : 0;
+        if (pb + ION_BINARY_TYPE_DESC_LENGTH + len_len > chunk + sizeof(chunk)) {
+            IONCHECK(_ion_writer_binary_write_chunk(ostream, chunk, pb));
+            pb = chunk;
+        }
+        if (!values[ii].value) {
+            *pb++ = makeTypeDescriptor(TID_STRING, ION_lnIsNull);
+            continue;
+        }
+        if (len_len == 0) {
+            *pb++ = makeTypeDescriptor(TID_STRING, len);
+        }
+        else {
+            *pb++ = makeTypeDescriptor(TID_STRING, ION_lnIsVarLen);
+            pb = _ion_writer_binary_put_var_uint(pb, (uint64_t)len, len_len);
+        }
+        if (pb + len <= chunk + sizeof(chunk)) {
+            memcpy(pb, values[ii].value, len);
+            pb += len;
+        }
+        else {
+            IONCHECK(_ion_writer_binary_write_chunk(ostream, chunk, pb));
+            IONCHECK(_ion_writer_binary_write_chunk(ostream, values[ii].value, values[ii].value + len));
+            pb = chunk;
+        }
+    }
+    IONCHECK(_ion_writer_binary_write_chunk(ostream, chunk, pb));
+
+    IONCHECK(_ion_writer_binary_patch_lengths(pwriter, list_len));
+
+    iRETURN;
+}
+
 iERR _ion_writer_binary_close(ION_WRITER *pwriter, BOOL flush)
 {
     iENTER;
@@ -1229,6 +1862,14 @@ iERR _ion_writer_binary_close(ION_WRITER *pwriter, BOOL flush)
 
     bwriter = &pwriter->_typed_writer.binary;
 
+    if (bwriter->_direct) {
+        // closed in the middle of a container written straight to the output,
+        // the output belongs to the caller so we take our stream back
+        bwriter->_value_stream    = bwriter->_buffered_stream;
+        bwriter->_buffered_stream = NULL;
+        bwriter->_direct          = FALSE;
+    }
+
     patches = !ION_COLLECTION_IS_EMPTY(&bwriter->_patch_list);
     values  = ion_stream_get_position(bwriter->_value_stream) != 0;
 
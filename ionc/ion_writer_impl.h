@@ -91,6 +91,8 @@ typedef enum _ION_WRITER_SYMTAB_INTERCEPT_STATE {
 #define ION_WRITER_SI_COMPLETE_IMPORT(writer) _ION_WRITER_SI_COMPLETE(writer, writer->_completed_symtab_intercept_states, iWSIS_IN_IMPORTS_LIST);
 #define ION_WRITER_SI_MARK_LST_APPEND(writer) _ION_WRITER_SI_COMPLETE(writer, ION_WRITER_SI_LST_APPEND, iWSIS_IN_LST_STRUCT);
 
+#define ION_TEXT_WRITER_SCRATCH_LENGTH 64
+
 typedef struct _ion_text_writer
 {
     BOOL       _no_output;           // is true until at least 1 char is written to the stream
@@ -105,13 +107,23 @@ typedef struct _ion_text_writer
     ION_TYPE  *_stack_parent_type;
     BYTE      *_stack_flags; // _stack_in_struct _stack_pending_comma;
 
+    BYTE       _scratch[ION_TEXT_WRITER_SCRATCH_LENGTH]; // tokens are formatted here when the output page is short
+
 } ION_TEXT_WRITER;
 
+// containers written straight to the output get a type descriptor with a
+// length field of this many bytes, which is filled in when they are finished
+#define ION_BINARY_PATCHED_LENGTH_WIDTH 8
+#define ION_BINARY_PATCHED_HEADER_LENGTH (ION_BINARY_TYPE_DESC_LENGTH + ION_BINARY_PATCHED_LENGTH_WIDTH)
+
+#define ION_WRITER_SYMBOL_TABLE_RESERVE_DEFAULT 4096
+
 typedef struct _ion_binary_patch {
-    int     _offset;
-    int     _type;
-    int     _length;
-    BOOL    _in_struct;
+    int      _offset;
+    int      _type;
+    int      _length;
+    BOOL     _in_struct;
+    POSITION _position;    // for values written straight to the output: where the type descriptor is
 } ION_BINARY_PATCH;
 
 typedef struct _ion_binary_writer
@@ -124,8 +136,55 @@ typedef struct _ion_binary_writer
 
     ION_STREAM         *_value_stream; // temporary in memory buffer for holding values to merge with the patch list
 
+    // with the patch_lengths_in_output option a top level container is written
+    // straight to the output, _value_stream points at the output while that's
+    // going on and the in memory stream is put aside in _buffered_stream
+    BOOL                _direct;
+    ION_STREAM         *_buffered_stream;
+    ION_COLLECTION      _direct_patches;        // the patches of the open containers (the stack holds pointers to these)
+    POSITION            _symbol_table_reserve_start;  // where the space for the container's symbols starts
+    BYTE               *_symbol_table_image;          // symbol_table_reserve bytes to build that space in
+
 } ION_BINARY_WRITER;
 
+// a symbol interned by ion_writer_intern_symbol. the sid is cached with the
+// symbol table epoch it was looked up in, and looked up again once the
+// writer's symbol table has been replaced
+typedef struct _ion_writer_symbol_ref
+{
+    ION_STRING  _text;          // owned by the writer
+    SID         _sid;
+    BOOL        _is_local;      // the sid is past the system symbols, so the local symbol table has to be written
+    uint32_t    _epoch;
+
+} ION_WRITER_SYMBOL_REF;
+
+// the longest VarUInt a SID can take
+#define ION_BINARY_TEMPLATE_SID_MAX_LENGTH 5
+
+// a field of an ION_WRITER_TEMPLATE. the binary encoding of the name is only
+// good for the symbol table epoch the template was encoded in
+typedef struct _ion_writer_template_field
+{
+    ION_WRITER_SYMBOL_REF _name;
+    ION_TYPE    _type;
+    BYTE        _tid;           // the high nibble of the type descriptor, ints are TID_POS_INT
+    BYTE        _sid_length;
+    BYTE        _sid[ION_BINARY_TEMPLATE_SID_MAX_LENGTH];   // the name's sid as a VarUInt
+
+} ION_WRITER_TEMPLATE_FIELD;
+
+// a struct shape created by ion_writer_create_template, owned by the writer
+typedef struct _ion_writer_template
+{
+    SIZE        _field_count;
+    ION_WRITER_TEMPLATE_FIELD *_fields;
+    BOOL        _encoded;
+    BOOL        _has_local_names; // one of the names is a local symbol
+    uint32_t    _epoch;
+
+} ION_WRITER_TEMPLATE;
+
 typedef struct _ion_writer
 {
     ION_OBJ_TYPE       type;
@@ -137,6 +196,7 @@ typedef struct _ion_writer
     ION_SYMBOL_TABLE  *symbol_table;        // if there are local symbols defined this will be a seperately allocated table, and should be freed as we close the top level value
     ION_SYMBOL_TABLE  *_pending_symbol_table;// The in-progress manually-written LST, if applicable. Becomes `symbol_table` when the LST struct is finished.
     BOOL               _has_local_symbols;
+    uint32_t           _symbol_table_epoch; // changes whenever symbol_table is replaced, see ION_WRITER_SYMBOL_REF
 
     ION_WRITER_SYMTAB_INTERCEPT_STATE   _current_symtab_intercept_state;
     uint16_t                            _completed_symtab_intercept_states;
@@ -256,6 +316,8 @@ iERR _ion_writer_flush_helper(ION_WRITER *pwriter, SIZE *p_bytes_flushed);
 iERR _ion_writer_close_helper(ION_WRITER *pwriter);
 iERR _ion_writer_free_local_symbol_table( ION_WRITER *pwriter );
 iERR _ion_writer_make_symbol_helper(ION_WRITER *pwriter, ION_STRING *pstr, SID *p_sid);
+iERR _ion_writer_init_symbol_ref_helper(ION_WRITER *pwriter, ION_WRITER_SYMBOL_REF *ref, ION_STRING *text);
+iERR _ion_writer_symbol_ref_as_sid_helper(ION_WRITER *pwriter, ION_WRITER_SYMBOL_REF *ref, SID *p_sid);
 iERR _ion_writer_clear_field_name_helper(ION_WRITER *pwriter);
 iERR _ion_writer_get_field_name_as_string_helper(ION_WRITER *pwriter, ION_STRING *p_str, BOOL *p_is_symbol_identifier);
 iERR _ion_writer_get_field_name_as_sid_helper(ION_WRITER *pwriter, SID *p_sid);
@@ -307,6 +369,7 @@ iERR _ion_writer_text_write_double(ION_WRITER *pwriter, double value);
 iERR _ion_writer_text_write_double_json(ION_WRITER *pwriter, double value);
 iERR _ion_writer_text_write_decimal_quad(ION_WRITER *pwriter, decQuad *value);
 iERR _ion_writer_text_write_decimal_number(ION_WRITER *pwriter, decNumber *value);
+iERR _ion_writer_text_write_decimal_parts(ION_WRITER *pwriter, int64_t mantissa, int32_t exponent);
 iERR _ion_writer_text_write_timestamp(ION_WRITER *pwriter, iTIMESTAMP value);
 iERR _ion_writer_text_write_symbol_id(ION_WRITER *pwriter, SID value);
 iERR _ion_writer_text_write_symbol(ION_WRITER *pwriter, iSTRING symbol);
@@ -338,18 +401,25 @@ iERR _ion_writer_binary_write_float(ION_WRITER *pwriter, float value);
 iERR _ion_writer_binary_write_double(ION_WRITER *pwriter, double value);
 iERR _ion_writer_binary_write_decimal_quad(ION_WRITER *pwriter, decQuad *value);
 iERR _ion_writer_binary_write_decimal_number(ION_WRITER *pwriter, decNumber *value);
+iERR _ion_writer_binary_write_decimal_small(ION_WRITER *pwriter, uint64_t mantissa, int32_t exponent, BOOL is_negative);
 iERR _ion_writer_binary_write_timestamp(ION_WRITER *pwriter, iTIMESTAMP value);
+iERR _ion_writer_binary_write_timestamp_utc_fields(ION_STREAM *pstream, ION_TIMESTAMP *ptime);
+iERR _ion_writer_binary_write_timestamp_epoch(ION_WRITER *pwriter, ION_TIMESTAMP *ptime_utc, uint64_t mantissa, int32_t exponent);
 iERR _ion_writer_binary_write_symbol_id(ION_WRITER *pwriter, SID value);
 iERR _ion_writer_binary_write_symbol(ION_WRITER *pwriter, iSTRING symbol);
 iERR _ion_writer_binary_write_string(ION_WRITER *pwriter, iSTRING str);
 iERR _ion_writer_binary_write_clob(ION_WRITER *pwriter, BYTE *p_buf, SIZE length);
 iERR _ion_writer_binary_write_blob(ION_WRITER *pwriter, BYTE *p_buf, SIZE length);
+iERR _ion_writer_binary_write_int64_list(ION_WRITER *pwriter, int64_t *values, SIZE count);
+iERR _ion_writer_binary_write_double_list(ION_WRITER *pwriter, double *values, SIZE count);
+iERR _ion_writer_binary_write_string_list(ION_WRITER *pwriter, ION_STRING *values, SIZE count);
 iERR _ion_writer_binary_start_lob(ION_WRITER *pwriter, ION_TYPE lob_type);
 iERR _ion_writer_binary_append_lob(ION_WRITER *pwriter, BYTE *p_buf, SIZE length);
 iERR _ion_writer_binary_finish_lob(ION_WRITER *pwriter);
 iERR _ion_writer_binary_start_container(ION_WRITER *pwriter, ION_TYPE container_type);
 iERR _ion_writer_binary_finish_container(ION_WRITER *pwriter);
 iERR _ion_writer_binary_close(ION_WRITER *pwriter, BOOL flush);
+iERR _ion_writer_binary_write_template_row(ION_WRITER *pwriter, ION_WRITER_TEMPLATE *tmpl, ION_WRITER_TEMPLATE_VALUE *values);
 
 iERR _ion_writer_binary_output_stream_handler(ION_STREAM *pstream);
 iERR _ion_writer_binary_input_stream_handler(ION_STREAM *pstream);
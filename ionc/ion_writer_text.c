@@ -19,6 +19,7 @@
 
 #include "ion_internal.h"
 #include "ion_decimal_impl.h"
+#include "ion_byte_scan.h"
 #include <float.h>
 #include <math.h>
 #include <stdio.h>
@@ -36,6 +37,39 @@
 
 #define LOCAL_INT_CHAR_BUFFER_LENGTH   257
 
+// Returns where the next len bytes of output can be formatted: straight into the
+// output page when it has room, otherwise into the writer's scratch buffer.
+// _ion_writer_text_commit then writes out however much of it was used.
+static iERR _ion_writer_text_reserve(ION_WRITER *pwriter, SIZE len, BYTE **p_dst)
+{
+    iENTER;
+
+    ASSERT(len <= ION_TEXT_WRITER_SCRATCH_LENGTH);
+
+    IONCHECK(ion_stream_reserve(pwriter->output, len, p_dst));
+    if (*p_dst == NULL) {
+        *p_dst = TEXTWRITER(pwriter)->_scratch;
+    }
+
+    iRETURN;
+}
+
+static iERR _ion_writer_text_commit(ION_WRITER *pwriter, BYTE *dst, SIZE len)
+{
+    iENTER;
+    SIZE written;
+
+    if (dst == TEXTWRITER(pwriter)->_scratch) {
+        IONCHECK(ion_stream_write(pwriter->output, dst, len, &written));
+        if (written != len) FAILWITH(IERR_WRITE_ERROR);
+    }
+    else {
+        IONCHECK(ion_stream_commit(pwriter->output, len));
+    }
+
+    iRETURN;
+}
+
 iERR _ion_writer_text_initialize(ION_WRITER *pwriter)
 {
     iENTER;
@@ -166,20 +200,33 @@ iERR _ion_writer_text_top_type(ION_WRITER *pwriter, ION_TYPE *ptype)
     iRETURN;
 }
 
+// prebuilt runs of indent characters, the leading white space is written
+// in as few pieces as these allow
+static const char _ion_writer_text_indent_spaces[] = "                                                                ";
+static const char _ion_writer_text_indent_tabs[]   = "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+
 iERR _ion_writer_text_print_leading_white_space(ION_WRITER *pwriter)
 {
     iENTER;
-    int ii;
+    const char *indent;
+    SIZE        remaining, run, run_max, written;
 
     if (pwriter->options.indent_with_tabs) {
-        for (ii = 0; ii < TEXTWRITER(pwriter)->_top; ii++) {
-            ION_TEXT_WRITER_APPEND_CHAR('\t');
-        }
+        indent = _ion_writer_text_indent_tabs;
+        run_max = (SIZE)sizeof(_ion_writer_text_indent_tabs) - 1;
+        remaining = TEXTWRITER(pwriter)->_top;
     }
     else {
-        for (ii = 0; ii < TEXTWRITER(pwriter)->_top * pwriter->options.indent_size; ii++) {
-            ION_TEXT_WRITER_APPEND_CHAR(' ');
-        }
+        indent = _ion_writer_text_indent_spaces;
+        run_max = (SIZE)sizeof(_ion_writer_text_indent_spaces) - 1;
+        remaining = TEXTWRITER(pwriter)->_top * pwriter->options.indent_size;
+    }
+
+    while (remaining > 0) {
+        run = (remaining < run_max) ? remaining : run_max;
+        IONCHECK(ion_stream_write(pwriter->output, (BYTE *)indent, run, &written));
+        if (written != run) FAILWITH(IERR_WRITE_ERROR);
+        remaining -= run;
     }
 
     iRETURN;
@@ -404,52 +451,28 @@ iERR _ion_writer_text_write_bool(ION_WRITER *pwriter, BOOL value)
 iERR _ion_writer_text_write_int64(ION_WRITER *pwriter, int64_t value)
 {
     iENTER;
-    char int_image[MAX_INT64_LENGTH + 1], *cp;  // +1 for null terminator
-    int  is_negative = FALSE, digit;
-    int64_t next;
+    BYTE    *int_image;
+    char    *cp;
+    uint64_t magnitude;
 
     IONCHECK(_ion_writer_text_start_value(pwriter));
 
-    // we'll be writting the sign at the beginning, so just
-    // save it off for the moment
-    if (value < 0) {
-        is_negative = TRUE;
-    }
-
-    // we'll be writing the digits backwards, so we first null
-    // terminate our output buffer
-    cp = int_image + MAX_INT64_LENGTH;
-    *cp = 0;
-    cp--;
+    // the digits are formatted front to back, directly into the output
+    // page when it has room for the longest image
+    IONCHECK(_ion_writer_text_reserve(pwriter, MAX_INT64_LENGTH, &int_image));
+    cp = (char *)int_image;
 
-    if (!value) {
-        // just dodge the edge case with leading zeros
-        *cp = '0';
-        cp--;
+    // the magnitude is computed unsigned so INT64_MIN doesn't overflow
+    if (value < 0) {
+        *cp++ = '-';
+        magnitude = (uint64_t)0 - (uint64_t)value;
     }
     else {
-        // this isn't the most efficient but is should be right
-        while (value) {
-            next = value / 10;
-            digit = value % 10;
-            if (is_negative) {
-                digit = -digit;
-            }
-            *cp = (char)digit + '0';
-            cp--;
-            value = next;
-        }
-
-        // only non-zero values can be negative
-        if (is_negative) {
-            ION_TEXT_WRITER_APPEND_CHAR('-');
-        }
+        magnitude = (uint64_t)value;
     }
+    cp = _ion_uint64_to_chars(magnitude, cp);
 
-    cp++;  // we always back up one too far
-
-    // now write the chars out in the right order
-    IONCHECK(_ion_writer_text_append_ascii_cstr(pwriter->output, cp));
+    IONCHECK(_ion_writer_text_commit(pwriter, int_image, (SIZE)((BYTE *)cp - int_image)));
 
     IONCHECK(_ion_writer_text_close_value(pwriter));
 
@@ -461,62 +484,25 @@ iERR _ion_writer_text_write_ion_int(ION_WRITER *pwriter, ION_INT *iint)
     iENTER;
     char      int_image_local_buffer[LOCAL_INT_CHAR_BUFFER_LENGTH + 1];  // +1 for null terminator
     char     *int_image = &int_image_local_buffer[0];
-    char     *cp, *end;
-    int       is_negative = FALSE, decimal_digits;
-    II_DIGIT  small_copy[II_SMALL_DIGIT_ARRAY_LENGTH];
-    II_DIGIT *digits = NULL, remainder;
-    SIZE    digits_length;
-
+    SIZE      image_length, char_length, written;
 
     IONCHECK(_ion_writer_text_start_value(pwriter));
 
-    decimal_digits = _ion_int_get_char_len_helper(iint);
-    if (decimal_digits < LOCAL_INT_CHAR_BUFFER_LENGTH) {
-        end = &int_image_local_buffer[LOCAL_INT_CHAR_BUFFER_LENGTH];
-    }
-    else {
-        int_image = ion_xalloc(decimal_digits + 1);
-        end = int_image + decimal_digits;
-    }
-
-    // we'll be writing the digits backwards, so we first null
-    // terminate our output buffer
-    cp = end;
-    *cp = 0;
-    cp--;
-
-    digits_length = iint->_len;
-    // don't mutate the user's data.
-    digits = _ion_int_buffer_temp_copy(iint->_digits, digits_length, small_copy, II_SMALL_DIGIT_ARRAY_LENGTH);
-    if (digits == NULL) {
-        FAILWITH(IERR_NO_MEMORY);
-    }
-    if (_ion_int_is_zero_bytes(digits, digits_length)) {
-        // just dodge the edge case with leading zeros
-        *cp = '0';
-        cp--;
+    // this is the upper bound, including the sign and null terminator
+    char_length = _ion_int_get_char_len_helper(iint);
+    if (char_length > LOCAL_INT_CHAR_BUFFER_LENGTH + 1) {
+        int_image = ion_xalloc(char_length);
+        if (int_image == NULL) {
+            FAILWITH(IERR_NO_MEMORY);
+        }
     }
     else {
-        // this isn't the most efficient but is should be right
-
-        for (;;) {
-            if (_ion_int_is_zero_bytes(digits, digits_length)) break;
-            IONCHECK(_ion_int_divide_by_digit(digits, digits_length, II_STRING_BASE, &remainder));
-            ASSERT(remainder >= 0 && remainder <= 9);
-            *cp = (BYTE)((remainder & 0xff)+'0');
-            cp--;
-        }
-
-        // only non-zero values can be negative
-        if (iint->_signum < 0) {
-            ION_TEXT_WRITER_APPEND_CHAR('-');
-        }
+        char_length = LOCAL_INT_CHAR_BUFFER_LENGTH + 1;
     }
 
-    cp++;  // we always back up one too far
-
-    // now write the chars out in the right order
-    IONCHECK(_ion_writer_text_append_ascii_cstr(pwriter->output, cp));
+    IONCHECK(_ion_int_to_string_helper(iint, int_image, char_length, &image_length));
+    IONCHECK(ion_stream_write(pwriter->output, (BYTE *)int_image, image_length, &written));
+    if (written != image_length) FAILWITH(IERR_WRITE_ERROR);
 
     IONCHECK(_ion_writer_text_close_value(pwriter));
 
@@ -524,7 +510,6 @@ fail:
     if (int_image != &int_image_local_buffer[0]) {
         ion_xfree(int_image);
     }
-    _ion_int_free_temp(digits, small_copy);
     RETURN(__file__, __line__, __count__, err);
 }
 
@@ -664,7 +649,8 @@ fail:
 iERR _ion_writer_text_write_decimal_quad(ION_WRITER *pwriter, decQuad *value)
 {
     iENTER;
-    char image[DECQUAD_String];
+    BYTE *image;
+    char *end;
 
     if (!pwriter) FAILWITH(IERR_BAD_HANDLE);
 
@@ -676,8 +662,28 @@ iERR _ion_writer_text_write_decimal_quad(ION_WRITER *pwriter, decQuad *value)
         SUCCEED();
     }
 
-    IONCHECK(_ion_decimal_to_string_quad_helper(value, image, ION_TEXT_WRITER_IS_JSON()));
-    IONCHECK(_ion_writer_text_append_ascii_cstr(pwriter->output, image));
+    // the coefficient and exponent are laid out directly in the output page
+    IONCHECK(_ion_writer_text_reserve(pwriter, ION_DECIMAL_QUAD_CHARS_MAX, &image));
+    end = _ion_decimal_quad_to_chars(value, (char *)image, ION_TEXT_WRITER_IS_JSON());
+    IONCHECK(_ion_writer_text_commit(pwriter, image, (SIZE)((BYTE *)end - image)));
+    IONCHECK(_ion_writer_text_close_value(pwriter));
+
+    iRETURN;
+}
+
+iERR _ion_writer_text_write_decimal_parts(ION_WRITER *pwriter, int64_t mantissa, int32_t exponent)
+{
+    iENTER;
+    BYTE *image;
+    char *end;
+
+    if (!pwriter) FAILWITH(IERR_BAD_HANDLE);
+
+    IONCHECK(_ion_writer_text_start_value(pwriter));
+
+    IONCHECK(_ion_writer_text_reserve(pwriter, ION_DECIMAL_QUAD_CHARS_MAX, &image));
+    end = _ion_decimal_int64_parts_to_chars(mantissa, exponent, (char *)image, ION_TEXT_WRITER_IS_JSON());
+    IONCHECK(_ion_writer_text_commit(pwriter, image, (SIZE)((BYTE *)end - image)));
     IONCHECK(_ion_writer_text_close_value(pwriter));
 
     iRETURN;
@@ -1237,13 +1243,21 @@ iERR _ion_writer_text_append_ascii_cstr(ION_STREAM *poutput, char *cp)
 {
     iENTER;
 
+    char *end;
+    SIZE  len, written;
+
     if (!poutput) FAILWITH(IERR_BAD_HANDLE);
     if (!cp) SUCCEED();
 
-    while (*cp) {
-        if (*cp > 127) FAILWITH(IERR_INVALID_ARG);
-        ION_PUT(poutput, *cp);
-        cp++;
+    for (end = cp; *end; end++) {
+        if (*end > 127) FAILWITH(IERR_INVALID_ARG);
+    }
+
+    // the whole token goes out in one write
+    len = (SIZE)(end - cp);
+    if (len > 0) {
+        IONCHECK(ion_stream_write(poutput, (BYTE *)cp, len, &written));
+        if (written != len) FAILWITH(IERR_WRITE_ERROR);
     }
 
     iRETURN;
@@ -1333,28 +1347,33 @@ iERR _ion_writer_text_append_escape_sequence_cstr(ION_STREAM *poutput, char *cp,
     iRETURN;
 }
 
-iERR _ion_writer_text_append_escaped_string_utf8(ION_STREAM *poutput, ION_STRING *p_str, char quote_char)
+// copies the bytes of [cp, limit) which are not in the escape set straight through
+// to the output, escaping the quote in use and whatever else the set tells us to
+static iERR _ion_writer_text_append_escaped_bytes(ION_STREAM *poutput, BYTE *cp, BYTE *limit, char quote_char, BOOL ascii_only, BOOL down_convert)
 {
     iENTER;
-    BYTE *cp, *limit;
-
-    if (!poutput) FAILWITH(IERR_BAD_HANDLE);
-    if (!p_str) FAILWITH(IERR_INVALID_ARG);
-    if (p_str->length < 0) FAILWITH(IERR_INVALID_ARG);
-    if (p_str->length == 0) SUCCEED();
+    const ION_BYTE_SET *set = ascii_only ? &_ion_byte_set_escape_ascii : &_ion_byte_set_escape_utf8;
+    BYTE *run_end;
+    SIZE  written;
 
-    cp = p_str->value;
-    limit = cp + p_str->length;
+    // the escape sets cover both quote characters and no others
+    ASSERT(quote_char == '"' || quote_char == '\'');
 
     while (cp < limit) {
-        // this only escapes chars < 32 or slash or quote character (single or double)
-        // utf8 sequences have the high bit set and will simply be treated
-        // as normal characters and pass through - at this point we don't
-        // validate that the sequences are valid
-        if (ION_WRITER_NEEDS_ESCAPE_UTF8(*cp) || (*cp == quote_char)) {
-            IONCHECK(_ion_writer_text_append_escape_sequence_string(poutput, FALSE, cp, limit, &cp));
+        run_end = (BYTE *)_ion_byte_scan_find(cp, limit, set);
+        if (run_end > cp) {
+            IONCHECK(ion_stream_write(poutput, cp, (SIZE)(run_end - cp), &written));
+            if (written != (SIZE)(run_end - cp)) FAILWITH(IERR_WRITE_ERROR);
+            cp = run_end;
+            if (cp >= limit) break;
+        }
+        if (*cp == (BYTE)quote_char
+         || (ascii_only ? ION_WRITER_NEEDS_ESCAPE_ASCII(*cp) : ION_WRITER_NEEDS_ESCAPE_UTF8(*cp))
+        ) {
+            IONCHECK(_ion_writer_text_append_escape_sequence_string(poutput, down_convert, cp, limit, &cp));
         }
         else {
+            // the other quote character
             ION_PUT(poutput, *cp);
             cp++;
         }
@@ -1363,29 +1382,35 @@ iERR _ion_writer_text_append_escaped_string_utf8(ION_STREAM *poutput, ION_STRING
     iRETURN;
 }
 
-iERR _ion_writer_text_append_escaped_string(ION_STREAM *poutput, ION_STRING *p_str, char quote_char, BOOL down_convert)
+iERR _ion_writer_text_append_escaped_string_utf8(ION_STREAM *poutput, ION_STRING *p_str, char quote_char)
 {
     iENTER;
-    BYTE *cp, *limit;
 
     if (!poutput) FAILWITH(IERR_BAD_HANDLE);
     if (!p_str) FAILWITH(IERR_INVALID_ARG);
     if (p_str->length < 0) FAILWITH(IERR_INVALID_ARG);
     if (p_str->length == 0) SUCCEED();
 
-    cp = p_str->value;
-    limit = cp + p_str->length;
+    // this only escapes chars < 32 or slash or quote character (single or double)
+    // utf8 sequences have the high bit set and will simply be treated
+    // as normal characters and pass through - at this point we don't
+    // validate that the sequences are valid
+    IONCHECK(_ion_writer_text_append_escaped_bytes(poutput, p_str->value, p_str->value + p_str->length, quote_char, FALSE, FALSE));
 
-    while (cp < limit) {
-        // this escapes <32, slash, double quotes AND utf8 sequences
-        if (ION_WRITER_NEEDS_ESCAPE_ASCII(*cp) || *cp == quote_char) {
-            IONCHECK(_ion_writer_text_append_escape_sequence_string(poutput, down_convert, cp, limit, &cp));
-        }
-        else {
-            ION_PUT(poutput, *cp);
-            cp++;
-        }
-    }
+    iRETURN;
+}
+
+iERR _ion_writer_text_append_escaped_string(ION_STREAM *poutput, ION_STRING *p_str, char quote_char, BOOL down_convert)
+{
+    iENTER;
+
+    if (!poutput) FAILWITH(IERR_BAD_HANDLE);
+    if (!p_str) FAILWITH(IERR_INVALID_ARG);
+    if (p_str->length < 0) FAILWITH(IERR_INVALID_ARG);
+    if (p_str->length == 0) SUCCEED();
+
+    // this escapes <32, slash, double quotes AND utf8 sequences
+    IONCHECK(_ion_writer_text_append_escaped_bytes(poutput, p_str->value, p_str->value + p_str->length, quote_char, TRUE, down_convert));
 
     iRETURN;
 }
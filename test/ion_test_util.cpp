@@ -46,6 +46,20 @@ iERR ion_test_writer_get_bytes(hWRITER writer, ION_STREAM *ion_stream, BYTE **ou
     iRETURN;
 }
 
+iERR ion_test_text_to_binary(const char *ion_text, BYTE **out, SIZE *len) {
+    iENTER;
+    hREADER reader = NULL;
+    hWRITER writer = NULL;
+    ION_STREAM *stream = NULL;
+    IONCHECK(ion_test_new_text_reader(ion_text, &reader));
+    IONCHECK(ion_test_new_writer(&writer, &stream, TRUE));
+    IONCHECK(ion_writer_write_all_values(writer, reader));
+    IONCHECK(ion_test_writer_get_bytes(writer, stream, out, len));
+fail:
+    if (reader) UPDATEERROR(ion_reader_close(reader));
+    RETURN(__location_name__, __line__, __count__++, err);
+}
+
 iERR ion_test_writer_write_symbol_sid(ION_WRITER *writer, SID sid) {
     iENTER;
     ION_SYMBOL symbol;
@@ -53,6 +53,15 @@ iERR ion_test_new_writer(hWRITER *writer, ION_STREAM **ion_stream, BOOL is_binar
  */
 iERR ion_test_writer_get_bytes(hWRITER writer, ION_STREAM *ion_stream, BYTE **out, SIZE *len);
 
+/**
+ * Re-encodes Ion text as binary.
+ * @param ion_text - the null-terminated Ion text.
+ * @param out - output parameter for the binary, which the caller frees.
+ * @param len - the length of the binary.
+ * @return IERR_OK, unless the text fails to parse or the binary fails to write.
+ */
+iERR ion_test_text_to_binary(const char *ion_text, BYTE **out, SIZE *len);
+
 /**
  * Creates an ION_SYMBOL with the given SID and calls `ion_writer_write_ion_symbol`.
  * @param writer - the writer to write to.
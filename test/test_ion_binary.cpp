@@ -18,6 +18,7 @@
 #include "ion_helpers.h"
 #include "ion_test_util.h"
 #include "ion_event_equivalence.h"
+#include <string>
 
 TEST(IonBinaryLen, UInt64) {
 
@@ -722,3 +723,854 @@ TEST(IonBinaryFloat, WriterSupportsCompactFloatsOption) {
     //    4    0    8    6    6    6    6    6
     test_ion_binary_writer_supports_compact_floats(TRUE, truncated, "\xE0\x01\x00\xEA\x44\x40\x86\x66\x66", 9);
 }
+
+void test_ion_binary_open_patching_writer(hWRITER *writer, ION_STREAM *stream, BOOL patch_lengths_in_output,
+                                          SIZE symbol_table_reserve) {
+    ION_WRITER_OPTIONS options;
+    memset(&options, 0, sizeof(options));
+    options.output_as_binary = TRUE;
+    options.patch_lengths_in_output = patch_lengths_in_output;
+    options.symbol_table_reserve = symbol_table_reserve;
+    ION_ASSERT_OK(ion_writer_open(writer, stream, &options));
+}
+
+// writes ann::[{f0:"v0",n:0,l:[0]}, ...] with count structs and field names from 'fields' different symbols
+void test_ion_binary_write_large_list(hWRITER writer, int count, int fields) {
+    char name[16], value[16];
+    ION_STRING str;
+    ION_ASSERT_OK(ion_writer_add_annotation(writer, ion_string_assign_cstr(&str, (char *)"ann", 3)));
+    ION_ASSERT_OK(ion_writer_start_container(writer, tid_LIST));
+    for (int i = 0; i < count; i++) {
+        ION_ASSERT_OK(ion_writer_start_container(writer, tid_STRUCT));
+        snprintf(name, sizeof(name), "f%d", i % fields);
+        snprintf(value, sizeof(value), "v%d", i);
+        ION_ASSERT_OK(ion_writer_write_field_name(writer, ion_string_assign_cstr(&str, name, (SIZE)strlen(name))));
+        ION_ASSERT_OK(ion_writer_write_string(writer, ion_string_assign_cstr(&str, value, (SIZE)strlen(value))));
+        ION_ASSERT_OK(ion_writer_write_field_name(writer, ion_string_assign_cstr(&str, (char *)"n", 1)));
+        ION_ASSERT_OK(ion_writer_write_int(writer, i));
+        ION_ASSERT_OK(ion_writer_write_field_name(writer, ion_string_assign_cstr(&str, (char *)"l", 1)));
+        ION_ASSERT_OK(ion_writer_start_container(writer, tid_LIST));
+        ION_ASSERT_OK(ion_writer_write_int(writer, i));
+        ION_ASSERT_OK(ion_writer_finish_container(writer));
+        ION_ASSERT_OK(ion_writer_finish_container(writer));
+    }
+    ION_ASSERT_OK(ion_writer_finish_container(writer));
+}
+
+void test_ion_binary_read_large_list(hREADER reader, int count, int fields) {
+    ION_TYPE type;
+    ION_STRING str;
+    char name[16], value[16];
+    int32_t n;
+    int32_t annotation_count;
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_LIST, type);
+    ION_ASSERT_OK(ion_reader_get_annotation_count(reader, &annotation_count));
+    ASSERT_EQ(1, annotation_count);
+    ION_ASSERT_OK(ion_reader_step_in(reader));
+    for (int i = 0; i < count; i++) {
+        ION_ASSERT_OK(ion_reader_next(reader, &type));
+        ASSERT_EQ(tid_STRUCT, type);
+        ION_ASSERT_OK(ion_reader_step_in(reader));
+        snprintf(name, sizeof(name), "f%d", i % fields);
+        snprintf(value, sizeof(value), "v%d", i);
+        ION_ASSERT_OK(ion_reader_next(reader, &type));
+        ION_ASSERT_OK(ion_reader_get_field_name(reader, &str));
+        ASSERT_EQ(std::string(name), std::string((char *)str.value, (size_t)str.length));
+        ION_ASSERT_OK(ion_reader_read_string(reader, &str));
+        ASSERT_EQ(std::string(value), std::string((char *)str.value, (size_t)str.length));
+        ION_ASSERT_OK(ion_reader_next(reader, &type));
+        ION_ASSERT_OK(ion_reader_read_int32(reader, &n));
+        ASSERT_EQ(i, n);
+        ION_ASSERT_OK(ion_reader_next(reader, &type));
+        ASSERT_EQ(tid_LIST, type);
+        ION_ASSERT_OK(ion_reader_step_in(reader));
+        ION_ASSERT_OK(ion_reader_next(reader, &type));
+        ION_ASSERT_OK(ion_reader_read_int32(reader, &n));
+        ASSERT_EQ(i, n);
+        ION_ASSERT_OK(ion_reader_next(reader, &type));
+        ASSERT_EQ(tid_EOF, type);
+        ION_ASSERT_OK(ion_reader_step_out(reader));
+        ION_ASSERT_OK(ion_reader_next(reader, &type));
+        ASSERT_EQ(tid_EOF, type);
+        ION_ASSERT_OK(ion_reader_step_out(reader));
+    }
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_EOF, type);
+    ION_ASSERT_OK(ion_reader_step_out(reader));
+}
+
+TEST(IonBinaryWriter, PatchLengthsInOutputMatchesBufferedOutputForSmallValues) {
+    hWRITER writer = NULL;
+    ION_STREAM *stream = NULL;
+    BYTE *buffered, *patched;
+    SIZE buffered_len, patched_len;
+
+    ION_ASSERT_OK(ion_stream_open_memory_only(&stream));
+    test_ion_binary_open_patching_writer(&writer, stream, FALSE, 0);
+    test_ion_binary_write_large_list(writer, 3, 2);
+    ION_ASSERT_OK(ion_test_writer_get_bytes(writer, stream, &buffered, &buffered_len));
+
+    ION_ASSERT_OK(ion_stream_open_memory_only(&stream));
+    test_ion_binary_open_patching_writer(&writer, stream, TRUE, 0);
+    test_ion_binary_write_large_list(writer, 3, 2);
+    ION_ASSERT_OK(ion_test_writer_get_bytes(writer, stream, &patched, &patched_len));
+
+    // everything is still in the stream's page when the list is finished, so
+    // the reserved lengths and symbol table space are squeezed out again
+    assertBytesEqual((const char *)buffered, buffered_len, patched, patched_len);
+
+    free(buffered);
+    free(patched);
+}
+
+TEST(IonBinaryWriter, PatchLengthsInOutputWritesLargeValuesToMemory) {
+    hWRITER writer = NULL;
+    hREADER reader = NULL;
+    ION_STREAM *stream = NULL;
+    BYTE *data;
+    SIZE data_len;
+    ION_TYPE type;
+
+    ION_ASSERT_OK(ion_stream_open_memory_only(&stream));
+    test_ion_binary_open_patching_writer(&writer, stream, TRUE, 0);
+    test_ion_binary_write_large_list(writer, 5000, 100);
+    test_ion_binary_write_large_list(writer, 5000, 200);
+    ION_ASSERT_OK(ion_test_writer_get_bytes(writer, stream, &data, &data_len));
+
+    ION_ASSERT_OK(ion_reader_open_buffer(&reader, data, data_len, NULL));
+    test_ion_binary_read_large_list(reader, 5000, 100);
+    test_ion_binary_read_large_list(reader, 5000, 200);
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_EOF, type);
+    ION_ASSERT_OK(ion_reader_close(reader));
+    free(data);
+}
+
+TEST(IonBinaryWriter, PatchLengthsInOutputWritesLargeValuesToFile) {
+    hWRITER writer = NULL;
+    hREADER reader = NULL;
+    ION_STREAM *stream = NULL;
+    ION_TYPE type;
+    ION_STRING str;
+    FILE *file = tmpfile();
+    ASSERT_TRUE(file != NULL);
+
+    ION_ASSERT_OK(ion_stream_open_file_out(file, &stream));
+    test_ion_binary_open_patching_writer(&writer, stream, TRUE, 0);
+    ION_ASSERT_OK(ion_writer_write_symbol(writer, ion_string_assign_cstr(&str, (char *)"before", 6)));
+    test_ion_binary_write_large_list(writer, 5000, 100);
+    test_ion_binary_write_large_list(writer, 5000, 200);
+    ION_ASSERT_OK(ion_writer_close(writer));
+    ION_ASSERT_OK(ion_stream_close(stream));
+
+    rewind(file);
+    ION_ASSERT_OK(ion_stream_open_file_in(file, &stream));
+    ION_ASSERT_OK(ion_reader_open(&reader, stream, NULL));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_SYMBOL, type);
+    ION_ASSERT_OK(ion_reader_read_string(reader, &str));
+    ASSERT_EQ(std::string("before"), std::string((char *)str.value, (size_t)str.length));
+    test_ion_binary_read_large_list(reader, 5000, 100);
+    test_ion_binary_read_large_list(reader, 5000, 200);
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_EOF, type);
+    ION_ASSERT_OK(ion_reader_close(reader));
+    ION_ASSERT_OK(ion_stream_close(stream));
+    fclose(file);
+}
+
+TEST(IonBinaryWriter, PatchLengthsInOutputFailsWhenSymbolsOutgrowReserve) {
+    hWRITER writer = NULL;
+    ION_STREAM *stream = NULL;
+    ION_STRING str;
+    char name[16];
+
+    ION_ASSERT_OK(ion_stream_open_memory_only(&stream));
+    test_ion_binary_open_patching_writer(&writer, stream, TRUE, 32);
+    ION_ASSERT_OK(ion_writer_start_container(writer, tid_LIST));
+    for (int i = 0; i < 20; i++) {
+        snprintf(name, sizeof(name), "symbol%d", i);
+        ION_ASSERT_OK(ion_writer_write_symbol(writer, ion_string_assign_cstr(&str, name, (SIZE)strlen(name))));
+    }
+    ASSERT_EQ(IERR_BUFFER_TOO_SMALL, ion_writer_finish_container(writer));
+    ion_writer_close(writer);
+    ION_ASSERT_OK(ion_stream_close(stream));
+}
+
+void test_ion_binary_open_writer_with_reserve(BOOL output_as_binary, BOOL patch_lengths_in_output, SIZE reserve) {
+    hWRITER writer = NULL;
+    ION_STREAM *stream = NULL;
+    ION_WRITER_OPTIONS options;
+
+    ION_ASSERT_OK(ion_stream_open_memory_only(&stream));
+    memset(&options, 0, sizeof(options));
+    options.output_as_binary = output_as_binary;
+    options.patch_lengths_in_output = patch_lengths_in_output;
+    options.symbol_table_reserve = reserve;
+    ION_ASSERT_OK(ion_writer_open(&writer, stream, &options));
+    ION_ASSERT_OK(ion_writer_write_int(writer, 7));
+    ION_ASSERT_OK(ion_writer_close(writer));
+    ION_ASSERT_OK(ion_stream_close(stream));
+}
+
+TEST(IonBinaryWriter, PatchLengthsInOutputRejectsNegativeReserve) {
+    hWRITER writer = NULL;
+    ION_STREAM *stream = NULL;
+    ION_WRITER_OPTIONS options;
+    hREADER reader;
+    ION_TYPE type;
+    int32_t value;
+    BYTE *bytes;
+    SIZE len;
+
+    ION_ASSERT_OK(ion_stream_open_memory_only(&stream));
+    memset(&options, 0, sizeof(options));
+    options.output_as_binary = TRUE;
+    options.patch_lengths_in_output = TRUE;
+    options.symbol_table_reserve = -1;
+    ASSERT_EQ(IERR_INVALID_ARG, ion_writer_open(&writer, stream, &options));
+
+    // the reserve is only used when patching binary output, so it isn't checked otherwise
+    test_ion_binary_open_writer_with_reserve(FALSE, TRUE, -1);
+    test_ion_binary_open_writer_with_reserve(TRUE, FALSE, -1);
+
+    // a single byte is the smallest nop pad, and enough when the container adds no symbols
+    test_ion_binary_open_patching_writer(&writer, stream, TRUE, 1);
+    ION_ASSERT_OK(ion_writer_start_container(writer, tid_LIST));
+    ION_ASSERT_OK(ion_writer_write_int(writer, 7));
+    ION_ASSERT_OK(ion_writer_finish_container(writer));
+    ION_ASSERT_OK(ion_test_writer_get_bytes(writer, stream, &bytes, &len));
+
+    ION_ASSERT_OK(ion_reader_open_buffer(&reader, bytes, len, NULL));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_LIST, type);
+    ION_ASSERT_OK(ion_reader_step_in(reader));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ION_ASSERT_OK(ion_reader_read_int32(reader, &value));
+    ASSERT_EQ(7, value);
+    ION_ASSERT_OK(ion_reader_close(reader));
+    free(bytes);
+}
+
+TEST(IonBinaryReader, GetValueBytesReturnsEncodedValues) {
+    hREADER reader;
+    // name::1 "hi" {name:5} name::version::2
+    BYTE *data = (BYTE *)"\xE0\x01\x00\xEA\xE4\x81\x84\x21\x01\x82\x68\x69\xD3\x84\x21\x05\xE5\x82\x84\x85\x21\x02";
+    ION_TYPE type;
+    BYTE *start;
+    SIZE length;
+
+    ION_ASSERT_OK(ion_reader_open_buffer(&reader, data, 22, NULL));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_INT, type);
+    ION_ASSERT_OK(ion_reader_get_value_bytes(reader, &start, &length));
+    ASSERT_EQ(data + 4, start);
+    ASSERT_EQ(5, length);
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_STRING, type);
+    ION_ASSERT_OK(ion_reader_get_value_bytes(reader, &start, &length));
+    ASSERT_EQ(data + 9, start);
+    ASSERT_EQ(3, length);
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_STRUCT, type);
+    ION_ASSERT_OK(ion_reader_get_value_bytes(reader, &start, &length));
+    ASSERT_EQ(data + 12, start);
+    ASSERT_EQ(4, length);
+    ION_ASSERT_OK(ion_reader_step_in(reader));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_INT, type);
+    // the field name is not part of the value
+    ION_ASSERT_OK(ion_reader_get_value_bytes(reader, &start, &length));
+    ASSERT_EQ(data + 14, start);
+    ASSERT_EQ(2, length);
+    ION_ASSERT_OK(ion_reader_step_out(reader));
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_INT, type);
+    ION_ASSERT_OK(ion_reader_get_value_bytes(reader, &start, &length));
+    ASSERT_EQ(data + 16, start);
+    ASSERT_EQ(6, length);
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_EOF, type);
+    ASSERT_EQ(IERR_INVALID_STATE, ion_reader_get_value_bytes(reader, &start, &length));
+    ION_ASSERT_OK(ion_reader_close(reader));
+}
+
+TEST(IonBinaryReader, GetValueBytesFailsForTextReader) {
+    hREADER reader;
+    ION_TYPE type;
+    BYTE *start;
+    SIZE length;
+
+    ION_ASSERT_OK(ion_reader_open_buffer(&reader, (BYTE *)"123", 3, NULL));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(IERR_INVALID_STATE, ion_reader_get_value_bytes(reader, &start, &length));
+    ION_ASSERT_OK(ion_reader_close(reader));
+}
+
+TEST(IonBinaryReader, ReaderDecodesAnnotationsAfterValue) {
+    hREADER reader;
+    // name::version::2
+    BYTE *data = (BYTE *)"\xE0\x01\x00\xEA\xE5\x82\x84\x85\x21\x02";
+    ION_TYPE type;
+    int64_t value;
+    int32_t count;
+    ION_STRING annotations[2];
+    SIZE annotation_count;
+    BOOL found;
+
+    ION_ASSERT_OK(ion_reader_open_buffer(&reader, data, 10, NULL));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_INT, type);
+    ION_ASSERT_OK(ion_reader_read_int64(reader, &value));
+    ASSERT_EQ(2, value);
+    ION_ASSERT_OK(ion_reader_get_annotation_count(reader, &count));
+    ASSERT_EQ(2, count);
+    ION_ASSERT_OK(ion_reader_get_annotations(reader, annotations, 2, &annotation_count));
+    ASSERT_EQ(2, annotation_count);
+    ASSERT_EQ(std::string("name"), std::string((char *)annotations[0].value, (size_t)annotations[0].length));
+    ASSERT_EQ(std::string("version"), std::string((char *)annotations[1].value, (size_t)annotations[1].length));
+    ION_ASSERT_OK(ion_reader_has_annotation(reader, ion_string_assign_cstr(&annotations[0], (char *)"version", 7), &found));
+    ASSERT_TRUE(found);
+    ION_ASSERT_OK(ion_reader_close(reader));
+}
+
+TEST(IonBinaryReader, ReaderRejectsTruncatedAnnotationSidWhenAccessed) {
+    hREADER reader;
+    // the only annotation sid is missing its end bit
+    BYTE *data = (BYTE *)"\xE0\x01\x00\xEA\xE4\x81\x04\x21\x01";
+    ION_TYPE type;
+    int32_t count;
+
+    ION_ASSERT_OK(ion_reader_open_buffer(&reader, data, 9, NULL));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_INT, type);
+    ASSERT_EQ(IERR_INVALID_BINARY, ion_reader_get_annotation_count(reader, &count));
+    ION_ASSERT_OK(ion_reader_close(reader));
+}
+
+TEST(IonBinaryReader, PinValueViewPointsIntoBuffer) {
+    hREADER reader;
+    // "hello" {{0x01 0x02}} null.string
+    BYTE *data = (BYTE *)"\xE0\x01\x00\xEA\x85hello\xA2\x01\x02\x8F";
+    ION_TYPE type;
+    ION_STRING slice;
+    SIZE slice_count;
+
+    ION_ASSERT_OK(ion_reader_open_buffer(&reader, data, 16, NULL));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_STRING, type);
+    ION_ASSERT_OK(ion_reader_pin_value_view(reader, &slice, 1, &slice_count));
+    ASSERT_EQ(1, slice_count);
+    ASSERT_EQ(data + 5, slice.value);
+    ASSERT_EQ(5, slice.length);
+    // the value has been consumed
+    ASSERT_EQ(IERR_INVALID_STATE, ion_reader_pin_value_view(reader, &slice, 1, &slice_count));
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_BLOB, type);
+    ION_ASSERT_OK(ion_reader_pin_value_view(reader, &slice, 1, &slice_count));
+    ASSERT_EQ(1, slice_count);
+    ASSERT_EQ(data + 11, slice.value);
+    ASSERT_EQ(2, slice.length);
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_STRING, type);
+    ASSERT_EQ(IERR_NULL_VALUE, ion_reader_pin_value_view(reader, &slice, 1, &slice_count));
+
+    ION_ASSERT_OK(ion_reader_unpin_value_view(reader));
+    ION_ASSERT_OK(ion_reader_unpin_value_view(reader));
+    ASSERT_EQ(IERR_INVALID_STATE, ion_reader_unpin_value_view(reader));
+    ION_ASSERT_OK(ion_reader_close(reader));
+}
+
+TEST(IonBinaryReader, PinValueViewRejectsInvalidUtf8) {
+    hREADER reader;
+    BYTE *data = (BYTE *)"\xE0\x01\x00\xEA\x82\x61\xC3";
+    ION_TYPE type;
+    ION_STRING slice;
+    SIZE slice_count;
+
+    ION_ASSERT_OK(ion_reader_open_buffer(&reader, data, 7, NULL));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_STRING, type);
+    ASSERT_EQ(IERR_INVALID_UTF8, ion_reader_pin_value_view(reader, &slice, 1, &slice_count));
+    // the failed view does not stay pinned
+    ASSERT_EQ(IERR_INVALID_STATE, ion_reader_unpin_value_view(reader));
+    ION_ASSERT_OK(ion_reader_close(reader));
+}
+
+static const char *test_find_field_ion =
+    "{a:1, skipped:note::\"x\", nested:{a:5, c:false}, b:[1, 2], c:true, a:7} 42 {version:1, name:\"n\"}";
+
+static void test_find_field(hREADER reader) {
+    ION_TYPE type;
+    ION_STRING name;
+    BOOL value;
+    int64_t int_value;
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_STRUCT, type);
+    ASSERT_EQ(IERR_INVALID_STATE, ion_reader_find_field(reader, ion_string_assign_cstr(&name, (char *)"a", 1), &type));
+    ION_ASSERT_OK(ion_reader_step_in(reader));
+
+    ION_ASSERT_OK(ion_reader_find_field(reader, ion_string_assign_cstr(&name, (char *)"c", 1), &type));
+    ASSERT_EQ(tid_BOOL, type);
+    ION_ASSERT_OK(ion_reader_read_bool(reader, &value));
+    ASSERT_TRUE(value);
+    // only fields after the current one are searched
+    ION_ASSERT_OK(ion_reader_find_field(reader, ion_string_assign_cstr(&name, (char *)"a", 1), &type));
+    ASSERT_EQ(tid_INT, type);
+    ION_ASSERT_OK(ion_reader_read_int64(reader, &int_value));
+    ASSERT_EQ(7, int_value);
+    ION_ASSERT_OK(ion_reader_find_field(reader, ion_string_assign_cstr(&name, (char *)"a", 1), &type));
+    ASSERT_EQ(tid_EOF, type);
+    ION_ASSERT_OK(ion_reader_step_out(reader));
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_INT, type);
+    ION_ASSERT_OK(ion_reader_read_int64(reader, &int_value));
+    ASSERT_EQ(42, int_value);
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_STRUCT, type);
+    ION_ASSERT_OK(ion_reader_step_in(reader));
+    ION_ASSERT_OK(ion_reader_find_field(reader, ion_string_assign_cstr(&name, (char *)"missing", 7), &type));
+    ASSERT_EQ(tid_EOF, type);
+    ION_ASSERT_OK(ion_reader_step_out(reader));
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_EOF, type);
+}
+
+TEST(IonBinaryReader, FindFieldSkipsToNamedField) {
+    hREADER reader;
+    BYTE *data;
+    SIZE data_len;
+
+    ION_ASSERT_OK(ion_test_text_to_binary(test_find_field_ion, &data, &data_len));
+
+    ION_ASSERT_OK(ion_test_new_reader(data, data_len, &reader));
+    test_find_field(reader);
+    ION_ASSERT_OK(ion_reader_close(reader));
+    free(data);
+}
+
+TEST(IonTextReader, FindFieldSkipsToNamedField) {
+    hREADER reader;
+
+    ION_ASSERT_OK(ion_test_new_text_reader(test_find_field_ion, &reader));
+    test_find_field(reader);
+    ION_ASSERT_OK(ion_reader_close(reader));
+}
+
+TEST(IonBinaryReader, FindFieldBySid) {
+    hREADER reader;
+    // {version:1, name:"n", name:"m"} using the system symbols 5 (version) and 4 (name)
+    BYTE *data = (BYTE *)"\xE0\x01\x00\xEA\xD9\x85\x21\x01\x84\x81\x6E\x84\x81\x6D";
+    ION_TYPE type;
+    ION_STRING str;
+
+    ION_ASSERT_OK(ion_reader_open_buffer(&reader, data, 14, NULL));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_STRUCT, type);
+    ION_ASSERT_OK(ion_reader_step_in(reader));
+    ION_ASSERT_OK(ion_reader_find_field_sid(reader, 4, &type));
+    ASSERT_EQ(tid_STRING, type);
+    // the second field is found without reading the first one's value
+    ION_ASSERT_OK(ion_reader_find_field_sid(reader, 4, &type));
+    ASSERT_EQ(tid_STRING, type);
+    ION_ASSERT_OK(ion_reader_read_string(reader, &str));
+    ASSERT_EQ(std::string("m"), std::string((char *)str.value, (size_t)str.length));
+    ION_ASSERT_OK(ion_reader_find_field_sid(reader, 4, &type));
+    ASSERT_EQ(tid_EOF, type);
+    ION_ASSERT_OK(ion_reader_step_out(reader));
+    ION_ASSERT_OK(ion_reader_close(reader));
+}
+
+static const char *test_index_struct_ion =
+    "{a:1, b:\"two\", c:{d:4, g:8}, e:[5], a:6, f:note::7} 9";
+
+static void test_index_struct(hREADER reader) {
+    ION_TYPE type;
+    ION_STRING name, str;
+    int64_t value;
+    BOOL found;
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_STRUCT, type);
+    ION_ASSERT_OK(ion_reader_step_in(reader));
+    ION_ASSERT_OK(ion_reader_index_struct(reader));
+
+    ION_ASSERT_OK(ion_reader_seek_field(reader, ion_string_assign_cstr(&name, (char *)"c", 1), &type));
+    ASSERT_EQ(tid_STRUCT, type);
+    ION_ASSERT_OK(ion_reader_step_in(reader));
+    ION_ASSERT_OK(ion_reader_index_struct(reader));
+    ION_ASSERT_OK(ion_reader_seek_field(reader, ion_string_assign_cstr(&name, (char *)"g", 1), &type));
+    ASSERT_EQ(tid_INT, type);
+    ION_ASSERT_OK(ion_reader_read_int64(reader, &value));
+    ASSERT_EQ(8, value);
+    ION_ASSERT_OK(ion_reader_seek_field(reader, ion_string_assign_cstr(&name, (char *)"d", 1), &type));
+    ASSERT_EQ(tid_INT, type);
+    ION_ASSERT_OK(ion_reader_read_int64(reader, &value));
+    ASSERT_EQ(4, value);
+    ION_ASSERT_OK(ion_reader_step_out(reader));
+
+    ION_ASSERT_OK(ion_reader_seek_field(reader, ion_string_assign_cstr(&name, (char *)"f", 1), &type));
+    ASSERT_EQ(tid_INT, type);
+    ION_ASSERT_OK(ion_reader_has_annotation(reader, ion_string_assign_cstr(&name, (char *)"note", 4), &found));
+    ASSERT_TRUE(found);
+    ION_ASSERT_OK(ion_reader_read_int64(reader, &value));
+    ASSERT_EQ(7, value);
+
+    // a repeated name finds its first field, and next() carries on from there
+    ION_ASSERT_OK(ion_reader_seek_field(reader, ion_string_assign_cstr(&name, (char *)"a", 1), &type));
+    ASSERT_EQ(tid_INT, type);
+    ION_ASSERT_OK(ion_reader_read_int64(reader, &value));
+    ASSERT_EQ(1, value);
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_STRING, type);
+    ION_ASSERT_OK(ion_reader_read_string(reader, &str));
+    ASSERT_EQ(std::string("two"), std::string((char *)str.value, (size_t)str.length));
+
+    ION_ASSERT_OK(ion_reader_seek_field(reader, ion_string_assign_cstr(&name, (char *)"missing", 7), &type));
+    ASSERT_EQ(tid_EOF, type);
+    ION_ASSERT_OK(ion_reader_seek_field(reader, ion_string_assign_cstr(&name, (char *)"e", 1), &type));
+    ASSERT_EQ(tid_LIST, type);
+    ION_ASSERT_OK(ion_reader_step_out(reader));
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_INT, type);
+    ION_ASSERT_OK(ion_reader_read_int64(reader, &value));
+    ASSERT_EQ(9, value);
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_EOF, type);
+}
+
+TEST(IonBinaryReader, IndexedStructSeeksFieldsInAnyOrder) {
+    hREADER reader;
+    BYTE *data;
+    SIZE data_len;
+
+    ION_ASSERT_OK(ion_test_text_to_binary(test_index_struct_ion, &data, &data_len));
+    ION_ASSERT_OK(ion_test_new_reader(data, data_len, &reader));
+    test_index_struct(reader);
+    ION_ASSERT_OK(ion_reader_close(reader));
+    free(data);
+}
+
+TEST(IonBinaryReader, IndexStructMustPrecedeFirstField) {
+    hREADER reader;
+    BYTE *data;
+    SIZE data_len;
+    ION_TYPE type;
+    ION_STRING name;
+
+    ION_ASSERT_OK(ion_test_text_to_binary(test_index_struct_ion, &data, &data_len));
+    ION_ASSERT_OK(ion_test_new_reader(data, data_len, &reader));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(IERR_INVALID_STATE, ion_reader_index_struct(reader));
+    ION_ASSERT_OK(ion_reader_step_in(reader));
+    ASSERT_EQ(IERR_INVALID_STATE, ion_reader_seek_field(reader, ion_string_assign_cstr(&name, (char *)"a", 1), &type));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(IERR_INVALID_STATE, ion_reader_index_struct(reader));
+    ION_ASSERT_OK(ion_reader_close(reader));
+    free(data);
+}
+
+TEST(IonTextReader, IndexStructIsNotSupported) {
+    hREADER reader;
+    ION_TYPE type;
+
+    ION_ASSERT_OK(ion_test_new_text_reader(test_index_struct_ion, &reader));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ION_ASSERT_OK(ion_reader_step_in(reader));
+    ASSERT_EQ(IERR_INVALID_STATE, ion_reader_index_struct(reader));
+    ION_ASSERT_OK(ion_reader_close(reader));
+}
+
+typedef struct {
+    int64_t x;
+    int64_t y;
+} test_layout_point;
+
+typedef struct {
+    int64_t     id;
+    double      price;
+    BOOL        paid;
+    ION_STRING  name;
+    ION_STRING  tag;
+    ION_STRING  data;
+    ION_TIMESTAMP when;
+    test_layout_point point;
+    int64_t     missing;
+} test_layout_order;
+
+static const char *test_read_struct_into_ion =
+    "{id:7, extra:[1, 2], price:2.5e0, paid:true, name:\"widget\", tag:blue, data:{{aGVsbG8=}},"
+    " when:2020-01-02T03:04:05Z, point:{y:2, x:1, z:3}, missing:null, id:8}"
+    " {id:9, name:null} 10";
+
+static void test_layout_create(hREADER reader, hLAYOUT *p_layout) {
+    ION_READER_LAYOUT_FIELD point_fields[2], order_fields[9];
+    hLAYOUT point_layout;
+
+    memset(point_fields, 0, sizeof(point_fields));
+    memset(order_fields, 0, sizeof(order_fields));
+    ion_string_assign_cstr(&point_fields[0].name, (char *)"x", 1);
+    point_fields[0].type = tid_INT;
+    point_fields[0].offset = offsetof(test_layout_point, x);
+    ion_string_assign_cstr(&point_fields[1].name, (char *)"y", 1);
+    point_fields[1].type = tid_INT;
+    point_fields[1].offset = offsetof(test_layout_point, y);
+    ION_ASSERT_OK(ion_reader_create_layout(reader, point_fields, 2, &point_layout));
+
+    ion_string_assign_cstr(&order_fields[0].name, (char *)"id", 2);
+    order_fields[0].type = tid_INT;
+    order_fields[0].offset = offsetof(test_layout_order, id);
+    ion_string_assign_cstr(&order_fields[1].name, (char *)"price", 5);
+    order_fields[1].type = tid_FLOAT;
+    order_fields[1].offset = offsetof(test_layout_order, price);
+    ion_string_assign_cstr(&order_fields[2].name, (char *)"paid", 4);
+    order_fields[2].type = tid_BOOL;
+    order_fields[2].offset = offsetof(test_layout_order, paid);
+    ion_string_assign_cstr(&order_fields[3].name, (char *)"name", 4);
+    order_fields[3].type = tid_STRING;
+    order_fields[3].offset = offsetof(test_layout_order, name);
+    ion_string_assign_cstr(&order_fields[4].name, (char *)"tag", 3);
+    order_fields[4].type = tid_SYMBOL;
+    order_fields[4].offset = offsetof(test_layout_order, tag);
+    ion_string_assign_cstr(&order_fields[5].name, (char *)"data", 4);
+    order_fields[5].type = tid_BLOB;
+    order_fields[5].offset = offsetof(test_layout_order, data);
+    ion_string_assign_cstr(&order_fields[6].name, (char *)"when", 4);
+    order_fields[6].type = tid_TIMESTAMP;
+    order_fields[6].offset = offsetof(test_layout_order, when);
+    ion_string_assign_cstr(&order_fields[7].name, (char *)"point", 5);
+    order_fields[7].type = tid_STRUCT;
+    order_fields[7].offset = offsetof(test_layout_order, point);
+    order_fields[7].layout = point_layout;
+    ion_string_assign_cstr(&order_fields[8].name, (char *)"missing", 7);
+    order_fields[8].type = tid_INT;
+    order_fields[8].offset = offsetof(test_layout_order, missing);
+    ION_ASSERT_OK(ion_reader_create_layout(reader, order_fields, 9, p_layout));
+}
+
+static void test_read_struct_into(hREADER reader) {
+    hLAYOUT layout;
+    test_layout_order order;
+    ION_TYPE type;
+    ION_STRING name;
+    int64_t value;
+    int year, month, day, hour, minute, second;
+
+    test_layout_create(reader, &layout);
+    memset(&order, 0, sizeof(order));
+    order.missing = -1;
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_STRUCT, type);
+    ION_ASSERT_OK(ion_reader_read_struct_into(reader, layout, &order));
+    ASSERT_EQ(8, order.id); // the last of a repeated field wins
+    ASSERT_EQ(2.5, order.price);
+    ASSERT_TRUE(order.paid);
+    ASSERT_EQ(std::string("widget"), std::string((char *)order.name.value, (size_t)order.name.length));
+    ASSERT_EQ(std::string("blue"), std::string((char *)order.tag.value, (size_t)order.tag.length));
+    ASSERT_EQ(std::string("hello"), std::string((char *)order.data.value, (size_t)order.data.length));
+    ION_ASSERT_OK(ion_timestamp_get_thru_second(&order.when, &year, &month, &day, &hour, &minute, &second));
+    ASSERT_EQ(2020, year);
+    ASSERT_EQ(2, day);
+    ASSERT_EQ(5, second);
+    ASSERT_EQ(1, order.point.x);
+    ASSERT_EQ(2, order.point.y);
+    ASSERT_EQ(-1, order.missing);
+
+    // nulls leave the destination as it was. the old name's bytes belong to the previous top level value, so
+    // only the pointer is compared
+    name = order.name;
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_STRUCT, type);
+    ION_ASSERT_OK(ion_reader_read_struct_into(reader, layout, &order));
+    ASSERT_EQ(9, order.id);
+    ASSERT_EQ(name.value, order.name.value);
+    ASSERT_EQ(name.length, order.name.length);
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_INT, type);
+    ASSERT_EQ(IERR_INVALID_STATE, ion_reader_read_struct_into(reader, layout, &order));
+    ION_ASSERT_OK(ion_reader_read_int64(reader, &value));
+    ASSERT_EQ(10, value);
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_EOF, type);
+}
+
+TEST(IonBinaryReader, ReadStructIntoFillsLayout) {
+    hREADER reader;
+    BYTE *data;
+    SIZE data_len;
+
+    ION_ASSERT_OK(ion_test_text_to_binary(test_read_struct_into_ion, &data, &data_len));
+
+    ION_ASSERT_OK(ion_test_new_reader(data, data_len, &reader));
+    test_read_struct_into(reader);
+    ION_ASSERT_OK(ion_reader_close(reader));
+    free(data);
+}
+
+TEST(IonTextReader, ReadStructIntoFillsLayout) {
+    hREADER reader;
+
+    ION_ASSERT_OK(ion_test_new_text_reader(test_read_struct_into_ion, &reader));
+    test_read_struct_into(reader);
+    ION_ASSERT_OK(ion_reader_close(reader));
+}
+
+TEST(IonBinaryReader, ReadStructIntoFollowsSymbolTableChanges) {
+    hREADER reader;
+    hLAYOUT layout;
+    test_layout_order order;
+    ION_TYPE type;
+    BYTE *first, *second;
+    SIZE first_len, second_len;
+    std::string data;
+    const char *ion[] = { "{id:1, name:\"a\"}", "{other:0, name:\"b\", id:2}" };
+
+    // two streams, each with its own symbol table and the names at different sids
+    ION_ASSERT_OK(ion_test_text_to_binary(ion[0], &first, &first_len));
+    ION_ASSERT_OK(ion_test_text_to_binary(ion[1], &second, &second_len));
+    data.append((char *)first, (size_t)first_len);
+    data.append((char *)second, (size_t)second_len);
+
+    ION_ASSERT_OK(ion_test_new_reader((BYTE *)data.data(), (SIZE)data.size(), &reader));
+    test_layout_create(reader, &layout);
+    memset(&order, 0, sizeof(order));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ION_ASSERT_OK(ion_reader_read_struct_into(reader, layout, &order));
+    ASSERT_EQ(1, order.id);
+    ASSERT_EQ(std::string("a"), std::string((char *)order.name.value, (size_t)order.name.length));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ION_ASSERT_OK(ion_reader_read_struct_into(reader, layout, &order));
+    ASSERT_EQ(2, order.id);
+    ASSERT_EQ(std::string("b"), std::string((char *)order.name.value, (size_t)order.name.length));
+    ION_ASSERT_OK(ion_reader_close(reader));
+    free(first);
+    free(second);
+}
+
+static const char *test_read_struct_into_failure_ion =
+    "{id:1, point:{x:\"one\", y:2}} {id:99999999999999999999} {id:\"x\", price:1e0} 5";
+
+static void test_read_struct_into_failure(hREADER reader) {
+    hLAYOUT layout;
+    test_layout_order order;
+    ION_TYPE type;
+    SIZE depth;
+    int64_t value;
+
+    test_layout_create(reader, &layout);
+    memset(&order, 0, sizeof(order));
+
+    // a failure in a nested struct, an overflow and a type mismatch each leave the reader after their struct
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(IERR_INVALID_STATE, ion_reader_read_struct_into(reader, layout, &order));
+    ASSERT_EQ(1, order.id);
+    ION_ASSERT_OK(ion_reader_get_depth(reader, &depth));
+    ASSERT_EQ(0, depth);
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_STRUCT, type);
+    ASSERT_EQ(IERR_NUMERIC_OVERFLOW, ion_reader_read_struct_into(reader, layout, &order));
+    ION_ASSERT_OK(ion_reader_get_depth(reader, &depth));
+    ASSERT_EQ(0, depth);
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_STRUCT, type);
+    ASSERT_EQ(IERR_INVALID_STATE, ion_reader_read_struct_into(reader, layout, &order));
+    ION_ASSERT_OK(ion_reader_get_depth(reader, &depth));
+    ASSERT_EQ(0, depth);
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_INT, type);
+    ION_ASSERT_OK(ion_reader_read_int64(reader, &value));
+    ASSERT_EQ(5, value);
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_EOF, type);
+}
+
+TEST(IonBinaryReader, ReadStructIntoStepsOutOnFailure) {
+    hREADER reader;
+    BYTE *data;
+    SIZE data_len;
+
+    ION_ASSERT_OK(ion_test_text_to_binary(test_read_struct_into_failure_ion, &data, &data_len));
+    ION_ASSERT_OK(ion_test_new_reader(data, data_len, &reader));
+    test_read_struct_into_failure(reader);
+    ION_ASSERT_OK(ion_reader_close(reader));
+    free(data);
+}
+
+TEST(IonTextReader, ReadStructIntoStepsOutOnFailure) {
+    hREADER reader;
+
+    ION_ASSERT_OK(ion_test_new_text_reader(test_read_struct_into_failure_ion, &reader));
+    test_read_struct_into_failure(reader);
+    ION_ASSERT_OK(ion_reader_close(reader));
+}
+
+TEST(IonBinaryReader, ReadStructIntoMatchesEverySidOfAName) {
+    // a local symbol table of six "a"s, more than the layout's slots start with, then {$10:1} {$15:2}
+    BYTE data[] = {0xE0, 0x01, 0x00, 0xEA, 0xEE, 0x92, 0x81, 0x83, 0xDE, 0x8E, 0x87, 0xBC,
+                   0x81, 0x61, 0x81, 0x61, 0x81, 0x61, 0x81, 0x61, 0x81, 0x61, 0x81, 0x61,
+                   0xD3, 0x8A, 0x21, 0x01, 0xD3, 0x8F, 0x21, 0x02};
+    hREADER reader;
+    hLAYOUT layout;
+    ION_READER_LAYOUT_FIELD field;
+    ION_TYPE type;
+    int64_t a = 0;
+
+    ION_ASSERT_OK(ion_test_new_reader(data, (SIZE)sizeof(data), &reader));
+    memset(&field, 0, sizeof(field));
+    ion_string_assign_cstr(&field.name, (char *)"a", 1);
+    field.type = tid_INT;
+    field.offset = 0;
+    ION_ASSERT_OK(ion_reader_create_layout(reader, &field, 1, &layout));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ION_ASSERT_OK(ion_reader_read_struct_into(reader, layout, &a));
+    ASSERT_EQ(1, a);
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ION_ASSERT_OK(ion_reader_read_struct_into(reader, layout, &a));
+    ASSERT_EQ(2, a);
+    ION_ASSERT_OK(ion_reader_close(reader));
+}
+
+TEST(IonBinaryReader, ReadStructIntoRejectsMismatchedTypes) {
+    hREADER reader;
+    hLAYOUT layout;
+    test_layout_order order;
+    ION_TYPE type;
+    ION_READER_LAYOUT_FIELD fields[2];
+    BYTE *data;
+    SIZE data_len;
+
+    ION_ASSERT_OK(ion_test_text_to_binary("{id:\"seven\"}", &data, &data_len));
+
+    ION_ASSERT_OK(ion_test_new_reader(data, data_len, &reader));
+    memset(fields, 0, sizeof(fields));
+    ion_string_assign_cstr(&fields[0].name, (char *)"id", 2);
+    fields[0].type = tid_INT;
+    fields[0].offset = offsetof(test_layout_order, id);
+    fields[1] = fields[0];
+    ASSERT_EQ(IERR_INVALID_ARG, ion_reader_create_layout(reader, fields, 2, &layout));
+    fields[1].type = tid_STRUCT;
+    ion_string_assign_cstr(&fields[1].name, (char *)"point", 5);
+    ASSERT_EQ(IERR_INVALID_ARG, ion_reader_create_layout(reader, fields, 2, &layout));
+    ION_ASSERT_OK(ion_reader_create_layout(reader, fields, 1, &layout));
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(IERR_INVALID_STATE, ion_reader_read_struct_into(reader, layout, &order));
+    ION_ASSERT_OK(ion_reader_close(reader));
+    free(data);
+}
@@ -275,6 +275,143 @@ TEST(IonBinaryDecimal, ReaderAlwaysPreservesUpTo34Digits) {
     ION_DECIMAL_FREE_2(&ion_decimal_before, &ion_decimal_after);
 }
 
+TEST(IonTextDecimal, ReaderReadsSmallDecimalsExactly) {
+    // These fit the scanner's small form, which builds the decQuad without parsing the text again.
+    const char *text_decimal = "1.250 -0.0 0. 0.000123 12d-3 -1_000.000_5 999999999999999999d6111 -123456789012345678.9 "
+                               "1234567890123456789.0";
+    const char *expected[] = {
+        "1.250", "-0.0", "0.", "0.000123", "12d-3", "-1000.0005", "999999999999999999d6111", "-123456789012345678.9",
+        "1234567890123456789.0"
+    };
+    ION_DECIMAL actual, expected_decimal;
+    decContext  context;
+
+    decContextDefault(&context, DEC_INIT_DECQUAD);
+    ION_DECIMAL_READER_INIT;
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        ION_DECIMAL_READER_NEXT(reader);
+        ION_ASSERT_OK(ion_reader_read_ion_decimal(reader, &actual));
+        ION_ASSERT_OK(ion_decimal_from_string(&expected_decimal, expected[i], &context));
+        ASSERT_TRUE(ion_equals_decimal(&expected_decimal, &actual)) << expected[i];
+        ION_DECIMAL_FREE_2(&actual, &expected_decimal);
+    }
+    ION_ASSERT_OK(ion_reader_close(reader));
+}
+
+/**
+ * Reads the next decimal with ion_reader_read_decimal_parts and asserts the result.
+ */
+void test_read_decimal_parts(hREADER reader, BOOL expected_fits, int64_t expected_mantissa, int32_t expected_exponent) {
+    ION_TYPE type;
+    int64_t  mantissa;
+    int32_t  exponent;
+    BOOL     fits;
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_DECIMAL, type);
+    ION_ASSERT_OK(ion_reader_read_decimal_parts(reader, &mantissa, &exponent, &fits));
+    ASSERT_EQ(expected_fits, fits);
+    if (expected_fits) {
+        ASSERT_EQ(expected_mantissa, mantissa);
+        ASSERT_EQ(expected_exponent, exponent);
+    }
+}
+
+void test_read_decimal_parts_all(hREADER reader) {
+    test_read_decimal_parts(reader, TRUE, 1250, -3);
+    test_read_decimal_parts(reader, TRUE, 0, 0);
+    test_read_decimal_parts(reader, FALSE, 0, 0); // negative zero
+    test_read_decimal_parts(reader, TRUE, -10000005, -4);
+    test_read_decimal_parts(reader, TRUE, 12, -3);
+    test_read_decimal_parts(reader, TRUE, INT64_MIN, 2);
+    test_read_decimal_parts(reader, FALSE, 0, 0); // INT64_MAX + 1
+    test_read_decimal_parts(reader, FALSE, 0, 0); // more digits than any int64_t
+}
+
+TEST(IonTextDecimal, ReaderReadsDecimalParts) {
+    const char *text_decimal = "1.250 0. -0.0 -1_000.000_5 12d-3 -9223372036854775808d2 9223372036854775808. "
+                               "123456789012345678901234.5";
+
+    ION_DECIMAL_READER_INIT;
+    test_read_decimal_parts_all(reader);
+    ION_ASSERT_OK(ion_reader_close(reader));
+}
+
+TEST(IonBinaryDecimal, ReaderReadsDecimalParts) {
+    const char *text_decimal = "1.250 0. -0.0 -1_000.000_5 12d-3 -9223372036854775808d2 9223372036854775808. "
+                               "123456789012345678901234.5";
+    hREADER test_reader;
+
+    ION_DECIMAL_READER_INIT;
+    ION_DECIMAL_WRITER_INIT(TRUE);
+    ION_ASSERT_OK(ion_writer_write_all_values(writer, reader));
+    ION_DECIMAL_CLOSE_READER_WRITER;
+
+    ION_ASSERT_OK(ion_test_new_reader(result, (SIZE)result_len, &test_reader));
+    test_read_decimal_parts_all(test_reader);
+    ION_ASSERT_OK(ion_reader_close(test_reader));
+    free(result);
+}
+
+TEST(IonBinaryDecimal, ReaderReadsNineByteDecimalParts) {
+    // the mantissas take a ninth byte for the sign: INT64_MIN, and 2^63 which does not fit
+    const char *text_decimal = "-9223372036854775808d-2 9223372036854775808d-2 -18446744073709551615d1";
+    hREADER test_reader;
+
+    ION_DECIMAL_READER_INIT;
+    ION_DECIMAL_WRITER_INIT(TRUE);
+    ION_ASSERT_OK(ion_writer_write_all_values(writer, reader));
+    ION_DECIMAL_CLOSE_READER_WRITER;
+
+    ION_ASSERT_OK(ion_test_new_reader(result, (SIZE)result_len, &test_reader));
+    test_read_decimal_parts(test_reader, TRUE, INT64_MIN, -2);
+    test_read_decimal_parts(test_reader, FALSE, 0, 0);
+    test_read_decimal_parts(test_reader, FALSE, 0, 0);
+    ION_ASSERT_OK(ion_reader_close(test_reader));
+    free(result);
+}
+
+void test_write_decimal_parts_all(hWRITER writer) {
+    ION_ASSERT_OK(ion_writer_write_decimal_parts(writer, 1250, -3));
+    ION_ASSERT_OK(ion_writer_write_decimal_parts(writer, 0, 0));
+    ION_ASSERT_OK(ion_writer_write_decimal_parts(writer, 0, -2));
+    ION_ASSERT_OK(ion_writer_write_decimal_parts(writer, -10000005, -4));
+    ION_ASSERT_OK(ion_writer_write_decimal_parts(writer, INT64_MIN, 2));
+    ION_ASSERT_OK(ion_writer_write_decimal_parts(writer, INT64_MAX, -30));
+}
+
+TEST(IonDecimal, WriterWritesDecimalParts) {
+    const char *text_decimal = "1.250 0. 0.00 -1000.0005 -9223372036854775808d2 9223372036854775807d-30";
+
+    for (int is_binary = 0; is_binary <= 1; is_binary++) {
+        hREADER actual_reader;
+        BYTE *expected;
+        SIZE expected_len;
+
+        ION_DECIMAL_READER_INIT;
+        ION_DECIMAL_WRITER_INIT(is_binary);
+        ION_ASSERT_OK(ion_writer_write_all_values(writer, reader));
+        ION_ASSERT_OK(ion_test_writer_get_bytes(writer, ion_stream, &expected, &expected_len));
+        ION_ASSERT_OK(ion_reader_close(reader));
+
+        ION_ASSERT_OK(ion_test_new_writer(&writer, &ion_stream, is_binary));
+        test_write_decimal_parts_all(writer);
+        ION_ASSERT_OK(ion_test_writer_get_bytes(writer, ion_stream, &result, &result_len));
+        ASSERT_EQ(std::string((char *)expected, expected_len), std::string((char *)result, result_len)) << is_binary;
+
+        ION_ASSERT_OK(ion_test_new_reader(result, (SIZE)result_len, &actual_reader));
+        test_read_decimal_parts(actual_reader, TRUE, 1250, -3);
+        test_read_decimal_parts(actual_reader, TRUE, 0, 0);
+        test_read_decimal_parts(actual_reader, TRUE, 0, -2);
+        test_read_decimal_parts(actual_reader, TRUE, -10000005, -4);
+        test_read_decimal_parts(actual_reader, TRUE, INT64_MIN, 2);
+        test_read_decimal_parts(actual_reader, TRUE, INT64_MAX, -30);
+        ION_ASSERT_OK(ion_reader_close(actual_reader));
+        free(expected);
+        free(result);
+    }
+}
+
 TEST(IonDecimal, WriteAllValues) {
     const char *text_decimal = "1.1999999999999999555910790149937383830547332763671875 -1d+123";
     ION_DECIMAL ion_decimal;
@@ -288,6 +425,148 @@ TEST(IonDecimal, WriteAllValues) {
     ION_DECIMAL_FREE_1(&ion_decimal);
 }
 
+/* Text formatting, checked against the decQuadToString images it replaces */
+
+std::string decimal_image_from_decquad_to_string(const decQuad *quad, BOOL as_float) {
+    char image[DECQUAD_String];
+    decQuadToString(quad, image);
+    std::string result(image);
+    if (!as_float) {
+        size_t exponent = result.find('E');
+        if (exponent != std::string::npos) {
+            result[exponent] = 'd';
+        }
+        else if (result.find('.') == std::string::npos && decQuadIsFinite(quad)) {
+            result += "d0";
+        }
+    }
+    return result;
+}
+
+TEST(IonDecimal, QuadCharsMatchDecQuadToString) {
+    const char *images[] = {
+        "0", "-0", "0.00", "0E+3", "-0E-9", "1", "-1", "12.5", "-0.001", "0.000001", "0.0000001", "1E-7", "123E-9",
+        "1E+1", "12E+5", "-1.5E+300", "1234567890123456789012345678901234", "-1.234567890123456789012345678901234E-6100",
+        "9.999999999999999999999999999999999E+6144", "1E-6176", "Infinity", "-Infinity", "NaN"
+    };
+    char chars[ION_DECIMAL_QUAD_CHARS_MAX];
+    decQuad quad;
+
+    for (size_t ii = 0; ii < sizeof(images) / sizeof(images[0]); ii++) {
+        decQuadFromString(&quad, images[ii], &g_IonEventDecimalContext);
+        for (int as_float = 0; as_float <= 1; as_float++) {
+            std::string expected = decimal_image_from_decquad_to_string(&quad, as_float);
+            if (decQuadIsInfinite(&quad)) expected = decQuadIsSigned(&quad) ? "-inf" : "+inf";
+            if (decQuadIsNaN(&quad)) expected = "nan";
+            char *end = _ion_decimal_quad_to_chars(&quad, chars, as_float);
+            ASSERT_EQ(expected, std::string(chars, end - chars)) << images[ii];
+        }
+    }
+}
+
+TEST(IonDecimal, TextWriterWritesDecimalParts) {
+    hWRITER writer;
+    ION_STREAM *stream;
+    BYTE *bytes;
+    SIZE bytes_len;
+
+    ION_ASSERT_OK(ion_test_new_writer(&writer, &stream, FALSE));
+    ION_ASSERT_OK(ion_writer_write_decimal_parts(writer, 1250, -3));
+    ION_ASSERT_OK(ion_writer_write_decimal_parts(writer, 0, 0));
+    ION_ASSERT_OK(ion_writer_write_decimal_parts(writer, -5, -8));
+    ION_ASSERT_OK(ion_writer_write_decimal_parts(writer, 42, 3));
+    ION_ASSERT_OK(ion_writer_write_decimal_parts(writer, INT64_MIN, -2));
+    ION_ASSERT_OK(ion_writer_write_decimal_parts(writer, 7, INT32_MAX));
+    ION_ASSERT_OK(ion_test_writer_get_bytes(writer, stream, &bytes, &bytes_len));
+
+    ASSERT_EQ(std::string("1.250 0d0 -5d-8 4.2d+4 -92233720368547758.08 7d+2147483647"),
+              std::string((char *)bytes, bytes_len));
+    free(bytes);
+}
+
+/* Small coefficient arithmetic, checked against the decQuad results it replaces */
+
+static const char *small_decimal_operands[] = {
+    "0", "-0", "0.00", "1", "-1", "1.5", "-2.25", "123.456", "-0.000001", "9223372036854775807", "-9223372036854775808",
+    "1d30", "-7d-40", "1E6111", "1E-6176", "12345678901234567890123456789012", "1.000000000000000001"
+};
+
+#define SMALL_DECIMAL_OPERAND_COUNT (sizeof(small_decimal_operands) / sizeof(small_decimal_operands[0]))
+
+std::string small_decimal_quad_string(const decQuad *quad) {
+    char image[DECQUAD_String];
+    decQuadToString(quad, image);
+    return std::string(image);
+}
+
+TEST(IonDecimal, SmallArithmeticMatchesDecQuad) {
+    // the sign of an exact zero result differs between these rounding modes
+    const enum rounding roundings[] = { DEC_ROUND_HALF_EVEN, DEC_ROUND_FLOOR };
+    decContext context = g_IonEventDecimalContext;
+    ION_DECIMAL lhs, rhs, fhs, result;
+    decQuad expected;
+
+    for (size_t rr = 0; rr < sizeof(roundings) / sizeof(roundings[0]); rr++) {
+        decContextSetRounding(&context, roundings[rr]);
+        for (size_t ii = 0; ii < SMALL_DECIMAL_OPERAND_COUNT; ii++) {
+            for (size_t jj = 0; jj < SMALL_DECIMAL_OPERAND_COUNT; jj++) {
+                ION_ASSERT_OK(ion_decimal_from_string(&lhs, small_decimal_operands[ii], &context));
+                ION_ASSERT_OK(ion_decimal_from_string(&rhs, small_decimal_operands[jj], &context));
+                ASSERT_EQ(ION_DECIMAL_TYPE_QUAD, lhs.type);
+                ASSERT_EQ(ION_DECIMAL_TYPE_QUAD, rhs.type);
+
+                ION_ASSERT_OK(ion_decimal_add(&result, &lhs, &rhs, &context));
+                if (result.type == ION_DECIMAL_TYPE_QUAD) {
+                    decQuadAdd(&expected, &lhs.value.quad_value, &rhs.value.quad_value, &context);
+                    ASSERT_EQ(small_decimal_quad_string(&expected), small_decimal_quad_string(&result.value.quad_value))
+                        << small_decimal_operands[ii] << " + " << small_decimal_operands[jj];
+                }
+                ION_ASSERT_OK(ion_decimal_free(&result));
+
+                ION_ASSERT_OK(ion_decimal_subtract(&result, &lhs, &rhs, &context));
+                if (result.type == ION_DECIMAL_TYPE_QUAD) {
+                    decQuadSubtract(&expected, &lhs.value.quad_value, &rhs.value.quad_value, &context);
+                    ASSERT_EQ(small_decimal_quad_string(&expected), small_decimal_quad_string(&result.value.quad_value))
+                        << small_decimal_operands[ii] << " - " << small_decimal_operands[jj];
+                }
+                ION_ASSERT_OK(ion_decimal_free(&result));
+
+                ION_ASSERT_OK(ion_decimal_multiply(&result, &lhs, &rhs, &context));
+                if (result.type == ION_DECIMAL_TYPE_QUAD) {
+                    decQuadMultiply(&expected, &lhs.value.quad_value, &rhs.value.quad_value, &context);
+                    ASSERT_EQ(small_decimal_quad_string(&expected), small_decimal_quad_string(&result.value.quad_value))
+                        << small_decimal_operands[ii] << " * " << small_decimal_operands[jj];
+                }
+                ION_ASSERT_OK(ion_decimal_free(&result));
+
+                ION_ASSERT_OK(ion_decimal_from_string(&fhs, "-3.5", &context));
+                ION_ASSERT_OK(ion_decimal_fma(&result, &lhs, &rhs, &fhs, &context));
+                if (result.type == ION_DECIMAL_TYPE_QUAD) {
+                    decQuadFMA(&expected, &lhs.value.quad_value, &rhs.value.quad_value, &fhs.value.quad_value, &context);
+                    ASSERT_EQ(small_decimal_quad_string(&expected), small_decimal_quad_string(&result.value.quad_value))
+                        << small_decimal_operands[ii] << " * " << small_decimal_operands[jj] << " - 3.5";
+                }
+                ION_ASSERT_OK(ion_decimal_free(&result));
+
+                ION_DECIMAL_FREE_2(&lhs, &rhs);
+            }
+        }
+    }
+}
+
+TEST(IonDecimal, SmallArithmeticInPlace) {
+    ION_DECIMAL sum, addend;
+
+    ION_ASSERT_OK(ion_decimal_from_string(&sum, "0.00", &g_IonEventDecimalContext));
+    ION_ASSERT_OK(ion_decimal_from_string(&addend, "0.01", &g_IonEventDecimalContext));
+    for (int ii = 0; ii < 1000; ii++) {
+        ION_ASSERT_OK(ion_decimal_add(&sum, &sum, &addend, &g_IonEventDecimalContext));
+    }
+    ASSERT_EQ(ION_DECIMAL_TYPE_QUAD, sum.type);
+    ASSERT_EQ(std::string("10.00"), small_decimal_quad_string(&sum.value.quad_value));
+    ION_DECIMAL_FREE_2(&sum, &addend);
+}
+
 /* `ION_DECIMAL_COMPUTE_API_BUILDER_THREE_OPERAND` tests */
 
 TEST(IonDecimal, FMADecQuad) {
@@ -28,10 +28,9 @@
  */
 
 /**
- * Initializes an extractor test with the given options.
+ * Initializes an extractor test with the given options, for tests that never open a reader of their own.
  */
-#define ION_EXTRACTOR_TEST_INIT_OPTIONS(options) \
-    hREADER reader; \
+#define ION_EXTRACTOR_TEST_INIT_OPTIONS_WITHOUT_READER(options) \
     hEXTRACTOR extractor; \
     hPATH path; \
     int num_paths = 0; \
@@ -40,15 +39,29 @@
     ION_ASSERT_OK(ion_extractor_open(&extractor, &options));
 
 /**
- * Initializes an extractor test with the default options.
+ * Initializes an extractor test with the given options.
  */
-#define ION_EXTRACTOR_TEST_INIT \
+#define ION_EXTRACTOR_TEST_INIT_OPTIONS(options) \
+    hREADER reader; \
+    ION_EXTRACTOR_TEST_INIT_OPTIONS_WITHOUT_READER(options);
+
+/**
+ * Initializes an extractor test with the default options, for tests that never open a reader of their own.
+ */
+#define ION_EXTRACTOR_TEST_INIT_WITHOUT_READER \
     ION_EXTRACTOR_OPTIONS options = {0}; \
     options.max_path_length = ION_EXTRACTOR_TEST_PATH_LENGTH; \
     options.max_num_paths = ION_EXTRACTOR_TEST_MAX_PATHS; \
     options.match_relative_paths = false; \
     options.match_case_insensitive = false; \
-    ION_EXTRACTOR_TEST_INIT_OPTIONS(options);
+    ION_EXTRACTOR_TEST_INIT_OPTIONS_WITHOUT_READER(options);
+
+/**
+ * Initializes an extractor test with the default options.
+ */
+#define ION_EXTRACTOR_TEST_INIT \
+    hREADER reader; \
+    ION_EXTRACTOR_TEST_INIT_WITHOUT_READER;
 
 /**
  * Prepares the next assertion context.
@@ -1062,3 +1075,144 @@ TEST(IonExtractorFailsWhen, DataContainsUnexpectedEOF) {
     ION_ASSERT_OK(ion_extractor_close(extractor));
     ION_ASSERT_OK(ion_reader_close(reader));
 }
+
+#define ION_EXTRACTOR_TEST_BATCH_SIZE 64
+#define ION_EXTRACTOR_TEST_BATCH_WORKERS 4
+
+/**
+ * Per-batch state for the batch tests. Each input's slot is written only by the worker that processes it, and each
+ * worker's slot only by that worker, so no synchronization is needed.
+ */
+typedef struct _batch_test_context {
+    int values[ION_EXTRACTOR_TEST_BATCH_SIZE];
+    int matches_per_worker[ION_EXTRACTOR_TEST_BATCH_WORKERS];
+    bool worker_id_out_of_range;
+} BATCH_TEST_CONTEXT;
+
+iERR testBatchCallback(hREADER reader, ION_EXTRACTOR_PATH_DESCRIPTOR *matched_path, void *user_context,
+                       ION_EXTRACTOR_SHARD *shard, ION_EXTRACTOR_CONTROL *control) {
+    iENTER;
+    BATCH_TEST_CONTEXT *context = (BATCH_TEST_CONTEXT *)user_context;
+    if (shard->worker_id < 0 || shard->worker_id >= ION_EXTRACTOR_TEST_BATCH_WORKERS) {
+        context->worker_id_out_of_range = true;
+        FAILWITH(IERR_INVALID_STATE);
+    }
+    context->matches_per_worker[shard->worker_id]++;
+    IONCHECK(ion_reader_read_int(reader, &context->values[shard->input_index]));
+    iRETURN;
+}
+
+TEST(IonExtractorSucceedsWhen, MatchingABatchOfBuffers) {
+    hEXTRACTOR extractor;
+    hPATH path;
+    ION_EXTRACTOR_BATCH_INPUT inputs[ION_EXTRACTOR_TEST_BATCH_SIZE];
+    ION_EXTRACTOR_BATCH_OPTIONS batch_options;
+    iERR results[ION_EXTRACTOR_TEST_BATCH_SIZE];
+    std::string texts[ION_EXTRACTOR_TEST_BATCH_SIZE];
+    BATCH_TEST_CONTEXT context;
+    const char *path_text = "(abc)";
+    int total_matches = 0;
+
+    memset(&context, 0, sizeof(BATCH_TEST_CONTEXT));
+    memset(&batch_options, 0, sizeof(ION_EXTRACTOR_BATCH_OPTIONS));
+    memset(inputs, 0, sizeof(inputs));
+    for (int i = 0; i < ION_EXTRACTOR_TEST_BATCH_SIZE; i++) {
+        texts[i] = "{def: 0, abc: " + std::to_string(i) + "} {abc: [1]}";
+        inputs[i].buffer = (BYTE *)texts[i].c_str();
+        inputs[i].buffer_length = (SIZE)texts[i].length();
+        context.values[i] = -1;
+    }
+    batch_options.num_workers = ION_EXTRACTOR_TEST_BATCH_WORKERS;
+    batch_options.callback = &testBatchCallback;
+
+    ION_ASSERT_OK(ion_extractor_open(&extractor, NULL));
+    ION_ASSERT_OK(ion_extractor_path_create_from_ion(extractor, &testCallbackBasic, &context, (BYTE *)path_text,
+                                                     (SIZE)strlen(path_text), &path));
+    // The second value in each input is a list, which can't be read as an int.
+    ION_ASSERT_FAIL(ion_extractor_match_batch(extractor, inputs, ION_EXTRACTOR_TEST_BATCH_SIZE, &batch_options,
+                                              results));
+    for (int i = 0; i < ION_EXTRACTOR_TEST_BATCH_SIZE; i++) {
+        texts[i] = "{def: 0, abc: " + std::to_string(i) + "} {abc: 1000}";
+        inputs[i].buffer = (BYTE *)texts[i].c_str();
+        inputs[i].buffer_length = (SIZE)texts[i].length();
+    }
+    memset(&context, 0, sizeof(BATCH_TEST_CONTEXT));
+    ION_ASSERT_OK(ion_extractor_match_batch(extractor, inputs, ION_EXTRACTOR_TEST_BATCH_SIZE, &batch_options,
+                                            results));
+    ION_ASSERT_OK(ion_extractor_close(extractor));
+
+    ASSERT_FALSE(context.worker_id_out_of_range);
+    for (int i = 0; i < ION_EXTRACTOR_TEST_BATCH_WORKERS; i++) {
+        total_matches += context.matches_per_worker[i];
+    }
+    ASSERT_EQ(2 * ION_EXTRACTOR_TEST_BATCH_SIZE, total_matches);
+    for (int i = 0; i < ION_EXTRACTOR_TEST_BATCH_SIZE; i++) {
+        ION_ASSERT_OK(results[i]);
+        // The last match in each input wins.
+        ASSERT_EQ(1000, context.values[i]);
+    }
+}
+
+TEST(IonExtractorSucceedsWhen, MatchingABatchWithPathCallbacks) {
+    ION_EXTRACTOR_TEST_INIT_WITHOUT_READER;
+    ION_EXTRACTOR_BATCH_INPUT inputs[2];
+    ION_EXTRACTOR_BATCH_OPTIONS batch_options;
+    const char *text = "{abc: def}";
+    ION_EXTRACTOR_TEST_PATH_FROM_TEXT("(abc)", &assertMatchesTextDEF);
+
+    memset(&batch_options, 0, sizeof(ION_EXTRACTOR_BATCH_OPTIONS));
+    memset(inputs, 0, sizeof(inputs));
+    inputs[0].buffer = inputs[1].buffer = (BYTE *)text;
+    inputs[0].buffer_length = inputs[1].buffer_length = (SIZE)strlen(text);
+    // A single worker, because ASSERTION_CONTEXT is not safe to update concurrently.
+    batch_options.num_workers = 1;
+
+    ION_ASSERT_OK(ion_extractor_match_batch(extractor, inputs, 2, &batch_options, NULL));
+    ION_ASSERT_OK(ion_extractor_close(extractor));
+    ION_EXTRACTOR_TEST_ASSERT_MATCHED(0, 2);
+}
+
+TEST(IonExtractorFailsWhen, BatchInputIsInvalid) {
+    hEXTRACTOR extractor;
+    hPATH path;
+    ION_EXTRACTOR_BATCH_INPUT inputs[4];
+    ION_EXTRACTOR_BATCH_OPTIONS batch_options;
+    iERR results[4];
+    const char *valid_text = "{abc: 1}";
+    const char *invalid_text = "{abc: ";
+    const char *path_text = "(abc)";
+
+    memset(&batch_options, 0, sizeof(ION_EXTRACTOR_BATCH_OPTIONS));
+    memset(inputs, 0, sizeof(inputs));
+    for (int i = 0; i < 4; i++) {
+        inputs[i].buffer = (BYTE *)((i == 2) ? invalid_text : valid_text);
+        inputs[i].buffer_length = (SIZE)strlen((char *)inputs[i].buffer);
+    }
+    inputs[3].buffer = NULL; // Neither a buffer nor a file.
+    batch_options.num_workers = 2;
+
+    ION_ASSERT_OK(ion_extractor_open(&extractor, NULL));
+    ION_ASSERT_OK(ion_extractor_path_create_from_ion(extractor, &testCallbackBasic, NULL, (BYTE *)path_text,
+                                                     (SIZE)strlen(path_text), &path));
+    ION_ASSERT_FAIL(ion_extractor_match_batch(extractor, inputs, 4, &batch_options, results));
+    ION_ASSERT_OK(ion_extractor_close(extractor));
+    ION_ASSERT_OK(results[0]);
+    ION_ASSERT_OK(results[1]);
+    ION_ASSERT_FAIL(results[2]);
+    ASSERT_EQ(IERR_INVALID_ARG, results[3]);
+}
+
+TEST(IonExtractorFailsWhen, BatchIsMatchedWithPathInProgress) {
+    ION_EXTRACTOR_TEST_INIT_WITHOUT_READER;
+    ION_EXTRACTOR_BATCH_INPUT input;
+    const char *text = "{abc: def}";
+    ION_STRING value;
+    ION_ASSERT_OK(ion_string_from_cstr("abc", &value));
+    memset(&input, 0, sizeof(input));
+    input.buffer = (BYTE *)text;
+    input.buffer_length = (SIZE)strlen(text);
+    ION_EXTRACTOR_TEST_PATH_START(2, &assertPathNeverMatches);
+    ION_ASSERT_OK(ion_extractor_path_append_field(path, &value));
+    ION_ASSERT_FAIL(ion_extractor_match_batch(extractor, &input, 1, NULL, NULL));
+    ION_ASSERT_OK(ion_extractor_close(extractor));
+}
@@ -12,6 +12,8 @@
  * language governing permissions and limitations under the License.
  */
 
+#include <string>
+#include <vector>
 #include "ion_assert.h"
 #include "ion_helpers.h"
 #include "ion_test_util.h"
@@ -126,3 +128,217 @@ TEST(IonInteger, IIntToInt64Overflow) {
         ASSERT_EQ(error_value, IERR_NUMERIC_OVERFLOW);
     }
 }
+
+TEST(IonInteger, IIntToCharsRoundTrip) {
+    // Values with leading, trailing and interior all-zero nine digit chunks, and values on either
+    // side of the chunk boundaries.
+    const char *values[] = {
+        "0", "7", "-7", "999999999", "-999999999", "1000000000", "-1000000000",
+        "1000000000000000000", "-1000000000000000001", "123456789000000000987654321",
+        "9223372036854775808", "18446744073709551616",
+        "100000000000000000000000000000000000000000000000000000000000000000000000000000000000000000001",
+        "-340282366920938463463374607431768211455",
+    };
+    ION_INT *iint = NULL;
+    char     chars[128];
+    SIZE     written;
+
+    ION_ASSERT_OK(ion_int_alloc(NULL, &iint));
+    for (size_t m = 0; m < sizeof(values) / sizeof(values[0]); m++) {
+        ION_ASSERT_OK(ion_int_from_chars(iint, values[m], (SIZE)strlen(values[m])));
+        ION_ASSERT_OK(ion_int_to_char(iint, (BYTE *)chars, sizeof(chars), &written));
+        assertStringsEqual(values[m], chars, written);
+        ASSERT_EQ(0, chars[written]);
+    }
+    ion_int_free(iint);
+}
+
+TEST(IonInteger, IIntLargeCharsMatchBytes) {
+    // 2^k for k up to 2048, so the decimal text crosses many chunk boundaries on both the parse
+    // and the format side. The expected text is built here by repeated doubling.
+    std::string decimal = "1";
+    BYTE        bytes[257];
+    ION_INT    *from_bytes = NULL, *from_chars = NULL;
+    std::string chars;
+    SIZE        len, written;
+    int         compare;
+
+    ION_ASSERT_OK(ion_int_alloc(NULL, &from_bytes));
+    ION_ASSERT_OK(ion_int_alloc(NULL, &from_chars));
+    for (int k = 0; k <= 2048; k++) {
+        if (k > 0) {
+            int carry = 0;
+            for (size_t i = decimal.size(); i-- > 0; ) {
+                int d = (decimal[i] - '0') * 2 + carry;
+                decimal[i] = (char)('0' + d % 10);
+                carry = d / 10;
+            }
+            if (carry) decimal.insert(decimal.begin(), '1');
+        }
+        if (k % 7 != 0 && k < 2040) continue;
+
+        memset(bytes, 0, sizeof(bytes));
+        len = (SIZE)(k / 8) + 1;
+        bytes[0] = (BYTE)(1 << (k % 8));
+        ION_ASSERT_OK(ion_int_from_abs_bytes(from_bytes, bytes, len, (k % 2) == 1));
+        std::string expected = ((k % 2) == 1 ? "-" : "") + decimal;
+        ION_ASSERT_OK(ion_int_from_chars(from_chars, expected.c_str(), (SIZE)expected.size()));
+
+        ION_ASSERT_OK(ion_int_compare(from_bytes, from_chars, &compare));
+        ASSERT_EQ(0, compare) << k;
+
+        chars.assign(expected.size() + 2, '\0');
+        ION_ASSERT_OK(ion_int_to_char(from_bytes, (BYTE *)&chars[0], (SIZE)chars.size(), &written));
+        ASSERT_EQ(expected, chars.substr(0, written)) << k;
+    }
+    ion_int_free(from_bytes);
+    ion_int_free(from_chars);
+}
+
+TEST(IonInteger, IIntVeryLargeCharsRoundTrip) {
+    // Thousands of digits, well past the point where the conversions split the value in halves.
+    // 2^16385 (4933 digits) is built in base 10^9 by shifting 29 bits at a time and checked
+    // against the same power built from bytes, then a mixed digit pattern is round tripped.
+    const int   k = 29 * 565;
+    std::vector<uint32_t> limbs(1, 1);
+    std::vector<BYTE>     bytes(k / 8 + 1, 0);
+    ION_INT    *from_bytes = NULL, *from_chars = NULL;
+    std::string expected, chars;
+    SIZE        written;
+    int         compare;
+    char        chunk[16];
+
+    for (int shift = 0; shift < k; shift += 29) {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < limbs.size(); i++) {
+            uint64_t t = ((uint64_t)limbs[i] << 29) + carry;
+            limbs[i] = (uint32_t)(t % 1000000000);
+            carry = t / 1000000000;
+        }
+        while (carry) {
+            limbs.push_back((uint32_t)(carry % 1000000000));
+            carry /= 1000000000;
+        }
+    }
+    expected = std::to_string(limbs.back());
+    for (size_t i = limbs.size() - 1; i-- > 0; ) {
+        snprintf(chunk, sizeof(chunk), "%09u", limbs[i]);
+        expected += chunk;
+    }
+    ASSERT_EQ(4933, expected.size());
+
+    ION_ASSERT_OK(ion_int_alloc(NULL, &from_bytes));
+    ION_ASSERT_OK(ion_int_alloc(NULL, &from_chars));
+    bytes[0] = (BYTE)(1 << (k % 8));
+    ION_ASSERT_OK(ion_int_from_abs_bytes(from_bytes, &bytes[0], (SIZE)bytes.size(), FALSE));
+    ION_ASSERT_OK(ion_int_from_chars(from_chars, expected.c_str(), (SIZE)expected.size()));
+    ION_ASSERT_OK(ion_int_compare(from_bytes, from_chars, &compare));
+    ASSERT_EQ(0, compare);
+
+    chars.assign(expected.size() + 2, '\0');
+    ION_ASSERT_OK(ion_int_to_char(from_bytes, (BYTE *)&chars[0], (SIZE)chars.size(), &written));
+    ASSERT_EQ(expected, chars.substr(0, written));
+
+    // runs of zeros and nines, so some of the 9 digit chunks are empty and some are full
+    expected = "-";
+    for (int i = 0; i < 6000; i++) {
+        expected += (char)('0' + ((i % 97 < 40) ? 0 : (i % 89 < 30) ? 9 : (i * 7 + 1) % 10));
+    }
+    expected[1] = '7';
+    ION_ASSERT_OK(ion_int_from_chars(from_chars, expected.c_str(), (SIZE)expected.size()));
+    chars.assign(expected.size() + 2, '\0');
+    ION_ASSERT_OK(ion_int_to_char(from_chars, (BYTE *)&chars[0], (SIZE)chars.size(), &written));
+    ASSERT_EQ(expected, chars.substr(0, written));
+
+    ion_int_free(from_bytes);
+    ion_int_free(from_chars);
+}
+
+TEST(IonInteger, IIntSmallValuesStayInline) {
+    ION_INT  small;
+    ION_INT *big = NULL;
+    int64_t  value;
+    hREADER  reader = NULL;
+    ION_TYPE type;
+    const char *big_chars = "-123456789012345678901234567890";
+    const char *text = "0 -1 9223372036854775807 -9223372036854775808";
+    const int64_t expected[] = { 0, -1, MAX_INT64, MIN_INT64 };
+
+    ION_ASSERT_OK(ion_int_init(&small, NULL));
+    ION_ASSERT_OK(ion_int_from_long(&small, MIN_INT64));
+    ION_ASSERT_OK(ion_int_to_int64(&small, &value));
+    ASSERT_EQ(MIN_INT64, value);
+
+    ION_ASSERT_OK(ion_test_new_text_reader(text, &reader));
+    for (int i = 0; i < 4; i++) {
+        ION_ASSERT_OK(ion_reader_next(reader, &type));
+        ASSERT_EQ(tid_INT, type);
+        ION_ASSERT_OK(ion_reader_read_ion_int(reader, &small));
+        ION_ASSERT_OK(ion_int_to_int64(&small, &value));
+        ASSERT_EQ(expected[i], value);
+    }
+    ION_ASSERT_OK(ion_reader_close(reader));
+
+    // larger values spill to the heap, and shrinking back keeps the heap digits
+    ION_ASSERT_OK(ion_int_alloc(NULL, &big));
+    ION_ASSERT_OK(ion_int_from_long(big, 7));
+    ION_ASSERT_OK(ion_int_from_chars(big, big_chars, (SIZE)strlen(big_chars)));
+    ION_ASSERT_OK(ion_int_from_long(big, -7));
+    ION_ASSERT_OK(ion_int_to_int64(big, &value));
+    ASSERT_EQ(-7, value);
+    ion_int_free(big);
+}
+
+TEST(IonInteger, IIntSmallValueCopiesOutliveTheOriginal) {
+    ION_INT *original = NULL;
+    ION_INT  copy;
+    int64_t  value;
+    int      compare;
+    char     chars[32];
+    SIZE     written;
+
+    // a small value has no digit array, so a copy by assignment shares nothing
+    ION_ASSERT_OK(ion_int_alloc(NULL, &original));
+    ION_ASSERT_OK(ion_int_from_long(original, -1234567890123LL));
+    copy = *original;
+    ion_int_free(original);
+
+    ION_ASSERT_OK(ion_int_to_int64(&copy, &value));
+    ASSERT_EQ(-1234567890123LL, value);
+    ION_ASSERT_OK(ion_int_to_char(&copy, (BYTE *)chars, sizeof(chars), &written));
+    ASSERT_EQ(std::string("-1234567890123"), std::string(chars, (size_t)written));
+
+    ION_ASSERT_OK(ion_int_alloc(NULL, &original));
+    ION_ASSERT_OK(ion_int_from_long(original, -1234567890123LL));
+    ION_ASSERT_OK(ion_int_compare(&copy, original, &compare));
+    ASSERT_EQ(0, compare);
+    ion_int_free(original);
+}
+
+TEST(IonInteger, TextWriterWritesInt64) {
+    hWRITER writer = NULL;
+    ION_STREAM *ion_stream = NULL;
+    BYTE *result;
+    SIZE result_len;
+    ION_INT *iint = NULL;
+    const char *big = "-123456789012345678901234567890";
+
+    ION_ASSERT_OK(ion_test_new_writer(&writer, &ion_stream, FALSE));
+    ION_ASSERT_OK(ion_writer_write_int64(writer, 0));
+    ION_ASSERT_OK(ion_writer_write_int64(writer, 9));
+    ION_ASSERT_OK(ion_writer_write_int64(writer, -10));
+    ION_ASSERT_OK(ion_writer_write_int64(writer, 100));
+    ION_ASSERT_OK(ion_writer_write_int64(writer, 1000000007));
+    ION_ASSERT_OK(ion_writer_write_int64(writer, MAX_INT64));
+    ION_ASSERT_OK(ion_writer_write_int64(writer, MIN_INT64));
+    ION_ASSERT_OK(ion_int_alloc(NULL, &iint));
+    ION_ASSERT_OK(ion_int_from_chars(iint, big, (SIZE)strlen(big)));
+    ION_ASSERT_OK(ion_writer_write_ion_int(writer, iint));
+    ION_ASSERT_OK(ion_test_writer_get_bytes(writer, ion_stream, &result, &result_len));
+
+    assertStringsEqual("0 9 -10 100 1000000007 9223372036854775807 -9223372036854775808 -123456789012345678901234567890",
+                       (char *)result, result_len);
+
+    ion_int_free(iint);
+    free(result);
+}
@@ -23,6 +23,7 @@
 #include "ion_helpers.h"
 #include "ion_test_util.h"
 #include "ion_assert.h"
+#include <string>
 
 struct _test_in_memory_paged_stream_context {
     BYTE *data;
@@ -229,3 +230,214 @@ TEST(IonStream, WriteToUserStream) {
 
     free(context.data);
 }
+
+TEST(IonStream, ReserveAndCommitOnUserBuffer) {
+    BYTE buf[8];
+    BYTE *dst = NULL;
+    SIZE written;
+    ION_STREAM *stream = NULL;
+
+    ION_ASSERT_OK(ion_stream_open_buffer(buf, sizeof(buf), 0, FALSE, &stream));
+
+    // only the bytes actually used are committed
+    ION_ASSERT_OK(ion_stream_reserve(stream, 4, &dst));
+    ASSERT_TRUE(dst != NULL);
+    memcpy(dst, "abc", 3);
+    ION_ASSERT_OK(ion_stream_commit(stream, 3));
+    ASSERT_EQ(3, ion_stream_get_position(stream));
+
+    // a span longer than the rest of the buffer isn't available
+    ION_ASSERT_OK(ion_stream_reserve(stream, 6, &dst));
+    ASSERT_TRUE(dst == NULL);
+
+    ION_ASSERT_OK(ion_stream_reserve(stream, 5, &dst));
+    ASSERT_TRUE(dst != NULL);
+    memcpy(dst, "defgh", 5);
+    ION_ASSERT_OK(ion_stream_commit(stream, 5));
+    ASSERT_EQ(8, ion_stream_get_position(stream));
+    ION_ASSERT_FAIL(ion_stream_commit(stream, 1));
+
+    ION_ASSERT_OK(ion_stream_close(stream));
+    ASSERT_EQ(0, memcmp("abcdefgh", buf, sizeof(buf)));
+
+    // and a memory stream hands out spans on its next page once the current one is full
+    ION_ASSERT_OK(ion_stream_open_memory_only(&stream));
+    for (int i = 0; i < 10000; i++) {
+        ION_ASSERT_OK(ion_stream_write(stream, (BYTE *)"0123456789", 10, &written));
+        ION_ASSERT_OK(ion_stream_reserve(stream, 1, &dst));
+        ASSERT_TRUE(dst != NULL);
+        *dst = ',';
+        ION_ASSERT_OK(ion_stream_commit(stream, 1));
+    }
+    ASSERT_EQ(110000, ion_stream_get_position(stream));
+    ION_ASSERT_OK(ion_stream_close(stream));
+}
+
+TEST(IonStream, TextWriterFormatsIntsAcrossPages) {
+    // enough values that some of them land on a page boundary and go through the writer's scratch buffer
+    hWRITER writer = NULL;
+    ION_STREAM *ion_stream = NULL;
+    BYTE *result;
+    SIZE result_len;
+    std::string expected;
+    char image[32];
+
+    ION_ASSERT_OK(ion_test_new_writer(&writer, &ion_stream, FALSE));
+    for (int64_t i = 0; i < 5000; i++) {
+        int64_t value = (i % 2) ? -(i * 1000003) : MAX_INT64 - i;
+        ION_ASSERT_OK(ion_writer_write_int64(writer, value));
+        snprintf(image, sizeof(image), "%s%lld", i ? " " : "", (long long)value);
+        expected += image;
+    }
+    ION_ASSERT_OK(ion_test_writer_get_bytes(writer, ion_stream, &result, &result_len));
+
+    ASSERT_EQ(expected, std::string((char *)result, result_len));
+    free(result);
+}
+
+TEST(IonStream, PinnedValueViewSurvivesPageTurns) {
+    ION_STREAM *stream = NULL;
+    hREADER reader = NULL;
+    ION_TYPE type;
+    ION_READER_OPTIONS options;
+    ION_STRING slices[4], str;
+    SIZE slice_count;
+    BYTE data[51];
+    std::string blob, viewed;
+
+    // a 40 byte blob that spans three 16 byte pages, followed by "tail" which
+    // pulls in a fourth page while the blob's pages are still pinned
+    _test_in_memory_paged_stream_context context;
+    memset(&options, 0, sizeof(ION_READER_OPTIONS));
+    memset(&context, 0, sizeof(_test_in_memory_paged_stream_context));
+    memcpy(data, "\xE0\x01\x00\xEA\xAE\xA8", 6);
+    for (int i = 0; i < 40; i++) {
+        data[6 + i] = (BYTE)('a' + i % 26);
+    }
+    memcpy(data + 46, "\x84tail", 5);
+    blob.assign((char *)data + 6, 40);
+    context.data = data;
+    context.data_len = sizeof(data);
+    context.page_size = 16;
+
+    ION_ASSERT_OK(ion_test_new_paged_input_stream(&stream, &context));
+    ION_ASSERT_OK(ion_reader_open(&reader, stream, &options));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_BLOB, type);
+
+    ASSERT_EQ(IERR_BUFFER_TOO_SMALL, ion_reader_pin_value_view(reader, slices, 2, &slice_count));
+    ASSERT_EQ(3, slice_count);
+    ION_ASSERT_OK(ion_reader_pin_value_view(reader, slices, 4, &slice_count));
+    ASSERT_EQ(3, slice_count);
+    ASSERT_EQ(10, slices[0].length);
+    ASSERT_EQ(16, slices[1].length);
+    ASSERT_EQ(14, slices[2].length);
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_STRING, type);
+    ION_ASSERT_OK(ion_reader_read_string(reader, &str));
+    ASSERT_EQ(std::string("tail"), std::string((char *)str.value, (size_t)str.length));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_EOF, type);
+
+    for (int i = 0; i < slice_count; i++) {
+        viewed.append((char *)slices[i].value, (size_t)slices[i].length);
+    }
+    ASSERT_EQ(blob, viewed);
+
+    ION_ASSERT_OK(ion_reader_unpin_value_view(reader));
+    ASSERT_EQ(IERR_INVALID_STATE, ion_reader_unpin_value_view(reader));
+    ION_ASSERT_OK(ion_reader_close(reader));
+    ION_ASSERT_OK(ion_stream_close(stream));
+}
+
+TEST(IonStream, UnpinReleasesPinnedPages) {
+    ION_STREAM *stream = NULL;
+    BYTE data[64];
+    BYTE buf[40];
+    SIZE bytes_read;
+    ION_PAGE *page;
+
+    _test_in_memory_paged_stream_context context;
+    memset(&context, 0, sizeof(_test_in_memory_paged_stream_context));
+    memset(data, 'x', sizeof(data));
+    context.data = data;
+    context.data_len = sizeof(data);
+    context.page_size = 16;
+
+    ION_ASSERT_OK(ion_test_new_paged_input_stream(&stream, &context));
+    ION_ASSERT_OK(ion_stream_read(stream, buf, 4, &bytes_read));
+    ION_ASSERT_OK(ion_stream_pin(stream, 2));
+    ION_ASSERT_OK(ion_stream_read(stream, buf, 40, &bytes_read));
+    ION_ASSERT_OK(_ion_stream_page_find(PAGED_STREAM(stream), 0, &page));
+    ASSERT_TRUE(page != NULL);
+    ION_ASSERT_OK(_ion_stream_page_find(PAGED_STREAM(stream), 1, &page));
+    ASSERT_TRUE(page != NULL);
+
+    ION_ASSERT_OK(ion_stream_unpin(stream));
+    ION_ASSERT_OK(_ion_stream_page_find(PAGED_STREAM(stream), 0, &page));
+    ASSERT_TRUE(page == NULL);
+    ION_ASSERT_OK(_ion_stream_page_find(PAGED_STREAM(stream), 1, &page));
+    ASSERT_TRUE(page == NULL);
+    ION_ASSERT_OK(_ion_stream_page_find(PAGED_STREAM(stream), 2, &page));
+    ASSERT_TRUE(page != NULL);
+
+    // only positions that are still in memory can be pinned
+    ASSERT_EQ(IERR_INVALID_ARG, ion_stream_pin(stream, 2));
+    ASSERT_EQ(IERR_INVALID_STATE, ion_stream_unpin(stream));
+    ION_ASSERT_OK(ion_stream_close(stream));
+}
+
+TEST(IonStream, IndexedStructSeeksBackAcrossPages) {
+    ION_STREAM *stream = NULL;
+    hREADER reader = NULL;
+    hWRITER writer = NULL;
+    ION_STREAM *out = NULL;
+    ION_TYPE type;
+    ION_READER_OPTIONS options;
+    ION_STRING name, str;
+    BYTE *data;
+    SIZE data_len;
+    char field[8], text[32];
+
+    // a struct several 16 byte pages long, read through a stream that can't seek
+    ION_ASSERT_OK(ion_test_new_writer(&writer, &out, TRUE));
+    ION_ASSERT_OK(ion_writer_start_container(writer, tid_STRUCT));
+    for (int i = 0; i < 10; i++) {
+        snprintf(field, sizeof(field), "f%d", i);
+        snprintf(text, sizeof(text), "value number %d", i);
+        ION_ASSERT_OK(ion_writer_write_field_name(writer, ion_string_assign_cstr(&name, field, (SIZE)strlen(field))));
+        ION_ASSERT_OK(ion_writer_write_string(writer, ion_string_assign_cstr(&str, text, (SIZE)strlen(text))));
+    }
+    ION_ASSERT_OK(ion_writer_finish_container(writer));
+    ION_ASSERT_OK(ion_test_writer_get_bytes(writer, out, &data, &data_len));
+
+    _test_in_memory_paged_stream_context context;
+    memset(&options, 0, sizeof(ION_READER_OPTIONS));
+    memset(&context, 0, sizeof(_test_in_memory_paged_stream_context));
+    context.data = data;
+    context.data_len = data_len;
+    context.page_size = 16;
+
+    ION_ASSERT_OK(ion_test_new_paged_input_stream(&stream, &context));
+    ION_ASSERT_OK(ion_reader_open(&reader, stream, &options));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_STRUCT, type);
+    ION_ASSERT_OK(ion_reader_step_in(reader));
+    ION_ASSERT_OK(ion_reader_index_struct(reader));
+    for (int i = 9; i >= 0; i -= 3) {
+        snprintf(field, sizeof(field), "f%d", i);
+        snprintf(text, sizeof(text), "value number %d", i);
+        ION_ASSERT_OK(ion_reader_seek_field(reader, ion_string_assign_cstr(&name, field, (SIZE)strlen(field)), &type));
+        ASSERT_EQ(tid_STRING, type);
+        ION_ASSERT_OK(ion_reader_read_string(reader, &str));
+        ASSERT_EQ(std::string(text), std::string((char *)str.value, (size_t)str.length));
+    }
+    ION_ASSERT_OK(ion_reader_step_out(reader));
+    ASSERT_FALSE(stream->_pin_count);
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_EOF, type);
+    ION_ASSERT_OK(ion_reader_close(reader));
+    ION_ASSERT_OK(ion_stream_close(stream));
+    free(data);
+}
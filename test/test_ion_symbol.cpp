@@ -1762,3 +1762,44 @@ TEST(IonSymbolTable, CanBeRemovedFromCatalog) {
 
     ION_ASSERT_OK(ion_catalog_close(catalog));
 }
+
+void test_ion_symbol_write_with_refs(hWRITER writer, hSYMBOLREF id, hSYMBOLREF tag, hSYMBOLREF ann, hSYMBOLREF name) {
+    ION_ASSERT_OK(ion_writer_add_annotation_ref(writer, ann));
+    ION_ASSERT_OK(ion_writer_start_container(writer, tid_STRUCT));
+    ION_ASSERT_OK(ion_writer_write_field_name_ref(writer, id));
+    ION_ASSERT_OK(ion_writer_write_symbol_ref(writer, tag));
+    ION_ASSERT_OK(ion_writer_write_field_name_ref(writer, name));
+    ION_ASSERT_OK(ion_writer_write_symbol_ref(writer, tag));
+    ION_ASSERT_OK(ion_writer_finish_container(writer));
+}
+
+TEST_P(BinaryAndTextTest, WriterWritesInternedSymbolsAcrossSymbolTableContexts) {
+    ION_SYMBOL_TEST_DECLARE_WRITER;
+    ION_STRING id_str, tag_str, ann_str, name_str, other;
+    hSYMBOLREF id, tag, ann, name;
+
+    ION_ASSERT_OK(ion_string_from_cstr("id", &id_str));
+    ION_ASSERT_OK(ion_string_from_cstr("tag", &tag_str));
+    ION_ASSERT_OK(ion_string_from_cstr("ann", &ann_str));
+    ION_ASSERT_OK(ion_string_from_cstr("name", &name_str)); // a system symbol
+    ION_ASSERT_OK(ion_string_from_cstr("other", &other));
+
+    ION_ASSERT_OK(ion_test_new_writer(&writer, &stream, is_binary));
+    ION_ASSERT_OK(ion_writer_intern_symbol(writer, &id_str, &id));
+    ION_ASSERT_OK(ion_writer_intern_symbol(writer, &tag_str, &tag));
+    ION_ASSERT_OK(ion_writer_intern_symbol(writer, &ann_str, &ann));
+    ION_ASSERT_OK(ion_writer_intern_symbol(writer, &name_str, &name));
+
+    test_ion_symbol_write_with_refs(writer, id, tag, ann, name);
+    test_ion_symbol_write_with_refs(writer, id, tag, ann, name);
+    // The cached SIDs are still good after a flush, which appends to the same symbol table...
+    ION_ASSERT_OK(ion_writer_flush(writer, &bytes_flushed));
+    test_ion_symbol_write_with_refs(writer, id, tag, ann, name);
+    // ...but not after a finish, which starts a new one, where "other" takes the first local SID.
+    ION_ASSERT_OK(ion_writer_finish(writer, &bytes_flushed));
+    ION_ASSERT_OK(ion_writer_write_symbol(writer, &other));
+    test_ion_symbol_write_with_refs(writer, id, tag, ann, name);
+
+    ION_SYMBOL_TEST_REWRITE_FROM_WRITER_AND_ASSERT_TEXT(
+        "ann::{id:tag,name:tag} ann::{id:tag,name:tag} ann::{id:tag,name:tag} other ann::{id:tag,name:tag}");
+}
@@ -13,6 +13,7 @@
  */
 
 #include "ion_assert.h"
+#include <string>
 #include "ion_helpers.h"
 #include "ion_test_util.h"
 #include "ion_event_equivalence.h"
@@ -614,6 +615,34 @@ TEST(IonTextDecimal, FailsEarlyOnInvalidDecimal) {
     ION_ASSERT_OK(ion_reader_close(reader));
 }
 
+TEST(IonTextFloat, ReaderReadsCorrectlyRoundedDoubles) {
+    // Each value is followed by the double it must round to, written in a form strtod reads exactly.
+    const char *ion_text =
+        "1.5e0 2.2250738585072011e-308 4.9406564584124654e-324 2.4703282292062328e-324 1.7976931348623157e308 "
+        "1.7976931348623159e308 1e-400 -0e0 9007199254740993e0 1_000.000_5e0 7.038531e-26 "
+        "123456789012345678901234567890e-10 1.00000000000000011102230246251565404236316680908203125e0 "
+        "1.00000000000000011102230246251565404236316680908203126e0";
+    double expected[] = {
+        1.5, 2.2250738585072009e-308, 4.9406564584124654e-324, 4.9406564584124654e-324, 1.7976931348623157e308,
+        INFINITY, 0.0, -0.0, 9007199254740992.0, 1000.0005, 7.038531e-26,
+        12345678901234567890.123456789, 1.0, 1.0000000000000002
+    };
+    hREADER  reader;
+    ION_TYPE type;
+    double   actual;
+
+    ION_ASSERT_OK(ion_test_new_text_reader(ion_text, &reader));
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        ION_ASSERT_OK(ion_reader_next(reader, &type));
+        ASSERT_EQ(tid_FLOAT, type);
+        ION_ASSERT_OK(ion_reader_read_double(reader, &actual));
+        ASSERT_EQ(0, memcmp(&expected[i], &actual, sizeof(double))) << "value " << i << ": " << actual;
+    }
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_EOF, type);
+    ION_ASSERT_OK(ion_reader_close(reader));
+}
+
 /**
  * Creates a new reader which reads ion_text and asserts that the next value is of expected_type and of expected_lob_size
  */
@@ -801,6 +830,28 @@ TEST(IonTextInt, BinaryLiterals) {
     ION_ASSERT_OK(ion_reader_close(reader));
 }
 
+TEST(IonTextInt, DecimalLiteralsAroundTheSmallIntLimit) {
+    // 18 digits are accumulated while scanning, longer literals are converted from the text
+    const char *ion_text = "0 -7 1_000_000 999999999999999999 -999999999999999999 9223372036854775807 -9223372036854775808 "
+                           "9223372036854775808";
+    int64_t expected[] = { 0, -7, 1000000, 999999999999999999LL, -999999999999999999LL, INT64_MAX, INT64_MIN };
+    hREADER  reader;
+    ION_TYPE type;
+    int64_t  value;
+
+    ION_ASSERT_OK(ion_test_new_text_reader(ion_text, &reader));
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        ION_ASSERT_OK(ion_reader_next(reader, &type));
+        ASSERT_EQ(tid_INT, type);
+        ION_ASSERT_OK(ion_reader_read_int64(reader, &value));
+        ASSERT_EQ(expected[i], value);
+    }
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_INT, type);
+    ASSERT_EQ(IERR_NUMERIC_OVERFLOW, ion_reader_read_int64(reader, &value));
+    ION_ASSERT_OK(ion_reader_close(reader));
+}
+
 TEST(IonTextTimestamp, InvalidTimestamp) {
     const char *ion_text = "2007-02-23T12:14:32.13371337133713371337844674407370955551616Z";
     hREADER  reader;
@@ -1332,6 +1383,221 @@ TEST(IonTextPosition, LongStringPositions) {
     ion_reader_close(reader);
 }
 
+/** Tests ion_reader_get_value_position after whitespace runs longer than a scan block, with both new line forms. */
+TEST(IonTextPosition, PositionsAfterLongWhitespaceRuns) {
+    const char *ion_text = "                    1\r\n\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t 2\n\n\r\n                   3";
+
+    hREADER  reader;
+    ION_TYPE type;
+
+    ION_ASSERT_OK(ion_test_new_text_reader(ion_text, &reader));
+
+    int64_t offset = 0;
+    int32_t line = 0;
+    int32_t col_offset = 0;
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_INT, type);
+    ION_ASSERT_OK(ion_reader_get_value_position(reader, &offset, &line, &col_offset));
+    ASSERT_EQ(offset, 20);
+    ASSERT_EQ(line, 1);
+    ASSERT_EQ(col_offset, 20);
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_INT, type);
+    ION_ASSERT_OK(ion_reader_get_value_position(reader, &offset, &line, &col_offset));
+    ASSERT_EQ(offset, 42);
+    ASSERT_EQ(line, 2);
+    ASSERT_EQ(col_offset, 19);
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_INT, type);
+    ION_ASSERT_OK(ion_reader_get_value_position(reader, &offset, &line, &col_offset));
+    ASSERT_EQ(offset, 66);
+    ASSERT_EQ(line, 5);
+    ASSERT_EQ(col_offset, 19);
+
+    ion_reader_close(reader);
+}
+
+/** Tests that skipping containers holding long strings, comments and nested values leaves the reader on the next value. */
+TEST(IonTextPosition, PositionAfterSkippedContainers) {
+    const char *ion_text =
+        "{a:\"a string long enough to span several scan blocks ] } ) \\\" \", b:[1, (2 3), '''x ] y'''],\n"
+        " c:'quoted } symbol', /* ] */ d:{{ aGVsbG8= }}, e:{{\"clob ]\"}}, f:{}}\n"
+        "[\"another\\nfake\", 'line']\n"
+        "   next";
+
+    hREADER    reader;
+    ION_TYPE   type;
+    ION_STRING str;
+
+    ION_ASSERT_OK(ion_test_new_text_reader(ion_text, &reader));
+
+    int64_t offset = 0;
+    int32_t line = 0;
+    int32_t col_offset = 0;
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_STRUCT, type);
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_LIST, type);
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_SYMBOL, type);
+    ION_ASSERT_OK(ion_reader_read_string(reader, &str));
+    assertStringsEqual("next", (char *)str.value, str.length);
+    ION_ASSERT_OK(ion_reader_get_value_position(reader, &offset, &line, &col_offset));
+    ASSERT_EQ(line, 4);
+    ASSERT_EQ(col_offset, 3);
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_EOF, type);
+
+    ion_reader_close(reader);
+}
+
+/** Tests skipping containers nested deeper than the skip stack, with comments and long strings holding brackets. */
+TEST(IonTextPosition, PositionAfterSkippedDeepContainers) {
+    std::string ion_text;
+    for (int i = 0; i < 100; i++) {
+        ion_text += (i % 3 == 0) ? "[" : (i % 3 == 1) ? "(" : "{a:";
+    }
+    ion_text += "// ] ) }\n'''] ) }''' /* ] ) } */ '' '}'\r\n";
+    for (int i = 99; i >= 0; i--) {
+        ion_text += (i % 3 == 0) ? "]" : (i % 3 == 1) ? ")" : "}";
+    }
+    ion_text += "\n  last";
+
+    hREADER    reader;
+    ION_TYPE   type;
+    ION_STRING str;
+
+    ION_ASSERT_OK(ion_test_new_text_reader(ion_text.c_str(), &reader));
+
+    int64_t offset = 0;
+    int32_t line = 0;
+    int32_t col_offset = 0;
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_LIST, type);
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_SYMBOL, type);
+    ION_ASSERT_OK(ion_reader_read_string(reader, &str));
+    assertStringsEqual("last", (char *)str.value, str.length);
+    ION_ASSERT_OK(ion_reader_get_value_position(reader, &offset, &line, &col_offset));
+    ASSERT_EQ(line, 4);
+    ASSERT_EQ(col_offset, 2);
+
+    ion_reader_close(reader);
+}
+
+/** Tests that strings longer than a scan block are read intact, including escapes and multi-byte characters. */
+TEST(IonTextString, ReaderReadsLongStrings) {
+    const char *ion_text = "\"abcdefghijklmnopqrstuvwxyz \\\"quoted\\\" \\u00e9 \xc3\xa9 0123456789\" '''long\nstring ''' '''continued'''";
+
+    hREADER    reader;
+    ION_TYPE   type;
+    ION_STRING str;
+
+    ION_ASSERT_OK(ion_test_new_text_reader(ion_text, &reader));
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_STRING, type);
+    ION_ASSERT_OK(ion_reader_read_string(reader, &str));
+    assertStringsEqual("abcdefghijklmnopqrstuvwxyz \"quoted\" \xc3\xa9 \xc3\xa9 0123456789", (char *)str.value, str.length);
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_STRING, type);
+    ION_ASSERT_OK(ion_reader_read_string(reader, &str));
+    assertStringsEqual("long\nstring continued", (char *)str.value, str.length);
+
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_EOF, type);
+
+    ion_reader_close(reader);
+}
+
+TEST(IonTextString, WriterEscapesLongStrings) {
+    // escapes before, on and after the 16 byte block boundaries, and the quote not in use
+    const char *value = "abcdefghijklmnop\"qrstuvwxyz0123'456789\\abcdefghijklmn\nopqrst \xc3\xa9 uvwxyzABCDEFGHIJKLMNOP\x01";
+    const char *symbol = "abcdefghijklmnop'qrstuvwxyz\"";
+    hWRITER writer = NULL;
+    ION_STREAM *ion_stream = NULL;
+    BYTE *result;
+    SIZE result_len;
+    ION_STRING str;
+
+    ION_ASSERT_OK(ion_test_new_writer(&writer, &ion_stream, FALSE));
+    ION_ASSERT_OK(ion_writer_write_string(writer, ion_string_assign_cstr(&str, (char *)value, strlen(value))));
+    ION_ASSERT_OK(ion_writer_write_symbol(writer, ion_string_assign_cstr(&str, (char *)symbol, strlen(symbol))));
+    ION_ASSERT_OK(ion_test_writer_get_bytes(writer, ion_stream, &result, &result_len));
+
+    assertStringsEqual("\"abcdefghijklmnop\\\"qrstuvwxyz0123'456789\\\\abcdefghijklmn\\nopqrst \xc3\xa9 uvwxyzABCDEFGHIJKLMNOP\\x01\""
+                       " 'abcdefghijklmnop\\'qrstuvwxyz\"'", (char *)result, result_len);
+
+    free(result);
+}
+
+iERR write_nested_lists_pretty(BOOL indent_with_tabs, SIZE indent_size, int depth, std::string *out) {
+    iENTER;
+    hWRITER writer = NULL;
+    ION_STREAM *ion_stream = NULL;
+    ION_WRITER_OPTIONS options;
+    BYTE *result = NULL;
+    SIZE result_len;
+
+    memset(&options, 0, sizeof(options));
+    options.pretty_print = TRUE;
+    options.indent_with_tabs = indent_with_tabs;
+    options.indent_size = indent_size;
+
+    IONCHECK(ion_stream_open_memory_only(&ion_stream));
+    IONCHECK(ion_writer_open(&writer, ion_stream, &options));
+    for (int i = 0; i < depth; i++) {
+        IONCHECK(ion_writer_start_container(writer, tid_LIST));
+    }
+    IONCHECK(ion_writer_write_int(writer, 1));
+    for (int i = 0; i < depth; i++) {
+        IONCHECK(ion_writer_finish_container(writer));
+    }
+    IONCHECK(ion_test_writer_get_bytes(writer, ion_stream, &result, &result_len));
+    out->assign((char *)result, result_len);
+    free(result);
+    iRETURN;
+}
+
+std::string expected_nested_lists_pretty(const std::string &indent, int depth) {
+    std::string expected;
+    for (int i = 0; i < depth; i++) {
+        if (i > 0) expected += "\n";
+        for (int j = 0; j < i; j++) expected += indent;
+        expected += "[";
+    }
+    expected += "\n";
+    for (int j = 0; j < depth; j++) expected += indent;
+    expected += "1";
+    for (int i = depth - 1; i >= 0; i--) {
+        expected += "\n";
+        for (int j = 0; j < i; j++) expected += indent;
+        expected += "]";
+    }
+    return expected + "\n"; // the writer ends pretty printed output with a new line
+}
+
+TEST(IonTextWriter, PrettyPrintIndentsDeeplyNestedValues) {
+    // indents longer than the writer's prebuilt runs of spaces and tabs
+    std::string actual;
+
+    ION_ASSERT_OK(write_nested_lists_pretty(FALSE, 4, 40, &actual));
+    ASSERT_EQ(expected_nested_lists_pretty("    ", 40), actual);
+
+    ION_ASSERT_OK(write_nested_lists_pretty(TRUE, 0, 40, &actual));
+    ASSERT_EQ(expected_nested_lists_pretty("\t", 40), actual);
+
+    ION_ASSERT_OK(write_nested_lists_pretty(FALSE, 0, 3, &actual));
+    ASSERT_EQ(expected_nested_lists_pretty("  ", 3), actual);
+}
+
 iERR convert_to_json(const char *ion_text, const char *json_text, size_t size) {
     iERR err = IERR_OK;
     hREADER reader = NULL;
@@ -1395,6 +1661,8 @@ TEST(IonTextDownconvert, Strings) {
     IONJSON_CMP("\" \\x0B \"", "\" \\u000B \"");
     IONJSON_CMP("\" \\xAE \"", "\" \\u00AE \"");
     IONJSON_CMP("\" μ \"", "\" \\u03BC \"");
+    IONJSON_CMP("\"abcdefghijklmnopqrstuvwxyz μ 'quoted' \\\" 0123456789\"",
+                "\"abcdefghijklmnopqrstuvwxyz \\u03BC 'quoted' \\\" 0123456789\"");
 }
 
 TEST(IonTextDownconvert, IntsFloatsAndDecimals) {
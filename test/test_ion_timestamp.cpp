@@ -184,3 +184,225 @@ TEST_P(IonTimestampOutOfRangeFraction, WriterFailsOnOutOfRangeFraction) {
     ION_ASSERT_OK(ion_writer_close(writer));
     ION_ASSERT_OK(ion_stream_close(stream));
 }
+
+class IonTimestampEpochNanos : public testing::TestWithParam< testing::tuple<std::string, int64_t, int, int> > {
+public:
+    std::string str;
+    int64_t epoch_nanos;
+    int precision;
+    int offset;
+
+    virtual void SetUp() {
+        str = testing::get<0>(GetParam());
+        epoch_nanos = testing::get<1>(GetParam());
+        precision = testing::get<2>(GetParam());
+        offset = testing::get<3>(GetParam());
+    }
+
+    void assertReadsEpochNanos(hREADER reader) {
+        ION_TYPE type;
+        int64_t actual_nanos;
+        int actual_precision, actual_offset;
+
+        ION_ASSERT_OK(ion_reader_next(reader, &type));
+        ASSERT_EQ(tid_TIMESTAMP, type);
+        ION_ASSERT_OK(ion_reader_read_timestamp_epoch_nanos(reader, &actual_nanos, &actual_precision, &actual_offset));
+        ASSERT_EQ(epoch_nanos, actual_nanos) << str;
+        ASSERT_EQ(precision, actual_precision) << str;
+        ASSERT_EQ(offset, actual_offset) << str;
+        ION_ASSERT_OK(ion_reader_next(reader, &type));
+        ASSERT_EQ(tid_EOF, type);
+    }
+};
+
+INSTANTIATE_TEST_CASE_P(IonTimestampEpochNanosParameterized, IonTimestampEpochNanos, testing::Values(
+        std::tr1::make_tuple(std::string("2020-07-01T14:24:57-01:00"), 1593617097000000000LL, ION_TS_SEC, -60),
+        std::tr1::make_tuple(std::string("2020-07-01T14:24:57.123456789+01:00"), 1593609897123456789LL, ION_TS_FRAC, 60),
+        std::tr1::make_tuple(std::string("2020-07-01T13:24:57.1234567891Z"), 1593609897123456789LL, ION_TS_FRAC, 0),
+        std::tr1::make_tuple(std::string("2020-07-01T13:24:57.12345678912345678912345Z"), 1593609897123456789LL, ION_TS_FRAC, 0),
+        std::tr1::make_tuple(std::string("1969-12-31T23:59:59.999Z"), -1000000LL, ION_TS_FRAC, 0),
+        std::tr1::make_tuple(std::string("2007T"), 1167609600000000000LL, ION_TS_YEAR, ION_TIMESTAMP_UNKNOWN_OFFSET),
+        std::tr1::make_tuple(std::string("2007-02T"), 1170288000000000000LL, ION_TS_MONTH, ION_TIMESTAMP_UNKNOWN_OFFSET),
+        std::tr1::make_tuple(std::string("2007-02-23"), 1172188800000000000LL, ION_TS_DAY, ION_TIMESTAMP_UNKNOWN_OFFSET),
+        std::tr1::make_tuple(std::string("2007-02-23T12:14-00:00"), 1172232840000000000LL, ION_TS_MIN, ION_TIMESTAMP_UNKNOWN_OFFSET),
+        std::tr1::make_tuple(std::string("2000-03-01T00:30+01:00"), 951867000000000000LL, ION_TS_MIN, 60),
+        std::tr1::make_tuple(std::string("2262-04-11T23:47:16.854775807Z"), MAX_INT64, ION_TS_FRAC, 0)
+));
+
+TEST_P(IonTimestampEpochNanos, TextReaderReadsEpochNanos) {
+    hREADER reader;
+
+    ION_ASSERT_OK(ion_test_new_text_reader(str.c_str(), &reader));
+    assertReadsEpochNanos(reader);
+    ION_ASSERT_OK(ion_reader_close(reader));
+}
+
+TEST_P(IonTimestampEpochNanos, BinaryReaderReadsEpochNanos) {
+    hREADER reader;
+    hWRITER writer;
+    ION_STREAM *stream;
+    BYTE *bytes;
+    SIZE bytes_len;
+
+    ION_ASSERT_OK(ion_test_new_text_reader(str.c_str(), &reader));
+    ION_ASSERT_OK(ion_test_new_writer(&writer, &stream, TRUE));
+    ION_ASSERT_OK(ion_writer_write_all_values(writer, reader));
+    ION_ASSERT_OK(ion_reader_close(reader));
+    ION_ASSERT_OK(ion_test_writer_get_bytes(writer, stream, &bytes, &bytes_len));
+
+    ION_ASSERT_OK(ion_test_new_reader(bytes, bytes_len, &reader));
+    assertReadsEpochNanos(reader);
+    ION_ASSERT_OK(ion_reader_close(reader));
+    free(bytes);
+}
+
+TEST_P(IonTimestampEpochNanos, WritersRoundTripEpochNanos) {
+    hREADER reader;
+    hWRITER writer;
+    ION_STREAM *stream;
+    BYTE *bytes;
+    SIZE bytes_len;
+
+    for (int is_binary = 0; is_binary < 2; is_binary++) {
+        ION_ASSERT_OK(ion_test_new_writer(&writer, &stream, (BOOL)is_binary));
+        ION_ASSERT_OK(ion_writer_write_timestamp_epoch_nanos(writer, epoch_nanos, precision, offset));
+        ION_ASSERT_OK(ion_test_writer_get_bytes(writer, stream, &bytes, &bytes_len));
+        ION_ASSERT_OK(ion_test_new_reader(bytes, bytes_len, &reader));
+        assertReadsEpochNanos(reader);
+        ION_ASSERT_OK(ion_reader_close(reader));
+        free(bytes);
+    }
+}
+
+TEST(IonTimestampEpochNanosWrite, TextWriterWritesShortestFraction) {
+    hWRITER writer;
+    ION_STREAM *stream;
+    BYTE *bytes;
+    SIZE bytes_len;
+
+    ION_ASSERT_OK(ion_test_new_writer(&writer, &stream, FALSE));
+    ION_ASSERT_OK(ion_writer_write_timestamp_epoch_nanos(writer, 1593609897120000000LL, ION_TS_FRAC, 60));
+    ION_ASSERT_OK(ion_writer_write_timestamp_epoch_nanos(writer, 1593609897123450000LL, ION_TS_FRAC, -90));
+    ION_ASSERT_OK(ion_writer_write_timestamp_epoch_nanos(writer, 1593609897000000000LL, ION_TS_FRAC, 0));
+    ION_ASSERT_OK(ion_writer_write_timestamp_epoch_nanos(writer, -1LL, ION_TS_DAY, 60));
+    ION_ASSERT_OK(ion_test_writer_get_bytes(writer, stream, &bytes, &bytes_len));
+
+    ASSERT_EQ(std::string("2020-07-01T14:24:57.120+01:00 2020-07-01T11:54:57.123450-01:30 2020-07-01T13:24:57.000Z 1969-12-31"),
+              std::string((char *)bytes, bytes_len));
+    free(bytes);
+}
+
+TEST(IonTimestampEpochNanosWrite, RejectsOutOfRangeArguments) {
+    hWRITER writer;
+    ION_STREAM *stream;
+    hREADER reader;
+    ION_TYPE type;
+    int64_t nanos;
+    int precision, offset;
+
+    ION_ASSERT_OK(ion_test_new_writer(&writer, &stream, TRUE));
+    ASSERT_EQ(IERR_INVALID_ARG, ion_writer_write_timestamp_epoch_nanos(writer, 0, ION_TT_BIT_SEC, 0));
+    ASSERT_EQ(IERR_INVALID_ARG, ion_writer_write_timestamp_epoch_nanos(writer, 0, ION_TS_MIN, 24 * 60));
+    ION_ASSERT_OK(ion_writer_close(writer));
+    ION_ASSERT_OK(ion_stream_close(stream));
+
+    ION_ASSERT_OK(ion_test_new_text_reader("1600-01-01T00:00Z 2262-04-11T23:47:16.854775808Z null.timestamp", &reader));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(IERR_NUMERIC_OVERFLOW, ion_reader_read_timestamp_epoch_nanos(reader, &nanos, &precision, &offset));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(IERR_NUMERIC_OVERFLOW, ion_reader_read_timestamp_epoch_nanos(reader, &nanos, &precision, &offset));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(IERR_NULL_VALUE, ion_reader_read_timestamp_epoch_nanos(reader, &nanos, &precision, &offset));
+    ION_ASSERT_OK(ion_reader_close(reader));
+}
+
+TEST(IonTimestampEpochNanosRead, BinaryReaderRejectsMalformedFields) {
+    hREADER reader;
+    ION_TYPE type;
+    int64_t nanos;
+    int precision, offset;
+    // 2020T, 2020-07 with the month's end bit missing, then year 10000
+    BYTE data[] = {0xE0, 0x01, 0x00, 0xEA, 0x63, 0x80, 0x0F, 0xE4, 0x64, 0x80, 0x0F, 0xE4, 0x07, 0x63, 0x80, 0x4E, 0x90};
+
+    ION_ASSERT_OK(ion_test_new_reader(data, (SIZE)sizeof(data), &reader));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ION_ASSERT_OK(ion_reader_read_timestamp_epoch_nanos(reader, &nanos, &precision, &offset));
+    ASSERT_EQ(1577836800000000000LL, nanos);
+    ASSERT_EQ(ION_TS_YEAR, precision);
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(IERR_INVALID_BINARY, ion_reader_read_timestamp_epoch_nanos(reader, &nanos, &precision, &offset));
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(IERR_INVALID_BINARY, ion_reader_read_timestamp_epoch_nanos(reader, &nanos, &precision, &offset));
+    ION_ASSERT_OK(ion_reader_close(reader));
+}
+
+class IonTimestampTextLayout : public ::testing::TestWithParam<const char *> {};
+
+INSTANTIATE_TEST_CASE_P(IonTimestampTextLayoutParameterized, IonTimestampTextLayout, testing::Values(
+        "2020-07-01T14:24:57Z",
+        "2020-07-01T14:24:57.1Z",
+        "2020-07-01T14:24:57.123+01:00",
+        "0001-01-01T00:00:00.000000-00:00",
+        "9999-12-31T23:59:59.999999999-23:59",
+        "2000-02-29T12:00:00.12345678+05:30",
+        "2020-07-01T14:24:57.1234567890Z",
+        "2020-07-01T14:24Z",
+        "2020-07-01T14:24+01:00",
+        "2020-07-01",
+        "2020-07T",
+        "2020T"
+));
+
+TEST_P(IonTimestampTextLayout, ParseAndFormatRoundTrip) {
+    const char *image = GetParam();
+    char buffer[ION_TIMESTAMP_STRING_LENGTH + 1];
+    ION_TIMESTAMP timestamp;
+    SIZE used, written;
+
+    ION_ASSERT_OK(ion_timestamp_parse(&timestamp, (char *)image, (SIZE)strlen(image), &used, &g_IonEventDecimalContext));
+    ASSERT_EQ(strlen(image), (size_t)used);
+    ION_ASSERT_OK(ion_timestamp_to_string(&timestamp, buffer, sizeof(buffer), &written, &g_IonEventDecimalContext));
+    ASSERT_EQ(std::string(image), std::string(buffer, written));
+}
+
+TEST(IonTimestampTextLayout, ParsesFixedLayoutFields) {
+    char image[] = "2000-02-29T12:34:56.007-08:30 ";
+    char expected_fraction[DECQUAD_String];
+    ION_TIMESTAMP timestamp;
+    SIZE used;
+    int offset;
+
+    ION_ASSERT_OK(ion_timestamp_parse(&timestamp, image, (SIZE)strlen(image), &used, &g_IonEventDecimalContext));
+    ASSERT_EQ(strlen(image) - 1, (size_t)used);
+    ASSERT_EQ(ION_TS_FRAC | ION_TT_BIT_TZ, timestamp.precision);
+    ASSERT_EQ(2000, timestamp.year);
+    ASSERT_EQ(2, timestamp.month);
+    ASSERT_EQ(29, timestamp.day);
+    ASSERT_EQ(12, timestamp.hours);
+    ASSERT_EQ(34, timestamp.minutes);
+    ASSERT_EQ(56, timestamp.seconds);
+    decQuadToString(&timestamp.fraction, expected_fraction);
+    ASSERT_STREQ("0.007", expected_fraction);
+    ION_ASSERT_OK(ion_timestamp_get_local_offset(&timestamp, &offset));
+    ASSERT_EQ(-(8 * 60 + 30), offset);
+}
+
+TEST(IonTimestampTextLayout, InvalidFixedLayoutValuesFail) {
+    const char *images[] = {
+        "2020-13-01T14:24:57Z",
+        "2019-02-29T14:24:57Z",
+        "2020-07-01T24:24:57Z",
+        "2020-07-01T14:60:57Z",
+        "2020-07-01T14:24:57+24:00",
+        "2020-07-01T14:24:57.Z",
+        "2020-07-01T14:24:57Zx",
+        "2020-07-0aT14:24:57Z",
+    };
+    ION_TIMESTAMP timestamp;
+    SIZE used;
+
+    for (size_t ii = 0; ii < sizeof(images) / sizeof(images[0]); ii++) {
+        ASSERT_EQ(IERR_INVALID_TIMESTAMP, ion_timestamp_parse(&timestamp, (char *)images[ii], (SIZE)strlen(images[ii]),
+                                                             &used, &g_IonEventDecimalContext)) << images[ii];
+    }
+}
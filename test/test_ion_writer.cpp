@@ -12,6 +12,7 @@
  * language governing permissions and limitations under the License.
  */
 
+#include <string>
 #include <ion_event_util.h>
 #include <ion_event_stream_impl.h>
 #include "ion_assert.h"
@@ -106,3 +107,503 @@ TEST_F(WriterTest, TextWriterCloseMustFlushStream) {
 
     ASSERT_EQ(file_size, 4);
 }
+
+// writes {id:<index>,tag:t<index % 50>} and, for index fail_at, fails
+iERR test_ion_writer_batch_write_value(hWRITER writer, void *user_context, SIZE value_index) {
+    iENTER;
+    ION_STRING str;
+    char tag[16];
+    SIZE fail_at = *(SIZE *)user_context;
+
+    if (value_index == fail_at) FAILWITH(IERR_INVALID_SYNTAX);
+    snprintf(tag, sizeof(tag), "t%d", (int)(value_index % 50));
+    IONCHECK(ion_writer_start_container(writer, tid_STRUCT));
+    IONCHECK(ion_writer_write_field_name(writer, ion_string_assign_cstr(&str, (char *)"id", 2)));
+    IONCHECK(ion_writer_write_int(writer, value_index));
+    IONCHECK(ion_writer_write_field_name(writer, ion_string_assign_cstr(&str, (char *)"tag", 3)));
+    IONCHECK(ion_writer_write_symbol(writer, ion_string_assign_cstr(&str, tag, (SIZE)strlen(tag))));
+    IONCHECK(ion_writer_finish_container(writer));
+    iRETURN;
+}
+
+void test_ion_writer_batch_read_values(hREADER reader, int first, int count) {
+    ION_TYPE type;
+    ION_STRING str;
+    char tag[16];
+    int value;
+
+    for (int i = first; i < first + count; i++) {
+        ION_ASSERT_OK(ion_reader_next(reader, &type));
+        ASSERT_EQ(tid_STRUCT, type);
+        ION_ASSERT_OK(ion_reader_step_in(reader));
+        ION_ASSERT_OK(ion_reader_next(reader, &type));
+        ION_ASSERT_OK(ion_reader_read_int(reader, &value));
+        ASSERT_EQ(i, value);
+        ION_ASSERT_OK(ion_reader_next(reader, &type));
+        ION_ASSERT_OK(ion_reader_read_string(reader, &str));
+        snprintf(tag, sizeof(tag), "t%d", i % 50);
+        assertStringsEqual(tag, (char *)str.value, str.length);
+        ION_ASSERT_OK(ion_reader_step_out(reader));
+    }
+}
+
+TEST(IonWriterBatch, BinaryWriterSerializesValuesInOrderOnWorkers) {
+    hWRITER writer = NULL;
+    hREADER reader = NULL;
+    ION_STREAM *stream = NULL;
+    ION_WRITER_BATCH_OPTIONS options;
+    ION_TYPE type;
+    BYTE *data;
+    SIZE data_len, fail_at = -1;
+
+    memset(&options, 0, sizeof(options));
+    options.num_workers = 4;
+    options.values_per_segment = 7;
+
+    ION_ASSERT_OK(ion_test_new_writer(&writer, &stream, TRUE));
+    // values written before and after the batch keep their own symbol table contexts
+    ION_ASSERT_OK(test_ion_writer_batch_write_value(writer, &fail_at, 1000));
+    ION_ASSERT_OK(ion_writer_write_batch(writer, &test_ion_writer_batch_write_value, &fail_at, 1000, &options));
+    ION_ASSERT_OK(test_ion_writer_batch_write_value(writer, &fail_at, 1001));
+    ION_ASSERT_OK(ion_test_writer_get_bytes(writer, stream, &data, &data_len));
+
+    ION_ASSERT_OK(ion_reader_open_buffer(&reader, data, data_len, NULL));
+    test_ion_writer_batch_read_values(reader, 1000, 1);
+    test_ion_writer_batch_read_values(reader, 0, 1000);
+    test_ion_writer_batch_read_values(reader, 1001, 1);
+    ION_ASSERT_OK(ion_reader_next(reader, &type));
+    ASSERT_EQ(tid_EOF, type);
+    ION_ASSERT_OK(ion_reader_close(reader));
+    free(data);
+}
+
+TEST(IonWriterBatch, BinaryWriterWritesNothingWhenAValueFails) {
+    hWRITER writer = NULL;
+    ION_STREAM *stream = NULL;
+    ION_WRITER_BATCH_OPTIONS options;
+    BYTE *data;
+    SIZE data_len, fail_at = 500;
+
+    memset(&options, 0, sizeof(options));
+    options.num_workers = 4;
+
+    ION_ASSERT_OK(ion_test_new_writer(&writer, &stream, TRUE));
+    ASSERT_EQ(IERR_INVALID_SYNTAX,
+              ion_writer_write_batch(writer, &test_ion_writer_batch_write_value, &fail_at, 1000, &options));
+    ION_ASSERT_OK(ion_test_writer_get_bytes(writer, stream, &data, &data_len));
+    // nothing but the version marker the writer was finished with
+    ASSERT_EQ(4, data_len);
+    free(data);
+}
+
+TEST(IonWriterBatch, TextWriterWritesValuesInPlace) {
+    hWRITER writer = NULL;
+    ION_STREAM *stream = NULL;
+    BYTE *data;
+    SIZE data_len, fail_at = -1;
+
+    ION_ASSERT_OK(ion_test_new_writer(&writer, &stream, FALSE));
+    ION_ASSERT_OK(ion_writer_write_batch(writer, &test_ion_writer_batch_write_value, &fail_at, 3, NULL));
+    ION_ASSERT_OK(ion_test_writer_get_bytes(writer, stream, &data, &data_len));
+    assertStringsEqual("{id:0,tag:t0} {id:1,tag:t1} {id:2,tag:t2}", (char *)data, data_len);
+    free(data);
+}
+
+#define TEST_TEMPLATE_FIELD_COUNT 9
+
+static ION_TYPE test_template_types[TEST_TEMPLATE_FIELD_COUNT] = {
+    tid_BOOL, tid_INT, tid_FLOAT, tid_DECIMAL, tid_TIMESTAMP, tid_STRING, tid_CLOB, tid_BLOB, tid_SYMBOL
+};
+
+static const char *test_template_names[TEST_TEMPLATE_FIELD_COUNT] = {
+    "ok", "id", "score", "price", "at", "message", "raw", "payload", "kind"
+};
+
+// fills in row i of the template test, every third one with nulls for the types that have them
+void test_ion_writer_template_row(int i, ION_WRITER_TEMPLATE_VALUE *values, ION_DECIMAL *decimal,
+                                  ION_TIMESTAMP *timestamp, char *text) {
+    memset(values, 0, TEST_TEMPLATE_FIELD_COUNT * sizeof(ION_WRITER_TEMPLATE_VALUE));
+    snprintf(text, 64, "message number %d, long enough to need a length", i);
+    values[0].value.bool_value = (i % 2 == 0);
+    values[1].value.int_value = (i % 2 == 0) ? (int64_t)i * 1000003 : -(int64_t)i;
+    if (i == 1) values[1].value.int_value = INT64_MIN;
+    if (i == 3) values[1].value.int_value = INT64_MAX;
+    values[2].value.float_value = i * 0.5;
+    ION_ASSERT_OK(ion_decimal_from_int32(decimal, i * 7));
+    values[3].value.decimal_value = decimal;
+    ION_ASSERT_OK(ion_timestamp_for_year(timestamp, 2000 + i));
+    values[4].value.timestamp_value = timestamp;
+    ION_ASSERT_OK(ion_string_from_cstr(text, &values[5].value.string_value));
+    ION_ASSERT_OK(ion_string_from_cstr("abc", &values[6].value.string_value));
+    ION_ASSERT_OK(ion_string_from_cstr(text, &values[7].value.string_value));
+    ION_ASSERT_OK(ion_string_from_cstr((i % 2) ? "odd" : "even", &values[8].value.string_value));
+    if (i % 3 == 2) {
+        values[1].is_null = TRUE;
+        values[3].is_null = TRUE;
+        values[5].is_null = TRUE;
+        values[7].value.string_value.value = NULL;
+    }
+}
+
+// writes the rows of the template test with the single value calls
+void test_ion_writer_template_rows_by_hand(hWRITER writer, int count) {
+    ION_WRITER_TEMPLATE_VALUE values[TEST_TEMPLATE_FIELD_COUNT];
+    ION_DECIMAL decimal;
+    ION_TIMESTAMP timestamp;
+    ION_STRING name, names[TEST_TEMPLATE_FIELD_COUNT];
+    char text[64];
+
+    for (int f = 0; f < TEST_TEMPLATE_FIELD_COUNT; f++) {
+        ION_ASSERT_OK(ion_string_from_cstr(test_template_names[f], &names[f]));
+    }
+    for (int i = 0; i < count; i++) {
+        test_ion_writer_template_row(i, values, &decimal, &timestamp, text);
+        ION_ASSERT_OK(ion_writer_add_annotation(writer, ion_string_assign_cstr(&name, (char *)"event", 5)));
+        ION_ASSERT_OK(ion_writer_start_container(writer, tid_STRUCT));
+        for (int f = 0; f < TEST_TEMPLATE_FIELD_COUNT; f++) {
+            ION_ASSERT_OK(ion_writer_write_field_name(writer, &names[f]));
+            if (values[f].is_null) {
+                ION_ASSERT_OK(ion_writer_write_typed_null(writer, test_template_types[f]));
+                continue;
+            }
+            switch (f) {
+                case 0: ION_ASSERT_OK(ion_writer_write_bool(writer, values[f].value.bool_value)); break;
+                case 1: ION_ASSERT_OK(ion_writer_write_int64(writer, values[f].value.int_value)); break;
+                case 2: ION_ASSERT_OK(ion_writer_write_double(writer, values[f].value.float_value)); break;
+                case 3: ION_ASSERT_OK(ion_writer_write_ion_decimal(writer, values[f].value.decimal_value)); break;
+                case 4: ION_ASSERT_OK(ion_writer_write_timestamp(writer, values[f].value.timestamp_value)); break;
+                case 5: ION_ASSERT_OK(ion_writer_write_string(writer, &values[f].value.string_value)); break;
+                case 6: ION_ASSERT_OK(ion_writer_write_clob(writer, values[f].value.string_value.value, values[f].value.string_value.length)); break;
+                case 7: ION_ASSERT_OK(ion_writer_write_blob(writer, values[f].value.string_value.value, values[f].value.string_value.length)); break;
+                case 8: ION_ASSERT_OK(ion_writer_write_symbol(writer, &values[f].value.string_value)); break;
+            }
+        }
+        ION_ASSERT_OK(ion_writer_finish_container(writer));
+        ION_ASSERT_OK(ion_decimal_free(&decimal));
+        if (i == count / 2) {
+            ION_ASSERT_OK(ion_writer_finish(writer, NULL));
+        }
+    }
+}
+
+void test_ion_writer_template_rows(hWRITER writer, int count) {
+    ION_WRITER_TEMPLATE_VALUE values[TEST_TEMPLATE_FIELD_COUNT];
+    ION_STRING names[TEST_TEMPLATE_FIELD_COUNT];
+    ION_DECIMAL decimal;
+    ION_TIMESTAMP timestamp;
+    ION_STRING name;
+    hSYMBOLREF event;
+    hTEMPLATE tmpl;
+    char text[64];
+
+    for (int f = 0; f < TEST_TEMPLATE_FIELD_COUNT; f++) {
+        ION_ASSERT_OK(ion_string_from_cstr(test_template_names[f], &names[f]));
+    }
+    ION_ASSERT_OK(ion_writer_create_template(writer, names, test_template_types, TEST_TEMPLATE_FIELD_COUNT, &tmpl));
+    ION_ASSERT_OK(ion_writer_intern_symbol(writer, ion_string_assign_cstr(&name, (char *)"event", 5), &event));
+
+    for (int i = 0; i < count; i++) {
+        test_ion_writer_template_row(i, values, &decimal, &timestamp, text);
+        ION_ASSERT_OK(ion_writer_add_annotation_ref(writer, event));
+        ION_ASSERT_OK(ion_writer_write_template_row(writer, tmpl, values));
+        ION_ASSERT_OK(ion_decimal_free(&decimal));
+        if (i == count / 2) {
+            // the rows after this are written with a new symbol table
+            ION_ASSERT_OK(ion_writer_finish(writer, NULL));
+        }
+    }
+}
+
+// the template adds its field names to the symbol table before the row's symbol values, so the binary is compared as text
+std::string test_ion_writer_binary_as_text(BYTE *data, SIZE data_len) {
+    hREADER reader = NULL;
+    hWRITER writer = NULL;
+    ION_STREAM *stream = NULL;
+    BYTE *text;
+    SIZE text_len;
+
+    EXPECT_EQ(IERR_OK, ion_test_new_reader(data, data_len, &reader));
+    EXPECT_EQ(IERR_OK, ion_test_new_writer(&writer, &stream, FALSE));
+    EXPECT_EQ(IERR_OK, ion_writer_write_all_values(writer, reader));
+    EXPECT_EQ(IERR_OK, ion_test_writer_get_bytes(writer, stream, &text, &text_len));
+    EXPECT_EQ(IERR_OK, ion_reader_close(reader));
+    std::string result((char *)text, text_len);
+    free(text);
+    return result;
+}
+
+TEST(IonWriterTemplate, BinaryRowsMatchFieldByFieldOutput) {
+    hWRITER writer = NULL;
+    ION_STREAM *stream = NULL;
+    BYTE *expected, *actual;
+    SIZE expected_len, actual_len;
+
+    ION_ASSERT_OK(ion_test_new_writer(&writer, &stream, TRUE));
+    test_ion_writer_template_rows_by_hand(writer, 10);
+    ION_ASSERT_OK(ion_test_writer_get_bytes(writer, stream, &expected, &expected_len));
+
+    ION_ASSERT_OK(ion_test_new_writer(&writer, &stream, TRUE));
+    test_ion_writer_template_rows(writer, 10);
+    ION_ASSERT_OK(ion_test_writer_get_bytes(writer, stream, &actual, &actual_len));
+
+    ASSERT_EQ(expected_len, actual_len);
+    ASSERT_EQ(test_ion_writer_binary_as_text(expected, expected_len), test_ion_writer_binary_as_text(actual, actual_len));
+    free(expected);
+    free(actual);
+}
+
+TEST(IonWriterTemplate, TextRowsMatchFieldByFieldOutput) {
+    hWRITER writer = NULL;
+    ION_STREAM *stream = NULL;
+    BYTE *expected, *actual;
+    SIZE expected_len, actual_len;
+
+    ION_ASSERT_OK(ion_test_new_writer(&writer, &stream, FALSE));
+    test_ion_writer_template_rows_by_hand(writer, 3);
+    ION_ASSERT_OK(ion_test_writer_get_bytes(writer, stream, &expected, &expected_len));
+
+    ION_ASSERT_OK(ion_test_new_writer(&writer, &stream, FALSE));
+    test_ion_writer_template_rows(writer, 3);
+    ION_ASSERT_OK(ion_test_writer_get_bytes(writer, stream, &actual, &actual_len));
+
+    ASSERT_EQ(std::string((char *)expected, expected_len), std::string((char *)actual, actual_len));
+    free(expected);
+    free(actual);
+}
+
+TEST(IonWriterTemplate, RejectsUnsupportedFieldTypes) {
+    hWRITER writer = NULL;
+    ION_STREAM *stream = NULL;
+    ION_STRING name;
+    ION_TYPE type = tid_LIST;
+    hTEMPLATE tmpl;
+    BYTE *data;
+    SIZE data_len;
+
+    ION_ASSERT_OK(ion_test_new_writer(&writer, &stream, TRUE));
+    ION_ASSERT_OK(ion_string_from_cstr("items", &name));
+    ASSERT_EQ(IERR_INVALID_ARG, ion_writer_create_template(writer, &name, &type, 1, &tmpl));
+    ION_ASSERT_OK(ion_test_writer_get_bytes(writer, stream, &data, &data_len));
+    free(data);
+}
+
+#define TEST_LIST_LENGTH 2000
+
+// writes the lists of the bulk list tests with the single value calls
+void test_ion_writer_lists_by_hand(hWRITER writer, int64_t *ints, double *doubles, ION_STRING *strings, SIZE count) {
+    ION_ASSERT_OK(ion_writer_start_container(writer, tid_LIST));
+    for (SIZE i = 0; i < count; i++) {
+        ION_ASSERT_OK(ion_writer_write_int64(writer, ints[i]));
+    }
+    ION_ASSERT_OK(ion_writer_finish_container(writer));
+    ION_ASSERT_OK(ion_writer_start_container(writer, tid_LIST));
+    for (SIZE i = 0; i < count; i++) {
+        ION_ASSERT_OK(ion_writer_write_double(writer, doubles[i]));
+    }
+    ION_ASSERT_OK(ion_writer_finish_container(writer));
+    ION_ASSERT_OK(ion_writer_start_container(writer, tid_LIST));
+    for (SIZE i = 0; i < count; i++) {
+        ION_ASSERT_OK(ion_writer_write_string(writer, &strings[i]));
+    }
+    ION_ASSERT_OK(ion_writer_finish_container(writer));
+}
+
+void test_ion_writer_lists(hWRITER writer, int64_t *ints, double *doubles, ION_STRING *strings, SIZE count) {
+    ION_ASSERT_OK(ion_writer_write_int64_list(writer, ints, count));
+    ION_ASSERT_OK(ion_writer_write_double_list(writer, doubles, count));
+    ION_ASSERT_OK(ion_writer_write_string_list(writer, strings, count));
+}
+
+class IonBulkLists : public ::testing::Test {
+protected:
+    void SetUp() {
+        static const char *words[] = { "a", "", "a string that is too long for the length nibble" };
+        for (int i = 0; i < TEST_LIST_LENGTH; i++) {
+            ints[i] = (int64_t)((uint64_t)i << (i % 52)) * ((i % 3 == 0) ? -1 : 1);
+            doubles[i] = (i % 5 == 0) ? 0.0 : (i % 2 ? i / 8.0 : -i * 1.1);
+            ION_ASSERT_OK(ion_string_from_cstr(words[i % 3], &strings[i]));
+        }
+        ints[1] = INT64_MIN;
+        ints[2] = INT64_MAX;
+        doubles[1] = -0.0;
+        strings[4].value = NULL;
+    }
+
+    void write(BOOL is_binary, BOOL by_hand, BOOL compact_floats, BYTE **data, SIZE *data_len, SIZE count = TEST_LIST_LENGTH) {
+        hWRITER writer = NULL;
+        ION_STREAM *stream = NULL;
+        ION_WRITER_OPTIONS options;
+
+        ion_event_initialize_writer_options(&options);
+        options.output_as_binary = is_binary;
+        options.compact_floats = compact_floats;
+        ION_ASSERT_OK(ion_stream_open_memory_only(&stream));
+        ION_ASSERT_OK(ion_writer_open(&writer, stream, &options));
+        if (by_hand) {
+            test_ion_writer_lists_by_hand(writer, ints, doubles, strings, count);
+        }
+        else {
+            test_ion_writer_lists(writer, ints, doubles, strings, count);
+        }
+        ION_ASSERT_OK(ion_test_writer_get_bytes(writer, stream, data, data_len));
+    }
+
+    // moves expected_reader over count values of the given type, one at a time, and checks that reader ended up
+    // in the same place (the offsets are only compared for binary)
+    void assertReaderMatches(hREADER reader, hREADER expected_reader, BOOL is_binary, SIZE count, ION_TYPE value_type) {
+        ION_TYPE type, expected_type;
+        POSITION offset, expected_offset;
+        SIZE length, expected_length;
+        int64_t int_value;
+        double double_value;
+
+        for (SIZE i = 0; i < count; i++) {
+            ION_ASSERT_OK(ion_reader_next(expected_reader, &type));
+            ASSERT_EQ(value_type, type);
+            if (value_type == tid_INT) {
+                ION_ASSERT_OK(ion_reader_read_int64(expected_reader, &int_value));
+            }
+            else {
+                ION_ASSERT_OK(ion_reader_read_double(expected_reader, &double_value));
+            }
+        }
+        if (count < 300) {
+            ION_ASSERT_OK(ion_reader_next(expected_reader, &type));
+            ASSERT_EQ(tid_EOF, type);
+        }
+        ION_ASSERT_OK(ion_reader_get_type(expected_reader, &expected_type));
+        ION_ASSERT_OK(ion_reader_get_type(reader, &type));
+        ASSERT_EQ(expected_type, type);
+        if (is_binary) {
+            ION_ASSERT_OK(ion_reader_get_value_offset(expected_reader, &expected_offset));
+            ION_ASSERT_OK(ion_reader_get_value_offset(reader, &offset));
+            ASSERT_EQ(expected_offset, offset);
+            ION_ASSERT_OK(ion_reader_get_value_length(expected_reader, &expected_length));
+            ION_ASSERT_OK(ion_reader_get_value_length(reader, &length));
+            ASSERT_EQ(expected_length, length);
+        }
+    }
+
+    int64_t ints[TEST_LIST_LENGTH];
+    double doubles[TEST_LIST_LENGTH];
+    ION_STRING strings[TEST_LIST_LENGTH];
+};
+
+TEST_F(IonBulkLists, WritersMatchValueByValueOutput) {
+    BYTE *expected, *actual;
+    SIZE expected_len, actual_len;
+
+    for (int variant = 0; variant < 4; variant++) {
+        BOOL is_binary = (variant < 3), compact_floats = (variant == 1);
+        SIZE count = (variant == 2) ? 3 : TEST_LIST_LENGTH;
+        write(is_binary, TRUE, compact_floats, &expected, &expected_len, count);
+        write(is_binary, FALSE, compact_floats, &actual, &actual_len, count);
+        assertBytesEqual((const char *)expected, expected_len, actual, actual_len);
+        free(expected);
+        free(actual);
+    }
+}
+
+TEST_F(IonBulkLists, ReadersReadArraysInChunks) {
+    hREADER reader = NULL, expected_reader = NULL;
+    ION_TYPE type;
+    BYTE *data;
+    SIZE data_len, count, total;
+    int64_t int_chunk[300];
+    double double_chunk[300];
+
+    for (int is_binary = 0; is_binary < 2; is_binary++) {
+        write((BOOL)is_binary, FALSE, FALSE, &data, &data_len);
+        ION_ASSERT_OK(ion_test_new_reader(data, data_len, &reader));
+        ION_ASSERT_OK(ion_test_new_reader(data, data_len, &expected_reader));
+
+        ION_ASSERT_OK(ion_reader_next(reader, &type));
+        ASSERT_EQ(tid_LIST, type);
+        ION_ASSERT_OK(ion_reader_step_in(reader));
+        ION_ASSERT_OK(ion_reader_next(expected_reader, &type));
+        ION_ASSERT_OK(ion_reader_step_in(expected_reader));
+        total = 0;
+        do {
+            ION_ASSERT_OK(ion_reader_read_int64_array(reader, int_chunk, 300, &count));
+            for (SIZE i = 0; i < count; i++) {
+                ASSERT_EQ(ints[total + i], int_chunk[i]);
+            }
+            total += count;
+            // the reader is left just as if it had read the same values one at a time
+            assertReaderMatches(reader, expected_reader, (BOOL)is_binary, count, tid_INT);
+        } while (count == 300);
+        ASSERT_EQ(TEST_LIST_LENGTH, total);
+        ION_ASSERT_OK(ion_reader_step_out(reader));
+        ION_ASSERT_OK(ion_reader_step_out(expected_reader));
+
+        ION_ASSERT_OK(ion_reader_next(reader, &type));
+        ASSERT_EQ(tid_LIST, type);
+        ION_ASSERT_OK(ion_reader_step_in(reader));
+        ION_ASSERT_OK(ion_reader_next(expected_reader, &type));
+        ION_ASSERT_OK(ion_reader_step_in(expected_reader));
+        total = 0;
+        do {
+            ION_ASSERT_OK(ion_reader_read_double_array(reader, double_chunk, 300, &count));
+            for (SIZE i = 0; i < count; i++) {
+                ASSERT_EQ(0, memcmp(&doubles[total + i], &double_chunk[i], sizeof(double)));
+            }
+            total += count;
+            assertReaderMatches(reader, expected_reader, (BOOL)is_binary, count, tid_FLOAT);
+        } while (count == 300);
+        ASSERT_EQ(TEST_LIST_LENGTH, total);
+        ION_ASSERT_OK(ion_reader_step_out(reader));
+
+        // the list of strings is left where it is
+        ION_ASSERT_OK(ion_reader_next(reader, &type));
+        ASSERT_EQ(tid_LIST, type);
+        ION_ASSERT_OK(ion_reader_next(reader, &type));
+        ASSERT_EQ(tid_EOF, type);
+        ION_ASSERT_OK(ion_reader_close(reader));
+        ION_ASSERT_OK(ion_reader_close(expected_reader));
+        free(data);
+    }
+}
+
+TEST(IonBulkListsRead, ReaderStopsOnValueItCannotRead) {
+    const char *text[] = { "[1, 2, 0x7f, null.int, 5]", "[1.5e0, 2e0, 3]" };
+    hWRITER writer = NULL;
+    hREADER reader = NULL;
+    ION_STREAM *stream = NULL;
+    ION_TYPE type;
+    BYTE *data;
+    SIZE data_len, count;
+    int64_t ints[10];
+    double doubles[10];
+
+    for (int i = 0; i < 2; i++) {
+        // through the binary reader
+        ION_ASSERT_OK(ion_test_new_text_reader(text[i], &reader));
+        ION_ASSERT_OK(ion_test_new_writer(&writer, &stream, TRUE));
+        ION_ASSERT_OK(ion_writer_write_all_values(writer, reader));
+        ION_ASSERT_OK(ion_reader_close(reader));
+        ION_ASSERT_OK(ion_test_writer_get_bytes(writer, stream, &data, &data_len));
+        ION_ASSERT_OK(ion_test_new_reader(data, data_len, &reader));
+
+        ION_ASSERT_OK(ion_reader_next(reader, &type));
+        ION_ASSERT_OK(ion_reader_step_in(reader));
+        if (i == 0) {
+            ASSERT_EQ(IERR_NULL_VALUE, ion_reader_read_int64_array(reader, ints, 10, &count));
+            ASSERT_EQ(3, count);
+            ASSERT_EQ(127, ints[2]);
+            // the reader is on the null
+            ION_ASSERT_OK(ion_reader_get_type(reader, &type));
+            ASSERT_EQ(tid_INT, type);
+            ION_ASSERT_OK(ion_reader_read_int64_array(reader, ints, 10, &count));
+            ASSERT_EQ(1, count);
+            ASSERT_EQ(5, ints[0]);
+        }
+        else {
+            ASSERT_EQ(IERR_INVALID_STATE, ion_reader_read_double_array(reader, doubles, 10, &count));
+            ASSERT_EQ(2, count);
+            ASSERT_EQ(2.0, doubles[1]);
+        }
+        ION_ASSERT_OK(ion_reader_step_out(reader));
+        ION_ASSERT_OK(ion_reader_close(reader));
+        free(data);
+    }
+}